@@ -0,0 +1,305 @@
+/**
+  SUNNY Project, Anyang Normal University, IMP-CAS
+  \file bench.cxx
+  \brief Benchmark suite for basis generation, Hamiltonian establishment and the
+  eigensolvers, over a ladder of single-particle (SP) spaces. Each rung runs in a
+  forked process, so that the singletons start afresh and the peak RSS is that
+  of the rung. The library output is muted, and the results are written to
+  stdout in JSON lines, one object per rung.
+  Usage: bench                      -- the default ladder
+         bench spfile np 2M         -- an SP file, e.g. sp.txt 3 1
+         bench nSP np 2M            -- a generated SP space, e.g. 16 3 1
+  The SP files are looked for in the working directory, e.g. config/.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include "TABit.h"
+#include "TAManyBodySD.h"
+#include "TAManyBodySDList.h"
+#include "TAManyBodySDManager.h"
+#include "TASingleParticleStateManager.h"
+#include "TAHamiltonian.h"
+#include "TAMathFCI.h"
+
+using std::string;
+using std::vector;
+using std::ostream;
+using std::ostringstream;
+
+const int kRungTimeLimit = 900; ///< seconds per rung
+const int kCaseTimeLimit = 120; ///< seconds per forked case, e.g. a solver
+
+/// a rung of the ladder
+struct rung_t{
+  string name; ///< SP file, or generated SP space if nSP > 0
+  int nSP; ///< number of SP states to generate, 0 for an SP file
+  short nParticle, twoM;
+  bool has3N; ///< whether to include the 3-body force in H
+};
+/// a timed benchmark case
+struct case_t{
+  string name;
+  double ops; ///< number of operations in the timing
+  double sec; ///< wall time in seconds, < 0 for timeout or failure
+};
+
+/// swallows the library output
+struct nullbuf_t : public std::streambuf{
+  int overflow(int c){ return c; }
+};
+
+volatile double gSink = 0.; ///< keeps the timed loops from being optimized out
+
+double now(){
+  timespec t; clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1E-9*t.tv_nsec;
+}
+
+/// run f in a forked child with a time limit, so that a solver which doesn't
+/// converge would not stall the whole ladder \retval wall time, -1 on timeout
+template<class F>
+double TimedFork(F f, int limit = kCaseTimeLimit){
+  int fd[2];
+  if(pipe(fd)) return -1.;
+  const pid_t pid = fork();
+  if(0 == pid){
+    close(fd[0]);
+    alarm(limit);
+    const double t0 = now();
+    f();
+    const double dt = now() - t0;
+    if(write(fd[1], &dt, sizeof(dt)) != sizeof(dt)) _exit(1);
+    _exit(0);
+  } // end if
+  close(fd[1]);
+  double dt = -1.;
+  if(read(fd[0], &dt, sizeof(dt)) != sizeof(dt)) dt = -1.;
+  close(fd[0]);
+  waitpid(pid, nullptr, 0);
+  return dt;
+} // end of function TimedFork
+
+/// generate nSP SP states by filling the harmonic-oscillator orbits in order
+/// of 2n+l, with a slight spin-orbit split \retval the SP file name
+string GenerateSPFile(int nSP){
+  static const int orbit[][3] = { // n, l, 2j
+    {0,0,1}, {0,1,3}, {0,1,1}, {0,2,5}, {1,0,1}, {0,2,3}, {0,3,7}, {1,1,3},
+    {0,3,5}, {1,1,1}, {0,4,9}, {1,2,5}, {0,4,7}, {1,2,3}, {2,0,1}
+  };
+  char file[] = "/tmp/sunny_bench_spXXXXXX";
+  const int fd = mkstemp(file);
+  if(fd < 0) return "";
+  close(fd);
+  std::ofstream ff(file);
+  ff << "# index   n     l    2j    2mj    energy\n";
+  int index = 0;
+  for(const int *o : orbit){
+    const double e = 2*o[0] + o[1] - 0.1*(o[2] - o[1]*2);
+    for(int twoMj = -o[2]; twoMj <= o[2]; twoMj += 2){
+      if(index == nSP) return file;
+      ff << index++ << " " << o[0] << " " << o[1] << " " << o[2] << " ";
+      ff << twoMj << " " << e << "\n";
+    } // end for over 2mj
+  } // end for over orbits
+  return file;
+} // end of function GenerateSPFile
+
+/// time loop over reps repetitions \retval a case with ops = reps*opsPerRep
+template<class F>
+case_t TimedLoop(const string &name, int reps, double opsPerRep, F f){
+  const double t0 = now();
+  for(int i = 0; i < reps; i++) f();
+  return case_t{name, reps*opsPerRep, now() - t0};
+} // end of function TimedLoop
+
+/// the benchmarks within a rung, run in a forked process
+void RunRung(const rung_t &r, ostream &out){
+  string file = r.name;
+  if(r.nSP) file = GenerateSPFile(r.nSP);
+  if(file.empty() || !std::ifstream(file.c_str()).good()){
+    out << "{\"rung\":\"" << r.name << "\",\"status\":\"missing\"}" << std::endl;
+    return;
+  } // end if
+
+  vector<case_t> cases;
+  // many-body basis generation //
+  TAManyBodySDManager *manager = TAManyBodySDManager::Instance();
+  manager->SetSPFile(file);
+  manager->SetNParticle(r.nParticle);
+  manager->Set2M(r.twoM);
+  double t0 = now();
+  manager->GenerateManyBodySD();
+  double dt = now() - t0;
+  const int nSP = TASingleParticleStateManager::Instance()->GetNSPState();
+  const int nMBSD = TAMathFCI::Binomial(nSP, r.nParticle);
+  cases.push_back(case_t{"TAManyBodySDManager::GenerateManyBodySD", 1.*nMBSD, dt});
+  t0 = now();
+  manager->MSchemeGo();
+  dt = now() - t0;
+  cases.push_back(case_t{"TAManyBodySDManager::MSchemeGo", 1.*nMBSD, dt});
+  if(r.nSP) unlink(file.c_str());
+
+  // bit operations over the M-scheme basis //
+  TAManyBodySDList *list = manager->GetMBSDListM();
+  const vector<TAManyBodySD *> &sd = list->GetManyBodySDVec();
+  const int n = sd.size();
+  const int np = r.nParticle;
+  // so that each case performs at least ~1E6 operations //
+  const int repSP = 1 + 1000000 / (n*nSP + 1), repNN = 1 + 1000000 / (n*n + 1);
+  cases.push_back(TimedLoop("TABit::SetBit", repSP*nSP, n, [&](){
+    TABit b;
+    for(const TAManyBodySD *p : sd){ b.SetBit(p->IntArr(), np); gSink += b.GetPhase(); }
+  }));
+  cases.push_back(TimedLoop("TABit::Annhilate", repSP, 1.*n*nSP, [&](){
+    for(const TAManyBodySD *p : sd) for(int i = 0; i < nSP; i++){
+      TABit b = p->Bit(); gSink += b.Annhilate(i).GetPhase();
+    }
+  }));
+  cases.push_back(TimedLoop("TABit::Create", repSP, 1.*n*nSP, [&](){
+    for(const TAManyBodySD *p : sd) for(int i = 0; i < nSP; i++){
+      TABit b = p->Bit(); gSink += b.Create(i).GetPhase();
+    }
+  }));
+  cases.push_back(TimedLoop("TABit::operator*", repNN, 1.*n*n, [&](){
+    for(const TAManyBodySD *p : sd) for(const TAManyBodySD *q : sd)
+      gSink += p->Bit() * q->Bit();
+  }));
+  cases.push_back(TimedLoop("TABit::NDiff", repNN, 1.*n*n, [&](){
+    for(const TAManyBodySD *p : sd) for(const TAManyBodySD *q : sd)
+      gSink += p->Bit().NDiff(q->Bit());
+  }));
+  // <rr|a+_p a_q|cc> over a slice of the basis //
+  const int nr = n < 64 ? n : 64;
+  cases.push_back(TimedLoop("TAManyBodySDList::Integral(1N)", 1,
+      1.*nr*nr*nSP*nSP, [&](){
+    for(int rr = 0; rr < nr; rr++) for(int cc = 0; cc < nr; cc++)
+      for(int p = 0; p < nSP; p++) for(int q = 0; q < nSP; q++)
+        gSink += list->Integral(rr, p, q, cc);
+  }));
+  // the same strings in a batch per ket //
+  vector<int> ops, phase(nSP*nSP), target(nSP*nSP);
+  for(int p = 0; p < nSP; p++) for(int q = 0; q < nSP; q++)
+    ops.insert(ops.end(), {q, p});
+  cases.push_back(TimedLoop("TAManyBodySDList::Apply(1N)", repSP,
+      1.*n*nSP*nSP, [&](){
+    for(int cc = 0; cc < n; cc++){
+      list->Apply(cc, 1, ops.data(), nSP*nSP, phase.data(), target.data());
+      gSink += phase[0] + target[0];
+    } // end for over kets
+  }));
+
+  // the Hamiltonian matrix //
+  TAHamiltonian *hamiltonian = TAHamiltonian::Instance();
+  t0 = now();
+  hamiltonian->InitializeCoefficient(r.has3N);
+  cases.push_back(case_t{"TAHamiltonian::InitializeCoefficient", 1., now() - t0});
+  t0 = now();
+  const TAMatrix2D &H = hamiltonian->Matrix();
+  cases.push_back(case_t{"TAHamiltonian::Matrix", 1.*n*n, now() - t0});
+
+  // dense matrix operations, and the eigensolvers in forked processes //
+  cases.push_back(case_t{"TAMatrix::operator*", 1.*n*n*n,
+    TimedFork([&](){ TAMatrix2D HH = H*H; gSink += HH[0][0]; })});
+  cases.push_back(case_t{"TAMatrix::Transpose", 1.*n*n,
+    TimedFork([&](){ TAMatrix2D Ht = H.Transpose(); gSink += Ht[0][0]; })});
+  cases.push_back(case_t{"TAMathFCI::EigenPower", 1., TimedFork([&](){
+    TAMatrix2D v(n); for(int i = 0; i < n; i++) v[i][0] = 1.;
+    TAMathFCI::EigenPower(H, v);
+  })});
+  cases.push_back(case_t{"TAMathFCI::EigenQR", 1., TimedFork([&](){
+    TAMatrix2D v(n); TAMathFCI::EigenQR(H, v);
+  })});
+  cases.push_back(case_t{"TAMathFCI::EigenJacobi", 1., TimedFork([&](){
+    TAMatrix2D P(n, n), v(n); TAMathFCI::EigenJacobi(H, P, v);
+  })});
+  cases.push_back(case_t{"TAMathFCI::EigenHouseholder", 1., TimedFork([&](){
+    TAMatrix2D P(n, n), v(n); TAMathFCI::EigenHouseholder(H, P, v);
+  })});
+
+  // output the rung in a JSON line //
+  rusage usage; getrusage(RUSAGE_SELF, &usage);
+  ostringstream os;
+  os.precision(6);
+  os << "{\"rung\":\"" << r.name << "\",\"status\":\"ok\",\"nSP\":" << nSP;
+  os << ",\"nParticle\":" << np << ",\"2M\":" << r.twoM;
+  os << ",\"3N\":" << (r.has3N ? "true" : "false");
+#ifdef __OPTIMIZE__
+  os << ",\"optimized\":true";
+#else
+  os << ",\"optimized\":false";
+#endif
+  os << ",\"nMBSD\":" << nMBSD << ",\"nBasis\":" << n;
+  os << ",\"peakRSS_kB\":" << usage.ru_maxrss << ",\"cases\":[";
+  for(size_t i = 0; i < cases.size(); i++){
+    const case_t &c = cases[i];
+    if(i) os << ",";
+    os << "{\"case\":\"" << c.name << "\"";
+    if(c.sec < 0.){ os << ",\"status\":\"timeout\"}"; continue; }
+    os << ",\"status\":\"ok\",\"ops\":" << c.ops << ",\"seconds\":" << c.sec;
+    os << ",\"ns_per_op\":" << 1E9*c.sec/c.ops;
+    os << ",\"ops_per_s\":" << (c.sec > 0. ? c.ops/c.sec : 0.) << "}";
+  } // end for over cases
+  os << "]}";
+  out << os.str() << std::endl;
+} // end of function RunRung
+
+int main(int argc, char *argv[]){
+  vector<rung_t> ladder;
+  if(4 == argc){
+    const int nSP = atoi(argv[1]); // 0 if argv[1] is a file name
+    ladder.push_back(rung_t{argv[1], nSP, short(atoi(argv[2])),
+      short(atoi(argv[3])), nSP <= 8});
+  } // end if
+  else if(1 == argc){
+    ladder.push_back(rung_t{"sp0.txt", 0, 2, 0, true});
+    ladder.push_back(rung_t{"sp1.txt", 0, 3, 1, true});
+    ladder.push_back(rung_t{"sp.txt", 0, 3, 1, true});
+    ladder.push_back(rung_t{"12", 12, 3, 1, false});
+    ladder.push_back(rung_t{"14", 14, 3, 1, false});
+    ladder.push_back(rung_t{"16", 16, 4, 0, false});
+  } // end else if
+  else{
+    std::cerr << "Usage: " << argv[0] << " [spfile|nSP nParticle 2M]\n";
+    return 1;
+  } // end else
+
+  // results go to the original stdout, while the library talks to nothing //
+  ostream out(std::cout.rdbuf());
+  nullbuf_t nullbuf;
+  std::cout.rdbuf(&nullbuf);
+  // the solvers and the error handler may wait for the keyboard //
+  if(!freopen("/dev/null", "r", stdin)) return 1;
+
+  for(const rung_t &r : ladder){
+    const pid_t pid = fork();
+    if(0 == pid){
+      alarm(kRungTimeLimit);
+      RunRung(r, out);
+      exit(0);
+    } // end if
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if(WIFSIGNALED(status)){
+      out << "{\"rung\":\"" << r.name << "\",\"status\":\"";
+      out << (SIGALRM == WTERMSIG(status) ? "timeout" : "crashed") << "\"}";
+      out << std::endl;
+    } // end if
+  } // end for over the ladder
+
+  std::cout.rdbuf(out.rdbuf()); // nullbuf dies with main
+  return 0;
+} // end of the main function
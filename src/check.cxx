@@ -0,0 +1,739 @@
+/**
+	SUNNY Project, Anyang Normal University, IMP-CAS
+	\file check.cxx
+	\brief Behavior tests of the eigensolvers and the storages of H, on the SP
+	states and interaction found in config/, where ctest runs them, one test
+	per run: ./check test [scratch], the tests being
+	  checkpoint: a Lanczos or LOBPCG run cut short and resumed from its
+	    checkpoint (TACheckpoint) in file scratch ends as the run left alone
+	  sell: the products of TASellMatrix equal those of TASparseMatrix
+	  order: the energies are the same in any order of the basis, and the SDs
+	    and eigenvectors, back in the order as generated, the same as those of
+	    the lexicographic order (TAManyBodySDList::Reorder, ToOriginalOrder)
+	  coefficient: H stored, in sparse rows and times v, follows the
+	    coefficients as they are changed
+	  sci: the selected CI (TASelectedCI) of no threshold is the full CI, and
+	    of a threshold, variational and improved by its PT2 correction
+	  jump: H*v and H gathered from the 1+2-body jumps (TAJumpTable), of new
+	    coefficients too, and of the table read back from file scratch, are
+	    those of TAHamiltonian::Element
+	  component: H_1N + lambda*H_2N (TAComponentMatrix) times v is that of the
+	    parts of H, and at lambda = 1 it has the eigenpairs of H
+	  density: the one-body (transition) densities (TADensity) of SDs and of
+	    eigenstates are consistent with each other, N and H_1N
+	  transition: the one-body operators (TAOneBodyOperator) between the
+	    eigenstates agree with their densities, and J_mu with M and <J^2>
+	  strength: the Gauss quadrature and the continued fraction of
+	    TALanczos::Strength() hold the strength of v over the eigenstates
+	  kpm: the Chebyshev moments of TAKernelPolynomial are those of the plain
+	    recurrence, and rho(E) integrates to the dimension
+	  shift-invert: TAShiftInvert finds the eigenpairs nearest to a target in
+	    the middle of the spectrum, and MINRES solves the linear systems
+	  propagator: exp(-iHt) of TAPropagator turns eigenstates by their
+	    phases, conserves the norm and <H>, and is a group in t
+	  tsqr: the Q of TAMathFCI::TSQR is orthonormal, Q*R is the block, and R
+	    is that of TAMathFCI::QR
+	The exit status is the number of the checks failed.
+	\date Created: 2026/10/19
+	\date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+#include "TAHamiltonian.h"
+#include "TAManyBodySD.h"
+#include "TAManyBodySDList.h"
+#include "TALanczos.h"
+#include "TABlockEigen.h"
+#include "TACheckpoint.h"
+#include "TAJumpTable.h"
+#include "TAComponentMatrix.h"
+#include "TADensity.h"
+#include "TAOneBodyOperator.h"
+#include "TAKernelPolynomial.h"
+#include "TAShiftInvert.h"
+#include "TAPropagator.h"
+#include "TAManyBodySDManager.h"
+#include "TABit.h"
+#include "TASelectedCI.h"
+#include "TASparseMatrix.h"
+#include "TASellMatrix.h"
+#include "TAMPI.h"
+#include "TAMatrix.h"
+#include "TAMathFCI.h"
+#include "TASingleParticleState.h"
+#include "TASingleParticleStateManager.h"
+
+static int nFail = 0; // the checks failed
+
+static void Check(bool ok, const char *what, double err){
+	printf("%s: %s, error: %g\n", ok ? "passed" : "FAILED", what, err);
+	if(!ok) nFail++;
+} // end of function Check
+
+static double Dot(const vector<double> &a, const vector<double> &b){
+	double s = 0.;
+	for(size_t i = 0; i < a.size(); i++) s += a[i] * b[i];
+	return s;
+} // end of function Dot
+
+/// the eigenpairs of the Lanczos run, left alone, cut short after maxIt
+/// iterations, or resumed from the checkpoint in file
+static void Lanczos(int nev, const string &file, int maxIt,
+		vector<double> &e, vector<vector<double> > &x){
+	TALanczos *lanczos = TALanczos::Instance();
+	lanczos->SetNEigen(nev);
+	lanczos->SetCheckpoint(file, 4);
+	lanczos->SetMaxIteration(maxIt);
+	lanczos->Go();
+	e.clear(); x.clear();
+	for(int j = 0; j < nev; j++){
+		e.push_back(lanczos->GetEnergy(j));
+		x.push_back(lanczos->GetVector(j));
+	} // end for over j
+} // end of function Lanczos
+
+/// the same for LOBPCG
+static void LOBPCG(int nev, const string &file, int maxIt,
+		vector<double> &e, vector<vector<double> > &x){
+	TABlockEigen be(nullptr, TABlockEigen::kLOBPCG);
+	be.SetNEigen(nev);
+	be.SetBlockSize(nev);
+	be.SetCheckpoint(file, 2);
+	be.SetMaxIteration(maxIt);
+	be.Go();
+	e.clear(); x.clear();
+	for(int j = 0; j < nev; j++){
+		e.push_back(be.GetEnergy(j));
+		x.push_back(be.GetVector(j));
+	} // end for over j
+} // end of function LOBPCG
+
+/// \retval the largest difference of the energies, and of the eigenvectors
+/// up to their signs
+static void Compare(const vector<double> &e0, const vector<vector<double> > &x0,
+		const vector<double> &e, const vector<vector<double> > &x, double &de,
+		double &dx){
+	de = dx = 0.;
+	for(size_t j = 0; j < e0.size(); j++){
+		de = std::max(de, fabs(e[j] - e0[j]));
+		dx = std::max(dx, 1. - fabs(Dot(x[j], x0[j])));
+	} // end for over j
+} // end of function Compare
+
+static void Checkpoint(TAHamiltonian *h, const string &file){
+	const int n = h->GetNBasis(), nev = 3;
+	vector<double> e0, e;
+	vector<vector<double> > x0, x;
+	double de, dx;
+	typedef void (*solver_t)(int, const string &, int, vector<double> &,
+		vector<vector<double> > &);
+	const solver_t solver[2] = {Lanczos, LOBPCG};
+	const char *name[2] = {"Lanczos", "LOBPCG"};
+	for(int s = 0; s < 2; s++){
+		remove(file.c_str());
+		solver[s](nev, "", 300, e0, x0);
+		solver[s](nev, file, 8, e, x); // as if killed after 8 iterations
+		{
+			TACheckpoint ckp(file);
+			const long nRecord = ckp.Open(n, 0, n, s ? 1 : 2,
+				TACheckpoint::Fingerprint(h));
+			Check(nRecord > 0, (string(name[s]) + ": records left by the run \
+cut short").c_str(), 0.);
+		}
+		solver[s](nev, file, 300, e, x);
+		Compare(e0, x0, e, x, de, dx);
+		Check(de < 1E-8 && dx < 1E-6, (string(name[s]) + ": resumed = left \
+alone").c_str(), std::max(de, dx));
+	} // end for over solvers
+	remove(file.c_str());
+} // end of function Checkpoint
+
+/// \retval max |A*v - B*v| over some row ranges and numbers of vectors
+template<class T>
+static double Diff(TASparseMatrix<T> &a, TASellMatrix<T> &b, int n){
+	vector<double> v, wa, wb;
+	const int range[3][2] = {{0, n}, {1, n - 1}, {n/3, n/2}};
+	double d = 0.;
+	for(int k : {1, 2, 3, 8, 9}){
+		v.resize(long(n)*k);
+		for(long i = 0; i < long(v.size()); i++) v[i] = sin(1.3*i + 0.2);
+		for(const int *r : range){
+			if(k == 1){
+				a.Multiply(v, wa, r[0], r[1]);
+				b.Multiply(v, wb, r[0], r[1]);
+			} // end if
+			else{
+				a.MultiplyBlock(v, k, wa, r[0], r[1]);
+				b.MultiplyBlock(v, k, wb, r[0], r[1]);
+			} // end else
+			if(wa.size() != wb.size()) return 1E100;
+			for(size_t i = 0; i < wa.size(); i++)
+				d = std::max(d, fabs(wa[i] - wb[i]) / std::max(1., fabs(wa[i])));
+		} // end for over ranges
+	} // end for over k
+	return d;
+} // end of function Diff
+
+static void Sell(TAHamiltonian *h){
+	const int n = h->GetNBasis();
+	TASparseMatrix<double> m;
+	TASparseMatrix<float> mf;
+	m.Build(h); mf.Build(h);
+	double d = 0.;
+	for(int chunk : {0, 4, 16}) for(int sigma : {0, 4}){
+		TASellMatrix<double> s(chunk, sigma);
+		TASellMatrix<float> sf(chunk, sigma);
+		s.Build(h); sf.Build(h);
+		d = std::max(d, std::max(Diff(m, s, n), Diff(mf, sf, n)));
+		TASellMatrix<double> sm(chunk, sigma); // from the CSR form
+		sm.Build(m);
+		d = std::max(d, Diff(m, sm, n));
+	} // end for over chunk and sigma
+	Check(d < 1E-12, "SELL products = CSR products", d);
+} // end of function Sell
+
+static void Order(TAHamiltonian *h){
+	TAManyBodySDList *list = h->GetMBSDListM();
+	const int n = list->GetNBasis(), nev = 3;
+	list->Reorder(TAManyBodySDList::kLexicographic);
+	h->SetMBSDListM(list);
+	vector<size_t> hash(n);
+	for(int i = 0; i < n; i++) hash[i] = (*list)[i]->Bit().Hash();
+	vector<double> e0, e, y;
+	vector<vector<double> > x0, x;
+	Lanczos(nev, "", 300, e0, x0);
+	const TAManyBodySDList::EOrder order[3] = {TAManyBodySDList::kRCM,
+		TAManyBodySDList::kConfiguration, TAManyBodySDList::kLexicographic};
+	const char *name[3] = {"rcm", "conf", "lex"};
+	for(int o = 0; o < 3; o++){
+		list->Reorder(order[o]);
+		h->SetMBSDListM(list); // H of the former order is out of date
+		// the SD i is the GetOriginalIndex(i)-th one as generated //
+		vector<char> seen(n, 0);
+		int bad = 0;
+		for(int i = 0; i < n; i++){
+			const int k = list->GetOriginalIndex(i);
+			if(k < 0 || k >= n || seen[k] || (*list)[i]->Bit().Hash() != hash[k])
+				bad++;
+			else seen[k] = 1;
+		} // end for over i
+		Check(!bad, (string(name[o]) + ": GetOriginalIndex, a permutation to the \
+SDs as generated").c_str(), bad);
+		Lanczos(nev, "", 300, e, x);
+		for(vector<double> &xj : x){ list->ToOriginalOrder(xj, y); xj.swap(y); }
+		double de, dx;
+		Compare(e0, x0, e, x, de, dx);
+		Check(de < 1E-8 && dx < 1E-6, (string(name[o]) + ": energies and \
+eigenvectors back in the order as generated").c_str(), std::max(de, dx));
+	} // end for over orders
+} // end of function Order
+
+/// \retval max |<rr|H|cc> - the stored or sparse row forms| over all rr, cc
+static double Stale(TAHamiltonian *h){
+	const int n = h->GetNBasis();
+	vector<int> cols;
+	vector<double> vals, v(n), w;
+	for(int i = 0; i < n; i++) v[i] = sin(1.3*i + 0.2);
+	h->Multiply(v, w, 0, n);
+	const TAMatrix2D &m = h->Matrix();
+	double d = 0.;
+	for(int rr = 0; rr < n; rr++){
+		vector<double> row(n, 0.);
+		h->SparseRow(rr, cols, vals);
+		for(size_t j = 0; j < cols.size(); j++) row[cols[j]] = vals[j];
+		double hv = 0.;
+		for(int cc = 0; cc < n; cc++){
+			const double e = h->Element(rr, cc);
+			d = std::max(d, std::max(fabs(row[cc] - e), fabs(m[rr][cc] - e)));
+			hv += e*v[cc];
+		} // end for over cc
+		d = std::max(d, fabs(w[rr] - hv));
+	} // end for over rr
+	return d;
+} // end of function Stale
+
+static void Coefficient(TAHamiltonian *h){
+	h->Matrix(); // to be out of date with the coefficients next
+	const int nSP = TASingleParticleStateManager::Instance()->GetNSPState();
+	TAMatrix2D coe1N(nSP, nSP);
+	coe1N = 0.;
+	for(int i = 0; i < nSP; i++) coe1N[i][i] = 1. + 0.5*i;
+	h->SetCoe1N(coe1N);
+	const double d = Stale(h);
+	Check(d < 1E-12, "SetCoe1N: Matrix, SparseRow and Multiply = Element", d);
+	h->InitializeCoefficient(false);
+	const double d1 = Stale(h);
+	Check(d1 < 1E-12, "InitializeCoefficient: the same", d1);
+} // end of function Coefficient
+
+/// \retval max |H*v| - the product by Element() over k vectors interleaved
+static double Product(TAHamiltonian *h, int k){
+	const int n = h->GetNBasis();
+	vector<double> v(long(n)*k), w;
+	for(long i = 0; i < long(v.size()); i++) v[i] = sin(0.7*i + 0.1);
+	if(k == 1) h->Multiply(v, w, 0, n);
+	else h->MultiplyBlock(v, k, w, 0, n);
+	double d = 0.;
+	for(int rr = 0; rr < n; rr++) for(int j = 0; j < k; j++){
+		double s = 0.;
+		for(int cc = 0; cc < n; cc++) s += h->Element(rr, cc) * v[long(cc)*k+j];
+		d = std::max(d, fabs(w[long(rr)*k+j] - s));
+	} // end for over rows and vectors
+	return d;
+} // end of function Product
+
+static void Jump(TAHamiltonian *h, const string &file){
+	const int n = h->GetNBasis();
+	TAJumpTable table;
+	table.Build(h->GetMBSDListM());
+	Check(table.GetNJump(0) > 0 && table.GetNJump(1) > 0, "1 and 2-body jumps \
+built", 0.);
+	h->SetJumpTable(&table);
+	double d = std::max(Product(h, 1), Product(h, 3));
+	Check(d < 1E-12, "H*v gathered from the jumps = by Element", d);
+	TAMatrix2D m;
+	table.Matrix(m);
+	d = 0.;
+	for(int rr = 0; rr < n; rr++) for(int cc = 0; cc < n; cc++)
+		d = std::max(d, fabs(m[rr][cc] - h->Element(rr, cc)));
+	Check(d < 1E-12, "the dense H of the jumps = by Element", d);
+	// the coefficients reach the table as they are changed //
+	const int nSP = TASingleParticleStateManager::Instance()->GetNSPState();
+	TAMatrix2D coe1N(nSP, nSP);
+	coe1N = 0.;
+	for(int i = 0; i < nSP; i++) coe1N[i][i] = 2. - 0.3*i;
+	h->SetCoe1N(coe1N);
+	d = Product(h, 1);
+	Check(d < 1E-12, "SetCoe1N: the same", d);
+	// the table written and read back //
+	table.Write(file);
+	TAJumpTable back;
+	const bool ok = back.Read(file, h->GetMBSDListM());
+	h->SetJumpTable(&back);
+	d = ok ? std::max(Product(h, 1), Product(h, 2)) : 1E100;
+	Check(ok && back.GetNJump(0) == table.GetNJump(0) &&
+		back.GetNJump(1) == table.GetNJump(1) && d < 1E-12, "the table read \
+back from file", d);
+	h->SetJumpTable(nullptr);
+	h->InitializeCoefficient(false);
+	remove(file.c_str());
+} // end of function Jump
+
+static void Component(TAHamiltonian *h){
+	const int n = h->GetNBasis(), k = 3;
+	TAComponentMatrix hc;
+	hc.Build(h);
+	vector<double> v(long(n)*k), w, wb, h1(n, 0.), hh(n, 0.);
+	for(long i = 0; i < long(v.size()); i++) v[i] = sin(0.7*i + 0.1);
+	// H_1N*v and H*v of the first vector, by the parts of the rows //
+	vector<int> cols;
+	vector<double> vals[3];
+	for(int rr = 0; rr < n; rr++){
+		h->ComponentRow(rr, cols, vals);
+		for(size_t j = 0; j < cols.size(); j++){
+			h1[rr] += vals[0][j] * v[long(cols[j])*k];
+			hh[rr] += (vals[0][j] + vals[1][j] + vals[2][j]) * v[long(cols[j])*k];
+		} // end for over j
+	} // end for over rows
+	double d = 0.;
+	for(double lambda : {0., 0.4, 1.}){
+		hc.SetScale(lambda);
+		vector<double> v0(n);
+		for(int i = 0; i < n; i++) v0[i] = v[long(i)*k];
+		hc.Multiply(v0, w, 0, n);
+		hc.MultiplyBlock(v, k, wb, 0, n);
+		for(int i = 0; i < n; i++){
+			d = std::max(d, fabs(w[i] - (h1[i] + lambda*(hh[i] - h1[i]))));
+			d = std::max(d, fabs(wb[long(i)*k] - w[i]));
+		} // end for over i
+	} // end for over lambda
+	Check(d < 1E-12, "H_1N + lambda*H_2N times v, for one and three vectors, \
+= by the parts of the rows", d);
+	// at lambda = 1 it is H itself //
+	vector<double> e0, e;
+	vector<vector<double> > x0, x;
+	Lanczos(3, "", 300, e0, x0);
+	TALanczos *lanczos = TALanczos::Instance();
+	lanczos->SetOperator(&hc);
+	Lanczos(3, "", 300, e, x);
+	lanczos->SetOperator(nullptr);
+	double de, dx;
+	Compare(e0, x0, e, x, de, dx);
+	Check(de < 1E-8 && dx < 1E-6, "lambda = 1: the eigenpairs of H",
+		std::max(de, dx));
+} // end of function Component
+
+static void Density(TAHamiltonian *h){
+	const TAManyBodySDList *list = h->GetMBSDListM();
+	const int n = h->GetNBasis();
+	const int nSP = TASingleParticleStateManager::Instance()->GetNSPState();
+	const vector<TASingleParticleState *> &sp =
+		TASingleParticleStateManager::Instance()->GetSPStateVec();
+	// the occupations of an SD are its bits //
+	int bad = 0;
+	vector<double> occ;
+	for(int i : {0, n/2, n - 1}){
+		vector<double> x(n, 0.);
+		x[i] = 1.;
+		TADensity::Occupation(x, occ);
+		for(int p = 0; p < nSP; p++){
+			TABit bit((*list)[i]->Bit());
+			if(occ[p] != (bit.Annhilate(p).GetPhase() ? 1. : 0.)) bad++;
+		} // end for over p
+	} // end for over SDs
+	Check(!bad, "the occupations of an SD", bad);
+	// of the eigenstates: rho_ab = rho_ba^T, n_p = rho_pp, sum_p n_p = the
+	// number of particles, and <b|H_1N|a> = sum_p e_p*rho_pp, as H_1N is the
+	// SP energies e_p, from the parts of the rows of H //
+	vector<double> e;
+	vector<vector<double> > x;
+	Lanczos(2, "", 300, e, x);
+	TAMatrix2D rho[2][2];
+	for(int a = 0; a < 2; a++) for(int b = 0; b < 2; b++)
+		TADensity::OneBody(x[a], x[b], rho[a][b]);
+	int nPart = 0;
+	for(int p = 0; p < nSP; p++){
+		TABit bit((*list)[0]->Bit());
+		if(bit.Annhilate(p).GetPhase()) nPart++;
+	} // end for over p
+	TADensity::Occupation(x[0], occ);
+	double d = 0., tr = 0.;
+	for(int p = 0; p < nSP; p++){
+		tr += rho[0][0][p][p];
+		d = std::max(d, fabs(occ[p] - rho[0][0][p][p]));
+		for(int q = 0; q < nSP; q++)
+			d = std::max(d, fabs(rho[0][1][p][q] - rho[1][0][q][p]));
+	} // end for over p
+	d = std::max(d, fabs(tr - nPart));
+	Check(d < 1E-12, "rho_ab = rho_ba^T, n_p = rho_pp, tr rho = N", d);
+	vector<int> cols;
+	vector<double> vals[3];
+	double dh = 0.;
+	for(int a = 0; a < 2; a++) for(int b = 0; b < 2; b++){
+		double h1 = 0., s = 0.; // <b|H_1N|a>
+		for(int rr = 0; rr < n; rr++){
+			h->ComponentRow(rr, cols, vals);
+			for(size_t j = 0; j < cols.size(); j++)
+				h1 += x[b][rr] * vals[0][j] * x[a][cols[j]];
+		} // end for over rows
+		for(int p = 0; p < nSP; p++) s += sp[p]->GetEnergy() * rho[b][a][p][p];
+		dh = std::max(dh, fabs(h1 - s));
+	} // end for over a and b
+	Check(dh < 1E-12, "<b|H_1N|a> = sum_p e_p*rho_pp", dh);
+} // end of function Density
+
+static void Transition(TAHamiltonian *h){
+	const TAManyBodySDList *list = h->GetMBSDListM();
+	const int nSP = TASingleParticleStateManager::Instance()->GetNSPState();
+	vector<double> e;
+	vector<vector<double> > x;
+	Lanczos(2, "", 300, e, x);
+	// <b|O|a> = sum_pq <p|O|q>*<b|a+_p*a_q|a> //
+	const TAOneBodyOperator m1(1, 0, TAOneBodyOperator::M1());
+	double d = 0., o = 0.;
+	for(int a = 0; a < 2; a++) for(int b = 0; b < 2; b++){
+		TAMatrix2D rho;
+		TADensity::OneBody(x[b], x[a], rho);
+		double s = 0.;
+		for(int p = 0; p < nSP; p++) for(int q = 0; q < nSP; q++)
+			s += m1(p, q) * rho[p][q];
+		const double ba = m1.Element(list, x[b], list, x[a]);
+		d = std::max(d, fabs(ba - s));
+		o = std::max(o, fabs(ba));
+	} // end for over a and b
+	Check(o > 1E-6 && d < 1E-12, "M1: <b|O|a> = sum_pq <p|O|q>*rho_pq", d);
+	// J_0 = J_z, diagonal in M //
+	const TAOneBodyOperator j0(1, 0, TAOneBodyOperator::J());
+	const double m = list->Get2M() / 2.;
+	d = 0.;
+	for(int a = 0; a < 2; a++)
+		d = std::max(d, fabs(j0.Element(list, x[a], list, x[a]) - m));
+	Check(d < 1E-10, "J_z: <a|J_z|a> = M", d);
+	// J_+1 takes a to the M+1 block, with <J^2> = 2|J_+1 a|^2 + M^2 + M, and
+	// back by J_-1 = -J_+1^T
+	const TAOneBodyOperator jp(1, 1, TAOneBodyOperator::J());
+	const TAOneBodyOperator jm(1, -1, TAOneBodyOperator::J());
+	const TAManyBodySDList *up =
+		TAManyBodySDManager::Instance()->GetMBSDList(list->Get2M() + 2);
+	vector<double> y;
+	jp.Multiply(list, x[0], up, y);
+	const double j = TAOneBodyOperator::AngularMomentum(list, x[0]);
+	const double y2 = Dot(y, y);
+	d = fabs(2.*y2 + m*m + m - j*(j + 1.));
+	d = std::max(d, fabs(jp.Element(up, y, list, x[0]) - y2));
+	d = std::max(d, fabs(jm.Element(list, x[0], up, y) + y2));
+	Check(int(y.size()) == up->GetNBasis() && y2 > 1E-6 && d < 1E-10,
+		"J_+-1: <J^2> = 2|J_+1 a|^2 + M^2 + M, <a|J_-1|J_+1 a> = -|J_+1 a|^2", d);
+} // end of function Transition
+
+static void Strength(TAHamiltonian *h){
+	const TAManyBodySDList *list = h->GetMBSDListM();
+	const int n = list->GetNBasis();
+	vector<double> e0, e, s;
+	vector<vector<double> > x;
+	Lanczos(2, "", 300, e0, x);
+	TALanczos *lanczos = TALanczos::Instance();
+	// v = x0 + 2*x1: all the strength at E0 and E1, found in two steps //
+	vector<double> v(x[0]);
+	for(int i = 0; i < n; i++) v[i] += 2.*x[1][i];
+	lanczos->Strength(v, 2);
+	lanczos->GetStrength(e, s);
+	double d = fabs(lanczos->GetTotalStrength() - 5.);
+	if(e.size() == 2) d = std::max(d, std::max(std::max(fabs(e[0] - e0[0]),
+		fabs(e[1] - e0[1])), std::max(fabs(s[0] - 1.), fabs(s[1] - 4.))));
+	Check(e.size() == 2 && d < 1E-6, "x0 + 2*x1: strengths 1 and 4 at E0 and \
+E1", d);
+	// v = M1*x0: the quadrature has the moments <v|H^k|v>, k = 0, 1, 2 //
+	const TAOneBodyOperator m1(1, 0, TAOneBodyOperator::M1());
+	m1.Multiply(list, x[0], list, v);
+	vector<double> w;
+	h->Multiply(v, w, 0, n);
+	const double mu[3] = {Dot(v, v), Dot(v, w), Dot(w, w)};
+	lanczos->Strength(v, 10);
+	lanczos->GetStrength(e, s);
+	d = fabs(lanczos->GetTotalStrength() - mu[0]);
+	for(int k = 0; k < 3; k++){
+		double m = 0.;
+		for(int i = 0; i < int(e.size()); i++) m += s[i] * pow(e[i], k);
+		d = std::max(d, fabs(m - mu[k]) / mu[k]);
+	} // end for over k
+	Check(mu[0] > 1E-6 && d < 1E-10, "M1*x0: sum of s*E^k = <v|H^k|v>, k = 0, \
+1, 2", d);
+	// the continued fraction is the sum of the Lorentzians at the nodes //
+	const double eta = 0.1;
+	d = 0.;
+	for(double ee = e.front() - 1.; ee < e.back() + 1.; ee += 0.25){
+		double f = 0.;
+		for(int i = 0; i < int(e.size()); i++)
+			f += s[i] * eta / ((ee - e[i])*(ee - e[i]) + eta*eta);
+		d = std::max(d, fabs(lanczos->StrengthFunction(ee, eta) - f / M_PI));
+	} // end for over ee
+	Check(d < 1E-10 * mu[0] / eta, "S(E) = sum of s*eta/pi/((E-e)^2+eta^2)", d);
+} // end of function Strength
+
+/// for the random vectors of TAKernelPolynomial
+struct TAKernelProbe : public TAKernelPolynomial{
+	void Random(int i, int n, vector<double> &r) const{
+		RandomVector(i, 0, n, r);
+	}
+};
+
+static void KernelPolynomial(TAHamiltonian *h){
+	const int n = h->GetNBasis(), nm = 9, nv = 3;
+	vector<double> e;
+	vector<vector<double> > x;
+	Lanczos(1, "", 300, e, x);
+	TAKernelProbe kpm;
+	kpm.SetNMoment(nm);
+	kpm.SetNVector(nv);
+	kpm.Go();
+	const double c = (kpm.GetEMax() + kpm.GetEMin()) / 2.;
+	const double w = (kpm.GetEMax() - kpm.GetEMin()) / 2.;
+	Check(kpm.GetEMin() < e[0] && w > 0., "the bounds estimated hold E0", 0.);
+	// mu_k = <r|T_k(H')|r>, H' = (H-c)/w, by the plain recurrence //
+	vector<double> mu(nm, 0.), t0, t1, t2;
+	for(int i = 0; i < nv; i++){
+		kpm.Random(i, n, t0);
+		h->Multiply(t0, t1, 0, n);
+		for(int j = 0; j < n; j++) t1[j] = (t1[j] - c*t0[j]) / w;
+		const vector<double> r(t0);
+		mu[0] += Dot(r, t0) / nv; mu[1] += Dot(r, t1) / nv;
+		for(int k = 2; k < nm; k++){
+			h->Multiply(t1, t2, 0, n);
+			for(int j = 0; j < n; j++) t2[j] = 2.*(t2[j] - c*t1[j])/w - t0[j];
+			mu[k] += Dot(r, t2) / nv;
+			t0.swap(t1); t1.swap(t2);
+		} // end for over k
+	} // end for over i
+	double d = fabs(kpm.GetMoment()[0] - n);
+	for(int k = 0; k < nm; k++)
+		d = std::max(d, fabs(kpm.GetMoment()[k] - mu[k]) / n);
+	Check(d < 1E-12, "mu_0 = dim, mu_k = <r|T_k|r> by two moments per H*v", d);
+	kpm.SetVectorParallel();
+	kpm.Go();
+	d = 0.;
+	for(int k = 0; k < nm; k++)
+		d = std::max(d, fabs(kpm.GetMoment()[k] - mu[k]) / n);
+	Check(d < 1E-12, "SetVectorParallel: the same moments", d);
+	// int rho(E) dE = mu_0, exact by the midpoint rule in E = c + w*cos(t) //
+	const int np = 4*nm;
+	double sum = 0., err;
+	for(int j = 0; j < np; j++){
+		const double t = M_PI * (j + 0.5) / np;
+		sum += kpm.Density(c + w*cos(t), err) * w*sin(t) * M_PI / np;
+	} // end for over j
+	d = fabs(sum - n);
+	Check(d < 1E-10 * n, "the integral of rho(E) = dim", d);
+	TALanczos::Instance()->SetOperator(nullptr);
+} // end of function KernelPolynomial
+
+static void ShiftInvert(TAHamiltonian *h){
+	const int n = h->GetNBasis();
+	vector<double> e;
+	vector<vector<double> > x;
+	Lanczos(4, "", 300, e, x);
+	// nearer to E2 than to E1, the two nearest found, nearest first //
+	const double sigma = 0.4*e[1] + 0.6*e[2];
+	TAShiftInvert si;
+	si.SetTarget(sigma);
+	si.SetNEigen(2);
+	si.Go();
+	double d = 0.;
+	for(int j = 0; j < si.GetNEigen(); j++){
+		const int k = 2 - j;
+		d = std::max(d, fabs(si.GetEnergy(j) - e[k]));
+		d = std::max(d, 1. - fabs(Dot(si.GetVector(j), x[k])));
+	} // end for over j
+	Check(si.GetNEigen() == 2 && d < 1E-8, "the two states nearest to the \
+target = E2 and E1 by Lanczos", d);
+	// MINRES solves the indefinite (H-sigma)*y = b //
+	vector<double> b(n), y, w;
+	for(int i = 0; i < n; i++) b[i] = 1. / (1. + i);
+	const int it = si.MINRES(sigma, b, y);
+	h->Multiply(y, w, 0, n);
+	d = 0.;
+	for(int i = 0; i < n; i++) d += pow(b[i] - w[i] + sigma*y[i], 2);
+	d = sqrt(d / Dot(b, b));
+	Check(it > 0 && d < 1E-8, "MINRES: |b-(H-sigma)*y| / |b|", d);
+} // end of function ShiftInvert
+
+static void Propagator(TAHamiltonian *h){
+	typedef TAPropagator::cplx cplx;
+	const int n = h->GetNBasis();
+	vector<double> e;
+	vector<vector<double> > x;
+	Lanczos(2, "", 300, e, x);
+	TAPropagator prop;
+	// (x0 + x1)/sqrt(2) -> (exp(-iE0*t)*x0 + exp(-iE1*t)*x1)/sqrt(2) //
+	const double t = 3.;
+	vector<cplx> psi(n), phi(n);
+	for(int i = 0; i < n; i++){
+		psi[i] = (x[0][i] + x[1][i]) / sqrt(2.);
+		phi[i] = (exp(cplx(0., -e[0]*t))*x[0][i] +
+			exp(cplx(0., -e[1]*t))*x[1][i]) / sqrt(2.);
+	} // end for over i
+	const int steps = prop.Propagate(psi, t);
+	double d = 0.;
+	for(int i = 0; i < n; i++) d = std::max(d, abs(psi[i] - phi[i]));
+	Check(steps > 0 && d < 1E-7, "eigenstates only gain their phases \
+exp(-iE*t)", d);
+	d = std::max(fabs(abs(TAPropagator::Dot(psi, psi)) - 1.),
+		fabs(prop.Energy(psi) - (e[0] + e[1]) / 2.));
+	Check(d < 1E-8, "the norm and <H> conserved", d);
+	// exp(iHt)*exp(-iHt) = 1, and exp(-iHt2)*exp(-iHt1) = exp(-iH(t1+t2)) //
+	vector<cplx> psi0(n);
+	for(int i = 0; i < n; i++) psi0[i] = cplx(1. / (1. + i), 0.5 - (i % 3));
+	psi = psi0;
+	prop.Propagate(psi, 1.3);
+	phi = psi;
+	prop.Propagate(psi, 2.);
+	prop.Propagate(phi, -1.3);
+	d = 0.;
+	for(int i = 0; i < n; i++) d = std::max(d, abs(phi[i] - psi0[i]));
+	phi = psi0;
+	prop.Propagate(phi, 3.3);
+	for(int i = 0; i < n; i++) d = std::max(d, abs(phi[i] - psi[i]));
+	Check(d < 1E-8, "back in time to psi(0), and the steps compose", d);
+} // end of function Propagator
+
+static void TSQR(){
+	const int m = 100;
+	for(int k : {7, 40}){ // one panel, and more than the 32 columns of one
+		vector<double> a(m*k), q;
+		TAMatrix2D A(m, k), Q, R, R0;
+		for(int j = 0; j < k; j++) for(int i = 0; i < m; i++)
+			A[i][j] = a[i + j*m] = sin(1. + i*(j + 1.)) + (i == j ? 0.1 : 0.);
+		q = a;
+		TAMathFCI::TSQR(q.data(), m, k, R);
+		TAMathFCI::QR(A, Q, R0);
+		double dq = 0., da = 0., dr = 0.;
+		for(int i = 0; i < k; i++) for(int j = 0; j < k; j++){
+			double s = 0.;
+			for(int l = 0; l < m; l++) s += q[l + i*m] * q[l + j*m];
+			dq = std::max(dq, fabs(s - (i == j)));
+			dr = std::max(dr, fabs(R[i][j] - R0[i][j]));
+			if((j < i && R[i][j]) || (i == j && R[i][i] < 0.)) dr = 1E100;
+		} // end for over i and j
+		for(int i = 0; i < m; i++) for(int j = 0; j < k; j++){
+			double s = 0.;
+			for(int l = 0; l <= j; l++) s += q[i + l*m] * R[l][j];
+			da = std::max(da, fabs(s - a[i + j*m]));
+		} // end for over i and j
+		char what[64];
+		sprintf(what, "%d vectors: Q^T*Q = 1, Q*R = A", k);
+		Check(std::max(dq, da) < 1E-12, what, std::max(dq, da));
+		sprintf(what, "%d vectors: R upper, as by QR()", k);
+		Check(dr < 1E-10, what, dr);
+	} // end for over k
+} // end of function TSQR
+
+static void SelectedCI(TAHamiltonian *h){
+	const int n = h->GetNBasis();
+	vector<double> e0;
+	vector<vector<double> > x0;
+	Lanczos(1, "", 300, e0, x0);
+	TASelectedCI *sci = TASelectedCI::Instance();
+	sci->SetNReference(1);
+	// eps = 0 selects all the SDs H reaches: the full space, no PT2 left //
+	sci->SetThreshold(0.);
+	sci->SetMaxIteration(20);
+	sci->Go();
+	const double d = fabs(sci->GetEnergy() - e0[0]) + fabs(sci->GetPT2());
+	Check(int(sci->GetSelected().size()) == n && d < 1E-8, "eps = 0: E_var = \
+E0 of the full space, E_PT2 = 0", d);
+	// a cut space: variational, its vector normalized and of <H> = E_var, and
+	// E_PT2 < 0 bringing E_var closer to E0 //
+	sci->SetThreshold(0.1);
+	sci->SetMaxIteration(2);
+	sci->Go();
+	const vector<int> &sel = sci->GetSelected();
+	const vector<double> &x = sci->GetVector();
+	double nrm = 0., eh = 0.;
+	for(size_t i = 0; i < sel.size(); i++){
+		nrm += x[i]*x[i];
+		for(size_t j = 0; j < sel.size(); j++)
+			eh += x[i]*h->Element(sel[i], sel[j])*x[j];
+	} // end for over i
+	const double ev = sci->GetEnergy(), pt2 = sci->GetPT2();
+	printf("dim: %d/%d, E_var: %f, E_PT2: %f, E0: %f\n", int(sel.size()), n,
+		ev, pt2, e0[0]);
+	Check(int(sel.size()) < n && ev > e0[0] - 1E-10 && fabs(nrm - 1.) < 1E-10 &&
+		fabs(eh - ev) < 1E-10, "eps = 0.1: E_var >= E0, <psi|psi> = 1, \
+<psi|H|psi> = E_var", std::max(fabs(nrm - 1.), fabs(eh - ev)));
+	Check(pt2 < 0. && fabs(ev + pt2 - e0[0]) < ev - e0[0], "eps = 0.1: \
+E_var+E_PT2 nearer to E0 than E_var", fabs(ev + pt2 - e0[0]));
+} // end of function SelectedCI
+
+int main(int argc, char *argv[]){
+	TAMPI::Init(&argc, &argv);
+	TAHamiltonian *h = TAHamiltonian::Instance();
+	h->InitializeCoefficient(false);
+	if(argc > 2 && !strcmp(argv[1], "checkpoint")) Checkpoint(h, argv[2]);
+	else if(argc > 1 && !strcmp(argv[1], "sell")) Sell(h);
+	else if(argc > 1 && !strcmp(argv[1], "order")) Order(h);
+	else if(argc > 1 && !strcmp(argv[1], "coefficient")) Coefficient(h);
+	else if(argc > 1 && !strcmp(argv[1], "sci")) SelectedCI(h);
+	else if(argc > 2 && !strcmp(argv[1], "jump")) Jump(h, argv[2]);
+	else if(argc > 1 && !strcmp(argv[1], "component")) Component(h);
+	else if(argc > 1 && !strcmp(argv[1], "density")) Density(h);
+	else if(argc > 1 && !strcmp(argv[1], "transition")) Transition(h);
+	else if(argc > 1 && !strcmp(argv[1], "strength")) Strength(h);
+	else if(argc > 1 && !strcmp(argv[1], "kpm")) KernelPolynomial(h);
+	else if(argc > 1 && !strcmp(argv[1], "shift-invert")) ShiftInvert(h);
+	else if(argc > 1 && !strcmp(argv[1], "propagator")) Propagator(h);
+	else if(argc > 1 && !strcmp(argv[1], "tsqr")) TSQR();
+	else{
+		printf("usage: %s test [scratch], test: checkpoint (with scratch), sell, \
+order, coefficient, sci, jump (with scratch), component, density, \
+transition, strength, kpm, shift-invert, propagator, tsqr\n", argv[0]);
+		nFail = 1;
+	} // end else
+	TAMPI::Finalize();
+
+	return nFail;
+} // end of the main function
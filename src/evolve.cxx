@@ -0,0 +1,70 @@
+/**
+	SUNNY Project, Anyang Normal University, IMP-CAS
+	\file evolve.cxx
+	\brief The time evolution of a many-body basis state |i> under H by the
+	Krylov propagator (TAPropagator), with no diagonalization:
+	mpirun -np 4 ./evolve [tMax nOut] [options]
+	default: 10 100. Options:
+	  -sd i: the initial basis state, default: 0
+	  -m m: the maximum Krylov dimension, default: 30
+	  -tol tol: the error allowed per unit time, default: 1E-10
+	Printed are t, the survival probability |<i|psi(t)>|^2, <H>, the norm,
+	and the H*v done so far.
+	\date Created: 2026/10/19
+	\date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "TAHamiltonian.h"
+#include "TAPropagator.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+int main(int argc, char *argv[]){
+	TAMPI::Init(&argc, &argv);
+	vector<double> num;
+	int sd = 0, m = 30;
+	double tol = 1E-10;
+	for(int i = 1; i < argc; i++){
+		if(!strcmp(argv[i], "-sd") && i + 1 < argc) sd = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-m") && i + 1 < argc) m = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-tol") && i + 1 < argc) tol = atof(argv[++i]);
+		else num.push_back(atof(argv[i]));
+	} // end for over arguments
+	const double tMax = num.size() > 0 ? num[0] : 10.;
+	const int nOut = num.size() > 1 ? int(num[1]) : 100;
+
+	TAHamiltonian *h = TAHamiltonian::Instance();
+	h->InitializeCoefficient(); // DEBUG
+	const int n = h->GetNBasis();
+	if(sd < 0 || sd >= n)
+		TAException::Error("evolve", "basis state %d not in [0, %d)", sd, n);
+	int r0, r1;
+	TAMPI::Partition(n, r0, r1);
+	vector<TAPropagator::cplx> psi(r1 - r0, 0.), psi0;
+	if(sd >= r0 && sd < r1) psi[sd-r0] = 1.;
+	psi0 = psi;
+
+	TAPropagator prop(h);
+	prop.SetKrylovDim(m);
+	prop.SetTolerance(tol);
+	if(TAMPI::IsRoot())
+		printf("#   t            |<i|psi>|^2    <H>          norm        H*v\n");
+	for(int k = 0; k <= nOut; k++){
+		if(k) prop.Propagate(psi, tMax / nOut);
+		const double p = std::norm(TAPropagator::Dot(psi0, psi));
+		const double nrm = TAPropagator::Dot(psi, psi).real();
+		const double e = prop.Energy(psi);
+		if(TAMPI::IsRoot()) printf("%12.6f %14.10f %12.8f %14.12f %8d\n",
+			tMax * k / nOut, p, e, nrm, prop.GetNMultiply());
+	} // end for over k
+	TAINFO("evolve", "error estimate: %g", prop.GetError());
+	if(TAMPI::IsRoot()) TAPROF_EXPORT("sunny_profile.json");
+	TAMPI::Finalize();
+
+	return 0;
+} // end of the main function
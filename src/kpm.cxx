@@ -0,0 +1,85 @@
+/**
+	SUNNY Project, Anyang Normal University, IMP-CAS
+	\file kpm.cxx
+	\brief The many-body level density of the M blocks by the kernel polynomial
+	method (TAKernelPolynomial), with no diagonalization:
+	mpirun -np 4 ./kpm [nMoment nVector] [options]
+	default: 200 20. Options:
+	  -M twoM: a block to do, may be repeated, default: that of
+	    TAManyBodySDManager
+	  -csr: H is computed once per block and kept in memory (TASparseMatrix),
+	    instead of matrix-free
+	  -vec: the random vectors are dealt out to the ranks, each taking all the
+	    rows, rather than split by rows; matrix-free only
+	  -nE n: the number of the energy points, default: 100
+	Printed are E, rho(E) and its error for each block.
+	\date Created: 2026/10/19
+	\date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "TAHamiltonian.h"
+#include "TAManyBodySDManager.h"
+#include "TAManyBodySDList.h"
+#include "TAKernelPolynomial.h"
+#include "TASparseMatrix.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+int main(int argc, char *argv[]){
+	TAMPI::Init(&argc, &argv);
+	vector<int> blocks, num;
+	bool csr = false, vec = false;
+	int nE = 100;
+	for(int i = 1; i < argc; i++){
+		if(!strcmp(argv[i], "-M") && i + 1 < argc)
+			blocks.push_back(atoi(argv[++i]));
+		else if(!strcmp(argv[i], "-nE") && i + 1 < argc) nE = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-csr")) csr = true;
+		else if(!strcmp(argv[i], "-vec")) vec = true;
+		else num.push_back(atoi(argv[i]));
+	} // end for over arguments
+	if(csr && vec) TAException::Error("kpm", "-vec needs H on all the rows, \
+so is not compatible with -csr");
+
+	TAHamiltonian *h = TAHamiltonian::Instance();
+	h->InitializeCoefficient(); // DEBUG
+	TAManyBodySDManager *manager = TAManyBodySDManager::Instance();
+	if(blocks.empty()) blocks.push_back(h->GetMBSDListM()->Get2M());
+	for(int twoM : blocks){
+		TAManyBodySDList *list = manager->GetMBSDList(twoM);
+		if(!list->GetNBasis()) continue;
+		h->SetMBSDListM(list);
+		TAOperator *op = h;
+		if(csr){
+			TASparseMatrix<double> *m = new TASparseMatrix<double>();
+			m->Build(h); op = m;
+		} // end if
+		TAKernelPolynomial kpm(op);
+		if(num.size() > 0) kpm.SetNMoment(num[0]);
+		if(num.size() > 1) kpm.SetNVector(num[1]);
+		kpm.SetVectorParallel(vec);
+		kpm.Go();
+		if(TAMPI::IsRoot()){
+			printf("# 2M = %d, dim: %d, E in [%f, %f]\n# E   rho(E)   error\n",
+				twoM, list->GetNBasis(), kpm.GetEMin(), kpm.GetEMax());
+			for(int k = 0; k < nE; k++){ // the centers of nE bins
+				const double e = kpm.GetEMin() +
+					(kpm.GetEMax() - kpm.GetEMin()) * (k + 0.5) / nE;
+				double err;
+				const double rho = kpm.Density(e, err);
+				printf("%12.6f %12.6f %12.6f\n", e, rho, err);
+			} // end for over k
+			printf("\n\n");
+		} // end if
+		if(op != h) delete op;
+	} // end for over blocks
+	if(TAMPI::IsRoot()) TAPROF_EXPORT("sunny_profile.json");
+	TAMPI::Finalize();
+
+	return 0;
+} // end of the main function
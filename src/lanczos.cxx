@@ -0,0 +1,211 @@
+/**
+	SUNNY Project, Anyang Normal University, IMP-CAS
+	\file lanczos.cxx
+	\brief The lowest eigenstates of the M-scheme Hamiltonian using the Lanczos
+	method. Built with -DSUNNY_MPI=ON, the basis index range is split over the
+	ranks: mpirun -np 4 ./lanczos [nEigen] [options]
+	By default H*v is computed matrix-free. Options:
+	  -ooc scratch: H is computed once and streamed from disk (TAOutOfCoreMatrix)
+	  -csr: H is computed once and kept in memory (TASparseMatrix)
+	  -sell: the same in the SIMD-friendly SELL-C-sigma form (TASellMatrix)
+	  -float: store the values in single precision, refined in double at the end
+	  -delta: delta-encoded column indices, with -csr
+	  -jump file: the 1+2-body H, gathered from the jump table (TAJumpTable) in
+	    file, which is built and saved first if file doesn't exist. The table
+	    has no 3-body jumps, so the 3-body part of H is dropped
+	  -occ: print the occupation numbers of the SP states in the eigenstates,
+	    and the leading SD of each, indexed in the order as generated
+	  -vec file: write the eigenvectors to file, one line per SD in the order
+	    as generated, whatever -order, after a line of the energies
+	  -target sigma: the nEigen states nearest to sigma instead of the lowest
+	    ones, by shift-invert and Rayleigh quotient iterations (TAShiftInvert)
+	  -block k: the block Lanczos method, H applied to k >= nEigen vectors at
+	    once (TABlockEigen), 0 for k = nEigen
+	  -lobpcg: LOBPCG instead of the block Lanczos method, with -block
+	  -checkpoint file: save the state of the Lanczos or block solver to file
+	    (TACheckpoint), and resume from it if it exists, e.g. after a crash
+	  -every n: iterations between two checkpoints, default: 20
+	  -order lex|rcm|conf: the basis reordered for the locality of H*v, by
+	    reverse Cuthill-McKee or grouped by configuration
+	    (TAManyBodySDList::Reorder), default: lex, as generated
+	\date Created: 2026/10/19
+	\date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cstdio>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "TAManyBodySDManager.h"
+#include "TAHamiltonian.h"
+#include "TAJumpTable.h"
+#include "TALanczos.h"
+#include "TAShiftInvert.h"
+#include "TABlockEigen.h"
+#include "TADensity.h"
+#include "TAOutOfCoreMatrix.h"
+#include "TASparseMatrix.h"
+#include "TASellMatrix.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+int main(int argc, char *argv[]){
+	TAMPI::Init(&argc, &argv);
+	int nEigen = 1;
+	const char *scratch = nullptr, *jump = nullptr, *checkpoint = "";
+	const char *vec = nullptr;
+	bool csr = false, sell = false, single = false, delta = false, occ = false;
+	bool targeted = false, lobpcg = false;
+	int block = -1; // the block size, < 0 for the single-vector Lanczos
+	int every = 20;
+	double target = 0.;
+	for(int i = 1; i < argc; i++){
+		if(!strcmp(argv[i], "-ooc") && i + 1 < argc) scratch = argv[++i];
+		else if(!strcmp(argv[i], "-jump") && i + 1 < argc) jump = argv[++i];
+		else if(!strcmp(argv[i], "-csr")) csr = true;
+		else if(!strcmp(argv[i], "-sell")) sell = true;
+		else if(!strcmp(argv[i], "-float")) single = true;
+		else if(!strcmp(argv[i], "-delta")) delta = true;
+		else if(!strcmp(argv[i], "-occ")) occ = true;
+		else if(!strcmp(argv[i], "-vec") && i + 1 < argc) vec = argv[++i];
+		else if(!strcmp(argv[i], "-lobpcg")) lobpcg = true;
+		else if(!strcmp(argv[i], "-block") && i + 1 < argc)
+			block = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-checkpoint") && i + 1 < argc)
+			checkpoint = argv[++i];
+		else if(!strcmp(argv[i], "-every") && i + 1 < argc) every = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-order") && i + 1 < argc){
+			i++;
+			if(strcmp(argv[i], "lex") && strcmp(argv[i], "rcm") &&
+					strcmp(argv[i], "conf"))
+				TAException::Error("lanczos", "-order %s: unknown, lex, rcm or \
+conf expected", argv[i]);
+			TAManyBodySDManager::Instance()->SetOrder(
+				!strcmp(argv[i], "rcm") ? TAManyBodySDList::kRCM :
+				!strcmp(argv[i], "conf") ? TAManyBodySDList::kConfiguration :
+				TAManyBodySDList::kLexicographic);
+		} // end if
+		else if(!strcmp(argv[i], "-target") && i + 1 < argc){
+			targeted = true; target = atof(argv[++i]);
+		} // end if
+		else nEigen = atoi(argv[i]);
+	} // end for over arguments
+
+	TAHamiltonian *h = TAHamiltonian::Instance();
+	h->InitializeCoefficient(!jump);
+	TAJumpTable table;
+	if(jump){
+		TAException::Warn("lanczos", "-jump: the 3-body part of H is dropped, \
+the jump table being of 1+2-body jumps only");
+		if(!table.Read(jump, h->GetMBSDListM())){
+			table.Build(h->GetMBSDListM());
+			// renamed into place whole, see TAJumpTable::Write //
+			if(TAMPI::IsRoot()) table.Write(jump);
+		} // end if
+		TAMPI::Barrier(); // no rank goes on before the table is in place
+		h->SetJumpTable(&table);
+	} // end if
+	TALanczos *lanczos = TALanczos::Instance();
+	lanczos->SetNEigen(nEigen);
+	lanczos->SetCheckpoint(checkpoint, every);
+	TAOperator *op = nullptr;
+	if(scratch){
+		TAOutOfCoreMatrix *ooc = new TAOutOfCoreMatrix(scratch);
+		ooc->SetSinglePrecision(single);
+		ooc->Build(h);
+		op = ooc;
+	} // end if
+	else if(sell){
+		if(single){
+			TASellMatrix<float> *m = new TASellMatrix<float>();
+			m->Build(h); op = m;
+		} // end if
+		else{
+			TASellMatrix<double> *m = new TASellMatrix<double>();
+			m->Build(h); op = m;
+		} // end else
+	} // end if
+	else if(csr){
+		const int index = delta ? TASparseMatrix<float>::kIndexDelta :
+			TASparseMatrix<float>::kIndex32;
+		if(single){
+			TASparseMatrix<float> *m = new TASparseMatrix<float>(
+				TASparseMatrix<float>::EIndex(index));
+			m->Build(h); op = m;
+		} // end if
+		else{
+			TASparseMatrix<double> *m = new TASparseMatrix<double>(
+				TASparseMatrix<double>::EIndex(index));
+			m->Build(h); op = m;
+		} // end else
+	} // end if
+	TAShiftInvert si(op);
+	TABlockEigen be(op, lobpcg ? TABlockEigen::kLOBPCG :
+		TABlockEigen::kBlockLanczos);
+	if(lobpcg && block < 0) block = 0;
+	if(targeted){
+		si.SetTarget(target);
+		si.SetNEigen(nEigen);
+		si.Go();
+	} // end if
+	else if(block >= 0){
+		be.SetNEigen(nEigen);
+		be.SetBlockSize(block);
+		be.SetCheckpoint(checkpoint, every);
+		be.Go();
+	} // end if
+	else{
+		if(op) lanczos->SetOperator(op);
+		if(op && single) lanczos->SetRefineOperator(h);
+		lanczos->Go();
+	} // end else
+	// the eigenstates, indexed in the order as generated, whatever -order //
+	const TAManyBodySDList *list = h->GetMBSDListM();
+	const int nb = list->GetNBasis();
+	const int ne = targeted ? si.GetNEigen() : block >= 0 ? be.GetNEigen() :
+		lanczos->GetNEigen();
+	if(ne < std::min(nEigen, nb)) TAException::Warn("lanczos", "%d eigenstates \
+found, fewer than the %d asked for", ne, nEigen);
+	vector<double> e(ne), x;
+	vector<vector<double> > y(vec ? ne : 0);
+	for(int j = 0; (occ || vec) && j < ne; j++){
+		const vector<double> &v = targeted ? si.GetVector(j) : block >= 0 ?
+			be.GetVector(j) : lanczos->GetVector(j);
+		e[j] = targeted ? si.GetEnergy(j) : block >= 0 ? be.GetEnergy(j) :
+			lanczos->GetEnergy(j);
+		TAMPI::AllGather(v, x, nb);
+		if(vec) list->ToOriginalOrder(x, y[j]);
+		if(!occ) continue;
+		vector<double> n;
+		TADensity::Occupation(v, n);
+		int lead = 0;
+		for(int i = 1; i < nb; i++) if(fabs(x[i]) > fabs(x[lead])) lead = i;
+		if(!TAMPI::IsRoot()) continue;
+		printf("E[%d] = %f, leading SD: %d (%.4f), occupations:", j, e[j],
+			list->GetOriginalIndex(lead), x[lead]);
+		for(double o : n) printf(" %.4f", o);
+		printf("\n");
+	} // end for over eigenstates
+	if(vec && TAMPI::IsRoot()){
+		FILE *f = fopen(vec, "w");
+		if(!f) TAException::Error("lanczos", "cannot open %s", vec);
+		else{
+			fprintf(f, "# SD");
+			for(int j = 0; j < ne; j++) fprintf(f, " E[%d] = %f", j, e[j]);
+			fprintf(f, "\n");
+			for(int i = 0; i < nb; i++){
+				fprintf(f, "%d", i);
+				for(int j = 0; j < ne; j++) fprintf(f, " %.10f", y[j][i]);
+				fprintf(f, "\n");
+			} // end for over SDs
+			fclose(f);
+		} // end else
+	} // end if
+	if(op) delete op;
+	if(TAMPI::IsRoot()) TAPROF_EXPORT("sunny_profile.json");
+	TAMPI::Finalize();
+
+	return 0;
+} // end of the main function
@@ -0,0 +1,24 @@
+/**
+	SUNNY Project, Anyang Normal University, IMP-CAS
+	\file sci.cxx
+	\brief Selected configuration interaction with the Epstein-Nesbet PT2
+	correction for the discarded part of the M-scheme many-body basis
+	\date Created: 2026/10/19
+	\date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include "TAHamiltonian.h"
+#include "TASelectedCI.h"
+#include "TAProfiler.h"
+
+int main(){
+	TAHamiltonian::Instance()->InitializeCoefficient(); // DEBUG
+	TASelectedCI *sci = TASelectedCI::Instance();
+	sci->SetNReference(1);
+	sci->SetThreshold(1E-3);
+	sci->Go(); // select, diagonalize and correct by PT2
+	TAPROF_EXPORT("sunny_profile.json");
+
+	return 0;
+} // end of the main function
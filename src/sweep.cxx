@@ -0,0 +1,57 @@
+/**
+	SUNNY Project, Anyang Normal University, IMP-CAS
+	\file sweep.cxx
+	\brief A scan of the lowest eigenvalues of H(lambda, mu) = H_1N +
+	lambda*H_2N + mu*H_3N over lambda. The parts of H are computed once
+	(TAComponentMatrix), and each point is started from the eigenvectors of the
+	previous one: mpirun -np 4 ./sweep [nEigen lambda0 lambda1 nPoint mu]
+	default: 1 0 1 11 1
+	\date Created: 2026/10/19
+	\date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include "TAHamiltonian.h"
+#include "TAComponentMatrix.h"
+#include "TALanczos.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+int main(int argc, char *argv[]){
+	TAMPI::Init(&argc, &argv);
+	const int nEigen = argc > 1 ? atoi(argv[1]) : 1;
+	const double lambda0 = argc > 2 ? atof(argv[2]) : 0.;
+	const double lambda1 = argc > 3 ? atof(argv[3]) : 1.;
+	const int nPoint = argc > 4 ? atoi(argv[4]) : 11;
+	const double mu = argc > 5 ? atof(argv[5]) : 1.;
+
+	TAHamiltonian *h = TAHamiltonian::Instance();
+	h->InitializeCoefficient(); // DEBUG
+	TAComponentMatrix hc;
+	hc.Build(h);
+	TALanczos *lanczos = TALanczos::Instance();
+	lanczos->SetOperator(&hc);
+	lanczos->SetNEigen(nEigen);
+	lanczos->SetWarmStart();
+	if(TAMPI::IsRoot()) printf("#   lambda       mu   Krylov dim   E[0], ...\n");
+	for(int i = 0; i < nPoint; i++){
+		const double lambda = nPoint > 1 ?
+			lambda0 + (lambda1 - lambda0) * i / (nPoint - 1) : lambda0;
+		hc.SetScale(lambda, mu);
+		lanczos->Go();
+		if(!TAMPI::IsRoot()) continue;
+		const int ne = lanczos->GetNEigen();
+		if(ne < nEigen) TAException::Warn("sweep", "lambda = %f: %d eigenstates \
+found, fewer than the %d asked for", lambda, ne, nEigen);
+		printf("%10.4f %8.4f %8d    ", lambda, mu, lanczos->GetNIteration());
+		for(int j = 0; j < ne; j++) printf(" %12.6f", lanczos->GetEnergy(j));
+		printf("\n");
+	} // end for over points
+	if(TAMPI::IsRoot()) TAPROF_EXPORT("sunny_profile.json");
+	TAMPI::Finalize();
+
+	return 0;
+} // end of the main function
@@ -0,0 +1,140 @@
+/**
+	SUNNY Project, Anyang Normal University, IMP-CAS
+	\file transition.cxx
+	\brief The electromagnetic transitions between the lowest eigenstates of H.
+	The initial states are solved in the M block of TAManyBodySDManager, and
+	the final ones in that of 2M + 2mu, then the one-body operator O_mu
+	(TAOneBodyOperator) is applied to them matrix-free in the same process:
+	mpirun -np 4 ./transition [nEigen] [options]
+	Options:
+	  -E lambda: O = r^lambda*Y_lambda, of the oscillator length b
+	  -M1: O = sqrt(3/4pi)*(gl*l + gs*s), the default
+	  -mu mu: the component of O, default: 0
+	  -b b: the oscillator length, default: 1
+	  -strength nStep: the strength function of O_mu from the ground state,
+	    by nStep Lanczos iterations from O_mu|0> instead of the final states
+	  -eta eta: the half width of the Lorentzian folding, default: 0.1
+	Printed are <f|O_mu|i>, and the reduced matrix elements and B(O; i->f) with
+	J from <J^2>, meaningful only for a rotationally invariant H. Or for
+	-strength, the Gauss quadrature of |<f|O_mu|0>|^2 over the final energies,
+	followed by the folded strength function on a grid.
+	\date Created: 2026/10/19
+	\date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include "TAHamiltonian.h"
+#include "TAManyBodySDManager.h"
+#include "TAManyBodySDList.h"
+#include "TALanczos.h"
+#include "TAOneBodyOperator.h"
+#include "TAMathFCI.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+int main(int argc, char *argv[]){
+	TAMPI::Init(&argc, &argv);
+	int nEigen = 1, lambda = 1, mu = 0, nStep = 0;
+	bool elec = false;
+	double b = 1., eta = 0.1;
+	for(int i = 1; i < argc; i++){
+		if(!strcmp(argv[i], "-E") && i + 1 < argc){
+			elec = true; lambda = atoi(argv[++i]);
+		} // end if
+		else if(!strcmp(argv[i], "-M1")){ elec = false; lambda = 1; }
+		else if(!strcmp(argv[i], "-mu") && i + 1 < argc) mu = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-b") && i + 1 < argc) b = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-strength") && i + 1 < argc)
+			nStep = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-eta") && i + 1 < argc) eta = atof(argv[++i]);
+		else nEigen = atoi(argv[i]);
+	} // end for over arguments
+
+	TAHamiltonian *h = TAHamiltonian::Instance();
+	h->InitializeCoefficient(); // DEBUG
+	TALanczos *lanczos = TALanczos::Instance();
+	lanczos->SetNEigen(nEigen);
+	// the initial states //
+	TAManyBodySDList *from = h->GetMBSDListM();
+	lanczos->Go();
+	const int ni = lanczos->GetNEigen();
+	if(ni < std::min(nEigen, from->GetNBasis())) TAException::Warn("transition",
+		"%d initial states found, fewer than the %d asked for", ni, nEigen);
+	vector<vector<double> > xi;
+	vector<double> ei, ji;
+	for(int j = 0; j < ni; j++){
+		xi.push_back(lanczos->GetVector(j));
+		ei.push_back(lanczos->GetEnergy(j));
+		ji.push_back(TAOneBodyOperator::AngularMomentum(from, xi.back()));
+	} // end for over j
+	const TAOneBodyOperator o(lambda, mu, elec ?
+		TAOneBodyOperator::E(lambda, b) : TAOneBodyOperator::M1());
+	TAManyBodySDList *to = mu ?
+		TAManyBodySDManager::Instance()->GetMBSDList(from->Get2M() + 2*mu) : from;
+	if(mu) h->SetMBSDListM(to);
+	// the strength function from the ground state //
+	if(nStep){
+		vector<double> y, e, s;
+		o.Multiply(from, xi[0], to, y);
+		lanczos->Strength(y, nStep);
+		lanczos->GetStrength(e, s);
+		if(TAMPI::IsRoot() && e.size()){
+			printf("# %s%d, mu = %d, 2M: %d -> %d, E0 = %f, total strength: %f\n",
+				elec ? "E" : "M", lambda, mu, from->Get2M(), to->Get2M(), ei[0],
+				lanczos->GetTotalStrength());
+			printf("# Gauss quadrature: E   E-E0   S\n");
+			for(size_t k = 0; k < e.size(); k++)
+				printf("%12.6f %12.6f %12.6f\n", e[k], e[k] - ei[0], s[k]);
+			printf("\n\n# folded with eta = %f: E   E-E0   S(E)\n", eta);
+			const double e0 = e.front() - 5.*eta, e1 = e.back() + 5.*eta;
+			const int nGrid = 400;
+			for(int k = 0; k <= nGrid; k++){
+				const double x = e0 + (e1 - e0) * k / nGrid;
+				printf("%12.6f %12.6f %12.6f\n", x, x - ei[0],
+					lanczos->StrengthFunction(x, eta));
+			} // end for over k
+		} // end if
+		if(TAMPI::IsRoot()) TAPROF_EXPORT("sunny_profile.json");
+		TAMPI::Finalize();
+		return 0;
+	} // end if
+	// the final states //
+	if(mu) lanczos->Go();
+	const int nf = lanczos->GetNEigen();
+	if(nf < std::min(nEigen, to->GetNBasis())) TAException::Warn("transition",
+		"%d final states found, fewer than the %d asked for", nf, nEigen);
+	vector<double> ef, jf;
+	for(int j = 0; j < nf; j++){
+		ef.push_back(lanczos->GetEnergy(j));
+		jf.push_back(TAOneBodyOperator::AngularMomentum(to,
+			lanczos->GetVector(j)));
+	} // end for over j
+	if(TAMPI::IsRoot()){
+		printf("# %s%d, mu = %d, 2M: %d -> %d\n", elec ? "E" : "M", lambda, mu,
+			from->Get2M(), to->Get2M());
+		printf("#  i   Ei         Ji     f   Ef         Jf     <f|O|i>      \
+<Jf||O||Ji>  B(i->f)\n");
+	} // end if
+	for(int i = 0; i < ni; i++) for(int f = 0; f < nf; f++){
+		const vector<double> &y = lanczos->GetVector(f);
+		const double me = o.Element(to, y, from, xi[i]);
+		const int tJi = lround(2.*ji[i]), tJf = lround(2.*jf[f]);
+		const bool allowed = TAMathFCI::ThreeJ(tJf, 2*lambda, tJi, -to->Get2M(),
+			2*mu, from->Get2M());
+		const double r = allowed ? o.Reduced(tJf, to, y, tJi, from, xi[i]) : 0.;
+		if(!TAMPI::IsRoot()) continue;
+		printf("%4d %10.6f %5.2f %4d %10.6f %5.2f %12.6f", i, ei[i], ji[i], f,
+			ef[f], jf[f], me);
+		if(allowed) printf(" %12.6f %12.6f\n", r, r*r / (tJi + 1.));
+		else printf("    forbidden\n");
+	} // end for over i and f
+	if(TAMPI::IsRoot()) TAPROF_EXPORT("sunny_profile.json");
+	TAMPI::Finalize();
+
+	return 0;
+} // end of the main function
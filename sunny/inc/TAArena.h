@@ -0,0 +1,57 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAArena.h
+  \class TAArena
+  \brief A bump-pointer memory arena. Memory is carved in order out of large
+  chunks, and is only given back all at once by Release() or the destructor,
+  so that a myriad of small objects of the same lifetime, e.g. the many-body
+  SDs of TAManyBodySDManager, cost no malloc/free each and lie contiguously.
+  Objects placed in the arena are not destructed by it: the owner calls their
+  destructors, if nontrivial, before Release().
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAArena_h_
+#define _TAArena_h_
+
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+class TAArena{
+public:
+  /// \param chunkSize: the least size of each chunk requested from the heap
+  explicit TAArena(size_t chunkSize = 1<<20);
+  virtual ~TAArena();
+
+  /// \retval bytes of uninitialized memory aligned to align (a power of 2)
+  void *Allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+  /// \retval uninitialized storage for n objects of type T
+  template <typename T>
+  T *Allocate(size_t n){
+    return static_cast<T *>(Allocate(n * sizeof(T), alignof(T)));
+  }
+  /// make sure that the next bytes bytes in total go into a single chunk
+  void Reserve(size_t bytes);
+  /// give all the memory back to the heap in one step
+  void Release();
+  /// \retval bytes taken from the heap
+  size_t GetCapacity() const{ return fCapacity; }
+  /// \retval bytes handed out since the last Release()
+  size_t GetUsed() const{ return fUsed; }
+
+private:
+  TAArena(const TAArena &) = delete;
+  TAArena &operator=(const TAArena &) = delete;
+  void NewChunk(size_t bytes); ///< start a new chunk of at least bytes
+
+  size_t fChunkSize; ///< the default size of a chunk
+  vector<char *> fChunk; ///< the chunks from the heap
+  char *fCur, *fEnd; ///< the free range [fCur, fEnd) in the last chunk
+  size_t fCapacity, fUsed;
+};
+
+#endif
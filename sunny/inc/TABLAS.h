@@ -0,0 +1,42 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TABLAS.h
+  \class TABLAS
+  \brief BLAS-1 kernels on contiguous double arrays, in place and free of any
+  allocation, for the vector work of the Krylov solvers and orthogonalizations.
+  They are vectorized with AVX-512 or AVX2+FMA when the compiler targets them
+  (cmake -DSUNNY_NATIVE=ON for the host CPU), and fall back to plain loops
+  otherwise. The multi-vector kernels sweep y in cache-sized chunks, so that y
+  is read from memory once for all the m vectors instead of m times.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TABLAS_h_
+#define _TABLAS_h_
+
+class TABLAS{
+public:
+  /// \retval x.y
+  static double Dot(const double *x, const double *y, long n);
+  /// y += a*x
+  static void Axpy(double a, const double *x, double *y, long n);
+  /// x *= a
+  static void Scal(double a, double *x, long n);
+  /// \retval |x|
+  static double Nrm2(const double *x, long n);
+  /// y += a*x, \retval y.z with the updated y, in one sweep
+  static double AxpyDot(double a, const double *x, double *y, const double *z,
+    long n);
+  /// c[k] = x[k].y, k = 0, ..., m-1
+  static void MultiDot(const double *const *x, int m, const double *y, long n,
+    double *c);
+  /// y += sum_k c[k]*x[k], k = 0, ..., m-1
+  static void MultiAxpy(const double *c, const double *const *x, int m,
+    double *y, long n);
+  /// \retval the instruction set the kernels are compiled for
+  static const char *ISA();
+};
+
+#endif
@@ -22,6 +22,13 @@ public:
   TABit &operator=(const TABit &bit); ///< assignment constructor
   /// \retval: <*this|bit> with phase updated
   int operator*(const TABit &bit) const;
+  /// \retval number of SP states occupied in *this but empty in bit, i.e. the
+  /// excitation rank between two SDs of the same particle number
+  int NDiff(const TABit &bit) const;
+  /// \retval whether the two have the same SP states occupied, phases aside
+  bool SameBit(const TABit &bit) const;
+  /// \retval a hash of the occupation, for lookups of SDs by their bits
+  unsigned long Hash() const;
   virtual ~TABit();
 
 
@@ -40,6 +47,9 @@ public:
   void PrintInBit() const; ///< print in bit
 
 private:
+  /// \retval number of SP states occupied below p
+  int NBelow(int p) const;
+
   unsigned fBit[4]; ///< 128-bit for 128 SP state capacity
   short fPhase; ///< 0, +-1
 };
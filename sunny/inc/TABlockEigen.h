@@ -0,0 +1,105 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TABlockEigen.h
+  \class TABlockEigen
+  \brief Block eigensolvers for the lowest eigenpairs of a symmetric operator,
+  for when many states are wanted: O is applied to a block of k vectors at a
+  time by TAOperator::MultiplyBlock, so that each matrix element, stored or
+  computed on the fly, is loaded once and used k times. Two methods:
+  the block Lanczos method with full reorthogonalization, restarted from the
+  Ritz vectors once the Krylov space reaches its maximum size, and LOBPCG,
+  the locally optimal block preconditioned conjugate gradient (Knyazev),
+  here without a preconditioner, whose subspace [X, W, P] stays 3k wide. The
+  blocks are orthonormalized by TAMathFCI::TSQR, and distributed over the MPI
+  ranks as local segments, as in TALanczos. With SetCheckpoint(), the current
+  block is saved now and then, and a rerun starts from it.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TABlockEigen_h_
+#define _TABlockEigen_h_
+
+#include <vector>
+#include <string>
+
+using std::vector;
+using std::string;
+
+class TAOperator;
+class TACheckpoint;
+
+class TABlockEigen{
+public:
+  enum EMethod{
+    kBlockLanczos, ///< block Lanczos, restarted from the Ritz vectors
+    kLOBPCG ///< locally optimal block conjugate gradient
+  };
+
+  /// \param op: the operator to diagonalize, default: TAHamiltonian
+  TABlockEigen(TAOperator *op = nullptr, EMethod method = kBlockLanczos);
+  virtual ~TABlockEigen(){}
+
+  void SetMethod(EMethod method){ fMethod = method; }
+  void SetNEigen(int n){ fNEigen = n; } ///< the lowest eigenpairs wanted
+  /// \param k: vectors per block, at least nEigen, default: 0 for nEigen
+  void SetBlockSize(int k){ fBlockSize = k; }
+  /// \param n: maximum number of block products O*X, default: 300
+  void SetMaxIteration(int n){ fMaxIteration = n; }
+  /// \param n: maximum number of blocks in the Krylov space of the block
+  /// Lanczos method before a restart, default: 20
+  void SetMaxBlock(int n){ fMaxBlock = n; }
+  /// \param tol: converged once the residual |O*x-E*x| < tol*max(1,|E|)
+  void SetTolerance(double tol){ fTolerance = tol; }
+  /// \param file: save the current block X to file (see TACheckpoint), in the
+  /// background, every interval block products for LOBPCG, and at each restart
+  /// for block Lanczos. Go() starts from the X in file, if it is of the same
+  /// basis and block size, instead of a random one. "" for no checkpoint
+  void SetCheckpoint(const string &file, int interval = 20){
+    fCheckpoint = file; fCheckpointInterval = interval;
+  }
+
+  void Go(); ///< find the eigenpairs
+  int GetNEigen() const{ return fEnergy.size(); }
+  double GetEnergy(int i = 0) const;
+  /// \retval the local segment of the i-th eigenvector, rows [r0, r1) of
+  /// TAMPI::Partition
+  const vector<double> &GetVector(int i = 0) const;
+  int GetNIteration() const{ return fNIteration; } ///< \retval block products
+  int GetNMultiply() const{ return fNMultiply; } ///< \retval O*v, per vector
+
+protected:
+  /// hx = O*x for k vectors, both local blocks, column j at x+j*nl
+  void Multiply(const double *x, int k, double *hx);
+  /// project the k columns of x out of the m orthonormal vectors q
+  void Project(double *x, int k, const vector<const double *> &q) const;
+  /// c_ij = <a_i|b_j>, a and b m and k local vectors, c m x k column-major
+  void Gram(const vector<const double *> &a, const vector<const double *> &b,
+    vector<double> &c) const;
+  /// the k random vectors from the global index, independent of the ranks
+  void Start(vector<double> &x, int k) const;
+  /// \retval whether the k vectors of x are read from the checkpoint
+  bool Resume(vector<double> &x, int k);
+  /// save the k vectors of x and their Ritz values theta to the checkpoint
+  void Save(const vector<double> &x, const vector<double> &theta, int k);
+  void BlockLanczos(int nev, int k);
+  void LOBPCG(int nev, int k);
+
+  TAOperator *fOperator;
+  EMethod fMethod;
+  int fNEigen, fBlockSize;
+  int fMaxIteration, fMaxBlock;
+  double fTolerance;
+  string fCheckpoint; ///< the checkpoint file, "" for none
+  int fCheckpointInterval; ///< block products between two checkpoints
+  TACheckpoint *fCkp; ///< the checkpoint open in Go()
+  long fSlot; ///< where to write the next X, alternately 0 and k
+  int fNIteration, fNMultiply;
+  int fR0, fR1; ///< the local rows [fR0, fR1)
+  vector<double> fPack, fFull, fW; ///< buffers for O*X, vectors interleaved
+  vector<double> fEnergy; ///< the eigenvalues, in ascending order
+  vector<vector<double> > fVector; ///< local segments of the eigenvectors
+};
+
+#endif
@@ -0,0 +1,78 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TACheckpoint.h
+  \class TACheckpoint
+  \brief A checkpoint file of an iterative eigensolver, from which a run killed
+  e.g. by a node failure resumes where it was. The file holds records of one
+  size, each nScalar numbers followed by the local segment of a vector, and a
+  header telling which of them are committed: [first, first+count). Write()
+  puts the records to disk in the background, and commits them, by rewriting
+  the header, only once they are all flushed, so that a crash at any moment
+  leaves the last complete checkpoint behind. Under MPI each rank writes its
+  own segments to a file of its own. The header also holds a fingerprint of
+  the operator, see Fingerprint(), so that a checkpoint of another basis or
+  Hamiltonian of the same dimension is never resumed from.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TACheckpoint_h_
+#define _TACheckpoint_h_
+
+#include <string>
+#include <vector>
+#include <future>
+#include <cstdio>
+
+using std::string;
+using std::vector;
+
+class TAOperator;
+
+class TACheckpoint{
+public:
+  /// \param file: suffixed by the rank under MPI
+  TACheckpoint(const string &file);
+  virtual ~TACheckpoint(); ///< waits for the pending write
+
+  /// open the file for the segments [r0, r1) of vectors of length n, with
+  /// nScalar numbers per record. A file of the same layout and fingerprint is
+  /// kept for Read(), otherwise it is started anew. To be called by all the
+  /// ranks together
+  /// \retval the number of records committed in the files of all the ranks
+  long Open(int n, int r0, int r1, int nScalar, unsigned long fingerprint);
+  /// \retval a hash of op: of <x|O|x> and |O*x|^2 for a fixed x, and of the SD
+  /// list for a TAHamiltonian, so that any change of the basis, its order or
+  /// the coefficients shows. Costs one O*x. To be called by all the ranks
+  static unsigned long Fingerprint(TAOperator *op);
+  long GetFirst() const{ return fFirst; }
+  long GetNRecord() const{ return fCount; }
+  const string &GetFile() const{ return fFile; }
+  /// read the i-th committed record, i.e. slot GetFirst()+i, into s[nScalar]
+  /// and the segment x
+  void Read(long i, double *s, vector<double> &x);
+  /// write the records in data, each nScalar numbers and the r1-r0 of the
+  /// segment, to the slots from at on, then commit [first, first+count), all
+  /// in the background, after the former write, if any, is over
+  void Write(vector<double> &&data, long at, long first, long count);
+  /// wait for the pending write, if any, and commit it here, or report its
+  /// failure, the last committed records being kept then
+  void Wait();
+
+private:
+  /// the body of Write(), run in another thread, reporting nothing itself
+  /// \retval whether the records and the header are all on the disk
+  bool Flush(vector<double> data, long at, long first, long count);
+  long Offset(long slot) const; ///< \retval the position of slot in the file
+
+  string fFile;
+  FILE *fStream;
+  int fNBasis, fR0, fR1, fNScalar;
+  unsigned long fFingerprint; ///< that of the operator, see Fingerprint()
+  long fFirst, fCount; ///< the records committed
+  long fNextFirst, fNextCount; ///< those to be committed by the pending write
+  std::future<bool> fPending; ///< the write under way
+};
+
+#endif
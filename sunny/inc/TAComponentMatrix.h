@@ -0,0 +1,64 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAComponentMatrix.h
+  \class TAComponentMatrix
+  \brief The Hamiltonian H(lambda, mu) = H_1N + lambda*H_2N + mu*H_3N for scans
+  of the coupling strengths. The 1N, 2N and 3N parts are computed once and
+  stored in CSR form on one sparsity pattern, their values side by side, and
+  the product combines them on the fly, so that a new point of the scan costs
+  SetScale() instead of a new matrix. Under MPI only the rows of this rank are
+  stored. Best used with TALanczos::SetWarmStart(), which starts each point
+  from the eigenvectors of the previous one.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAComponentMatrix_h_
+#define _TAComponentMatrix_h_
+
+#include <vector>
+#include "TAOperator.h"
+
+using std::vector;
+
+class TAHamiltonian;
+
+class TAComponentMatrix : public TAOperator{
+public:
+  TAComponentMatrix();
+  virtual ~TAComponentMatrix(){}
+
+  /// compute and store the parts of the rows of this rank
+  void Build(TAHamiltonian *h);
+  /// H = H_1N + lambda*H_2N + mu*H_3N, default: lambda = mu = 1, i.e. h itself
+  void SetScale(double lambda, double mu = 1.){ fLambda = lambda; fMu = mu; }
+  double GetLambda() const{ return fLambda; }
+  double GetMu() const{ return fMu; }
+  virtual int GetNBasis() const override{ return fNBasis; }
+  /// w[i-r0] = sum_j <i|H(lambda, mu)|j>*v[j], for rows i in [r0, r1), which
+  /// must be stored on this rank
+  virtual void Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1) override;
+  /// the same for k vectors interleaved, each element combined once for all
+  virtual void MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1) override;
+
+  /// \retval number of parts stored: 1, 2 or 3 as h has a 2N and 3N force
+  int GetNComponent() const{ return fNComponent; }
+  long GetNNZ() const{ return fCol.size(); }
+  /// \retval memory taken by the matrix elements and indices
+  long GetBytes() const;
+
+protected:
+  int fNBasis;
+  int fR0, fR1; ///< rows [fR0, fR1) stored in this object
+  int fNComponent;
+  double fLambda, fMu;
+  vector<long> fPtr; ///< row i starts at fPtr[i-fR0] in fCol
+  vector<int> fCol;
+  /// the fNComponent parts of element k at fVal[k*fNComponent...]
+  vector<double> fVal;
+};
+
+#endif
@@ -0,0 +1,39 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TADensity.h
+  \class TADensity
+  \brief One-body densities of the many-body states, e.g. the eigenvectors of
+  TALanczos: the (transition) density matrix rho_pq = <a|a+_p * a_q|b> for all
+  the (p,q) at once, and the occupation numbers n_p = <a|a+_p * a_p|a>. The
+  states are given as the local segments of TAMPI::Partition over the M-scheme
+  basis of TAManyBodySDManager. One sweep over the kets of this rank applies
+  all the a+_p * a_q conserving M by TAManyBodySDList::Apply, threaded with
+  OpenMP (cmake -DSUNNY_OPENMP=ON, the default) and summed over the ranks.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TADensity_h_
+#define _TADensity_h_
+
+#include <vector>
+#include "TAMatrix.h"
+
+using std::vector;
+
+class TADensity{
+public:
+  /// rho[p][q] = <a|a+_p * a_q|b>, a and b being the local segments
+  static void OneBody(const vector<double> &a, const vector<double> &b,
+    TAMatrix2D &rho);
+  /// rho[p][q] = <a|a+_p * a_q|a>
+  static void OneBody(const vector<double> &a, TAMatrix2D &rho){
+    OneBody(a, a, rho);
+  }
+  /// n[p] = <a|a+_p * a_p|a>, sum_p n[p] being the number of particles if a
+  /// is normalized
+  static void Occupation(const vector<double> &a, vector<double> &n);
+};
+
+#endif
@@ -5,7 +5,7 @@
 	\brief to print error, warnings, etc.
 	\author SUN Yazhou, asia.rabbit@163.com
 	\date Created: 2020/01/31
-	\date Last modified: 2020/01/31
+	\date Last modified: 2026/10/19
 	\copyright 2020, by SUN Yazhou
 	\copyright SUNNY project, Anyang Normal University, IMP-CAS
 */
@@ -13,24 +13,70 @@
 #ifndef _TAException_h_
 #define _TAException_h_
 
+/// the maximum verbosity compiled in, see TAException::ELevel. Messages above
+/// it cost nothing, not even the formatting of the arguments
+#ifndef SUNNY_LOG_LEVEL
+#define SUNNY_LOG_LEVEL 3
+#endif
+
+#include <cassert>
+
 class TAException{
 public:
+	/// verbosity levels
+	enum ELevel{ kError = 0, kWarn = 1, kInfo = 2, kDebug = 3 };
+
 	TAException(){};
 	virtual ~TAException(){};
 
 	/// \param cname: class name
 	static void Info(const char *cname, const char *fmt, ...);
+	/// print the error and abort, or ask whether to, in interactive mode
 	static void Error(const char *cname, const char *fmt, ...);
+	/// print the warning, unless the verbosity is below kWarn, and go on, or
+	/// ask whether to, in interactive mode
 	static void Warn(const char *cname, const char *fmt, ...);
 	static void Debug(const char *cname, const char *fmt, ...);
+	/// wait for ENTER, only if pausing is enabled, for interactive debugging
+	static void Pause();
 
-	static void Silent(bool opt = true){ fIsSilent = opt; }
-	static bool IsSilent() { return fIsSilent; }
-	static void SetDebug(bool opt = true){ fIsDebug = opt; }
-	static bool IsDebug() { return fIsDebug; }
+	/// runtime verbosity, default: kInfo
+	static void SetVerbose(int level){ fVerbose = level; }
+	static int GetVerbose(){ return fVerbose; }
+	static void Silent(bool opt = true){ fVerbose = opt ? kWarn : kInfo; }
+	static bool IsSilent() { return fVerbose < kInfo; }
+	static void SetDebug(bool opt = true){ fVerbose = opt ? kDebug : kInfo; }
+	static bool IsDebug() { return fVerbose >= kDebug; }
+	/// whether Debug() and Pause() wait for ENTER, default: false
+	static void SetPause(bool opt = true){ fIsPause = opt; }
+	/// whether Error() and Warn() wait for an answer on stdin, default: false,
+	/// for batch and MPI runs, where nobody is there to answer
+	static void SetInteractive(bool opt = true){ fIsInteractive = opt; }
+	static bool IsInteractive(){ return fIsInteractive; }
 protected:
-	static bool fIsSilent; ///< to switch Info() method
-	static bool fIsDebug; ///< to switch Debug() method
+	static int fVerbose; ///< to switch Info() and Debug() methods
+	static bool fIsPause; ///< to switch Pause() method
+	static bool fIsInteractive; ///< to switch the prompts of Error() and Warn()
 };
 
+/// whether messages of level lv are both compiled in and switched on
+#define TALOG_ON(lv) (SUNNY_LOG_LEVEL >= TAException::lv && \
+	TAException::GetVerbose() >= TAException::lv)
+/// the arguments are not evaluated unless the level is on
+#define TAINFO(...) do{ if(TALOG_ON(kInfo)) TAException::Info(__VA_ARGS__); }while(0)
+#define TADEBUG(...) do{ if(TALOG_ON(kDebug)) TAException::Debug(__VA_ARGS__); }while(0)
+/// execute statements, e.g. dumps of a whole matrix, in debug mode only
+#define TADEBUG_DO(...) do{ if(TALOG_ON(kDebug)){ __VA_ARGS__; } }while(0)
+
+/// the element access policy: with SUNNY_CHECKED (the default of debug builds)
+/// an index out of range is reported through TAException::Error(); otherwise
+/// it is a mere assert(), gone with NDEBUG, so that element access in the hot
+/// loops compiles down to plain loads
+#ifdef SUNNY_CHECKED
+#define TACHECK(cond, ...) \
+	do{ if(!(cond)) TAException::Error(__VA_ARGS__); }while(0)
+#else
+#define TACHECK(cond, ...) assert(cond)
+#endif
+
 #endif
@@ -18,30 +18,81 @@
 #define _TAHamiltonian_h_
 
 #include <string>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
 #include "TAMatrix.h"
+#include "TAOperator.h"
 
 class TAManyBodySDList;
+class TAJumpTable;
 
 using std::string;
+using std::list;
+using std::shared_ptr;
+using std::unordered_map;
 
-class TAHamiltonian{
+class TAHamiltonian : public TAOperator{
 public:
+  /// a row of H with only the non-zero elements, col ascending
+  struct TARow{
+    vector<int> col;
+    vector<double> val;
+    double operator()(int cc) const; ///< \retval <row|H|cc>, by bisection
+  };
+
   virtual ~TAHamiltonian();
   static TAHamiltonian *Instance();
   /// \retval return the specific formula of the hamiltonian
   const char *Formula() const{ return fFormula.c_str(); }
   /// \retval calculate and return the matrix form of the hamiltonian
   TAMatrix2D &Matrix();
+  /// \NOTE this builds the whole dense matrix, use Row() for a few rows
   vec_t<double> &operator[](int i){ return Matrix()[i]; }
+  /// \retval <rr|H|cc>, calculated on the fly without touching fMatrix
+  double Element(int rr, int cc);
+  TAManyBodySDList *GetMBSDListM() const{ return fMBSDListM; }
+  virtual int GetNBasis() const override{ return fNMBSD; }
+  /// w[i-r0] = sum_j <i|H|j>*v[j], for rows i in [r0, r1). Taken from fMatrix
+  /// if it has been built, or else from the sparse rows of SparseRow(),
+  /// generated on the spot, past the cache of Row()
+  virtual void Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1) override;
+  /// the same for k vectors interleaved, each element, stored or calculated
+  /// on the fly, taken once for them all
+  virtual void MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1) override;
+  /// the non-zero elements of row rr, <rr|H|cols[k]> = vals[k], cols ascending
+  void SparseRow(int rr, vector<int> &cols, vector<double> &vals);
+  /// the same by the 1N, 2N and 3N parts of H, on the pattern of their sum:
+  /// <rr|H_kN|cols[j]> = vals[k-1][j]
+  void ComponentRow(int rr, vector<int> &cols, vector<double> vals[3]);
+  /// \retval row rr, computed on first demand and kept in an LRU cache. The
+  /// row stays valid as long as the returned pointer is held, even if evicted
+  shared_ptr<const TARow> Row(int rr);
+  /// rows [r0, r1) in rows[0, r1-r0), through the same cache as Row()
+  void Rows(int r0, int r1, vector<shared_ptr<const TARow> > &rows);
+  /// \param nnz: maximum number of matrix elements cached, 0 to disable the
+  /// cache; default: 1<<22
+  void SetRowCacheSize(long nnz);
+  void ClearRowCache();
 
   void SetCoe1N(const TAMatrix2D &coe1N);
   void SetCoe2N(const TAMatrix4D &coe2N);
   void SetCoe3N(const TAMatrix6D &coe3N);
   void SetMBSDListM(TAManyBodySDList *mbsd);
+  /// \param table: the jumps of fMBSDListM. If set, Matrix() and Multiply() are
+  /// gathered from it for a 1+2-body H, instead of operating on the SDs. The
+  /// table is not owned, and may be shared by any number of interactions
+  void SetJumpTable(TAJumpTable *table);
 
   /// the coefficients of 1, 2 and 3-body force are all set to 1 //
   /// so that this class could undergo a debugging test //
-  void InitializeCoefficient();
+  /// \param has3N: false to leave the 3-body force out, whose coefficients
+  /// take O(nSP^6) memory
+  void InitializeCoefficient(bool has3N = true);
 
 private:
   /// the constructor, made private to be identified as a singleton class
@@ -54,6 +105,15 @@ private:
   double MatrixElement2N(int row, int column);
   /// \retval calculate and return the 3-body part v(r1,r2,r3) of the ME for H
   double MatrixElement3N(int row, int column);
+  /// the k+1-body terms of H as operator strings for TAManyBodySDList::Apply
+  void BuildOpString();
+  void ClearOpString(); ///< to be called once the coefficients or basis change
+  /// \retval <rr|H_k|cc> of the k+1-body part H_k of H, from the row rr of H_k
+  /// calculated as a whole and kept, by each thread apart, until another row
+  /// is asked for on the thread
+  double PartElement(int k, int rr, int cc);
+  /// \retval fJumpTable if it is set and applicable, with the coefficients
+  TAJumpTable *JumpTable();
 
   static TAHamiltonian *kInstance;
   /// \NOTE note that all these coeffiicients are supoosed to be user input
@@ -65,6 +125,22 @@ private:
   TAMatrix2D *fMatrix; ///< the hamiltonian matrix in fMBSDListM basis
   int fNSPState; ///< number of single particle states
   int fNMBSD; ///< number of many-body Slater determinants in fMBSDListM
+  /// the LRU row cache: the most recently used rows at the front //
+  list<int> fRowLRU;
+  unordered_map<int, std::pair<shared_ptr<const TARow>, list<int>::iterator> >
+    fRowCache;
+  long fRowCacheSize; ///< maximum number of matrix elements in fRowCache
+  long fRowCacheNNZ; ///< number of matrix elements in fRowCache
+  std::mutex fRowMutex; ///< guards fRowLRU, fRowCache and fRowCacheNNZ
+  /// the 1N (k=0), 2N (k=1) and 3N (k=2) terms of H: the adjoints O^+ of the
+  /// operator strings O, as <rr|O|cc> = <cc|O^+|rr>, and their coefficients //
+  std::atomic<bool> fOpReady; ///< whether fOp and fOpCoe are up to date
+  std::mutex fOpMutex; ///< for the threads calling BuildOpString at once
+  long fOpVersion; ///< bumped with every change of the coefficients or basis
+  vector<int> fOp[3];
+  vector<double> fOpCoe[3];
+  TAJumpTable *fJumpTable; ///< the jumps of fMBSDListM, if set
+  bool fJumpReady; ///< whether fJumpTable has the current coefficients
   string fFormula;
 };
 
@@ -0,0 +1,77 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAJumpTable.h
+  \class TAJumpTable
+  \brief The one- and two-body jumps of a many-body basis, i.e. all the non-
+  zero a+_p*a_q|j> = phase*|i> and a+_p*a+_q*a_s*a_r|j> = phase*|i> (p<q, r<s),
+  grouped by the orbitals (p,q) and (p,q,r,s). They depend on the basis only,
+  so are computed once, and may be saved to a file, to serve any number of
+  interactions: given the coefficients of H, each group gets one weight, and
+  H*v is a gather-and-multiply over the table with no bit operation at all.
+  This is an operator of the 1+2-body H, to be used e.g. in interaction fits.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAJumpTable_h_
+#define _TAJumpTable_h_
+
+#include <string>
+#include "TAOperator.h"
+#include "TAMatrix.h"
+
+using std::string;
+
+class TAManyBodySDList;
+
+class TAJumpTable : public TAOperator{
+public:
+  TAJumpTable();
+  virtual ~TAJumpTable();
+
+  /// compute the jumps within list, the SP states taken from
+  /// TASingleParticleStateManager
+  void Build(const TAManyBodySDList *list);
+  /// save the table to file
+  void Write(const string &file) const;
+  /// load the table from file, which must have been built on the same basis
+  /// as list. \retval false if file cannot be opened
+  bool Read(const string &file, const TAManyBodySDList *list);
+
+  /// assign the interaction: the weight of each group from the coefficients
+  /// of H, <p|t+u|q> and the <pq|v|rs> of TAHamiltonian. \param coe2N: nullptr
+  /// for a 1-body H
+  void SetCoefficient(const TAMatrix2D &coe1N, const TAMatrix4D *coe2N);
+  virtual int GetNBasis() const override{ return fNBasis; }
+  /// w[i-r0] = sum_j <i|H|j>*v[j], for rows i in [r0, r1)
+  virtual void Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1) override;
+  /// the same for k vectors interleaved, the table swept once for them all
+  virtual void MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1) override;
+  /// h = the dense matrix of H
+  void Matrix(TAMatrix2D &h) const;
+
+  /// \param k: 0 for the 1-body jumps and 1 for the 2-body ones
+  long GetNJump(int k) const{ return fTarget[k].size(); }
+  long GetNGroup(int k) const{ return fOffset[k].size() - 1; }
+  long GetBytes() const; ///< \retval memory taken by the jumps
+  /// \retval a fingerprint of the basis, to check the tables read in, and the
+  /// checkpoints (TACheckpoint)
+  static unsigned long Fingerprint(const TAManyBodySDList *list);
+
+private:
+  int fNSPState;
+  int fNBasis;
+  unsigned long fFingerprint; ///< that of the basis the jumps are built on
+  /// k=0: 1-body jumps, grouped by (p,q); k=1: 2-body jumps, by (p,q,r,s) //
+  vector<int> fOrbit[2]; ///< the 2(k+1) orbitals of each group
+  vector<long> fOffset[2]; ///< group g is [fOffset[g], fOffset[g+1])
+  vector<int> fTarget[2]; ///< the target states, ascending in each group
+  vector<int> fSource[2]; ///< the source states
+  vector<signed char> fPhase[2];
+  vector<double> fWeight[2]; ///< the weight of each group from SetCoefficient
+};
+
+#endif
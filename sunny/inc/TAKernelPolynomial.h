@@ -0,0 +1,69 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAKernelPolynomial.h
+  \class TAKernelPolynomial
+  \brief The many-body level density rho(E) = sum_k delta(E-E_k) of an M block
+  by the kernel polynomial method, using only the products H*v of a TAOperator,
+  whichever backend it is. H is mapped onto [-1, 1] by its spectral bounds, and
+  the Chebyshev moments mu_n = Tr T_n(H) are estimated stochastically by
+  <r|T_n(H)|r> over random vectors r of entries +-1. rho(E) is resummed from
+  the moments with the Jackson kernel, and its error bar comes from the spread
+  over the random vectors. The vectors are either distributed over the MPI
+  ranks by rows, as in TALanczos, or, with SetVectorParallel(), dealt out
+  whole to the ranks, which then need the operator on all the rows, e.g. the
+  matrix-free TAHamiltonian. Either way the result doesn't depend on the number
+  of ranks.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAKernelPolynomial_h_
+#define _TAKernelPolynomial_h_
+
+#include <vector>
+
+using std::vector;
+
+class TAOperator;
+
+class TAKernelPolynomial{
+public:
+  /// \param op: H, default: TAHamiltonian
+  TAKernelPolynomial(TAOperator *op = nullptr);
+  virtual ~TAKernelPolynomial(){}
+
+  void SetNMoment(int n){ fNMoment = n; } ///< the Chebyshev order, default 200
+  void SetNVector(int n){ fNVector = n; } ///< random vectors, default 20
+  void SetSeed(unsigned long seed){ fSeed = seed; }
+  /// the spectral bounds of H. If not set, they are estimated by a short run
+  /// of TALanczos::Strength, with fOperator assigned to TALanczos
+  void SetBounds(double eMin, double eMax);
+  /// \param opt: each rank takes whole random vectors, instead of its rows
+  /// of all of them
+  void SetVectorParallel(bool opt = true){ fVectorParallel = opt; }
+
+  void Go(); ///< compute the moments
+  double GetEMin() const{ return fEMin; }
+  double GetEMax() const{ return fEMax; }
+  /// \retval rho(E), states per unit energy, and err its statistical error
+  double Density(double e, double &err) const;
+  /// \retval the moments mu_n averaged over the random vectors
+  const vector<double> &GetMoment() const{ return fMu; }
+
+protected:
+  /// r = the random vector i, rows [r0, r1)
+  void RandomVector(int i, int r0, int r1, vector<double> &r) const;
+
+  TAOperator *fOperator;
+  int fNMoment, fNVector;
+  unsigned long fSeed;
+  bool fBounds; ///< whether the bounds are set
+  bool fVectorParallel;
+  double fEMin, fEMax;
+  vector<vector<double> > fMoment; ///< the moments of each random vector
+  vector<double> fMu; ///< and their average
+  vector<double> fKernel; ///< the Jackson kernel g_n
+};
+
+#endif
@@ -0,0 +1,107 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TALanczos.h
+  \class TALanczos
+  \brief The Lanczos method for the lowest eigenpairs of a symmetric operator,
+  with full reorthogonalization. Only the products O*v are needed, so O needn't
+  be stored. The Lanczos vectors are distributed over the MPI ranks as local
+  segments (see TAMPI): each rank multiplies its own block of rows, and the
+  segments are joined by an allgather before every O*v, while the scalar
+  products go through allreduce. Runs serially if built without SUNNY_MPI.
+  Strength() runs the plain three-term recurrence instead, from v = O|psi>,
+  for the distribution of |<k|O|psi>|^2 over the eigenstates k of H, out of
+  the tridiagonal coefficients only, with no eigenvector.
+  With SetCheckpoint(), Go() saves the Lanczos vectors and T to a file now and
+  then, in the background, and a rerun resumes from there.
+  This is a singleton class.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TALanczos_h_
+#define _TALanczos_h_
+
+#include <vector>
+#include <string>
+
+using std::vector;
+using std::string;
+
+class TAOperator;
+
+class TALanczos{
+public:
+  virtual ~TALanczos();
+  static TALanczos *Instance();
+
+  void Go(); ///< run the Lanczos iterations
+  /// run nStep Lanczos iterations from v, the local segment of O|psi>, with
+  /// three vectors in memory and no reorthogonalization. The ghost copies of
+  /// the converged states, if any, share the strength of the true ones
+  void Strength(const vector<double> &v, int nStep);
+
+  /// \param op: the operator to diagonalize, default: TAHamiltonian
+  void SetOperator(TAOperator *op){ fOperator = op; }
+  /// \param op: if set, the converged eigenpairs are refined by a Rayleigh-Ritz
+  /// step with op, e.g. the double-precision H behind a float fOperator
+  void SetRefineOperator(TAOperator *op){ fRefine = op; }
+  /// \param n: number of the lowest eigenpairs wanted
+  void SetNEigen(int n){ fNEigen = n; }
+  void SetMaxIteration(int n){ fMaxIteration = n; }
+  /// \param tol: converged once the residual |O*x-E*x| < tol*max(1,|E|)
+  void SetTolerance(double tol){ fTolerance = tol; }
+  /// \param opt: start from the sum of the eigenvectors of the last Go(), if
+  /// any, e.g. for a scan of H over a parameter, where they change little
+  /// from a point to the next
+  void SetWarmStart(bool opt = true){ fWarmStart = opt; }
+  /// \param file: save the Lanczos vectors and T of Go() to file (see
+  /// TACheckpoint) every interval iterations, written while iterating on. Go()
+  /// resumes from file instead of starting anew, if it holds a run on the same
+  /// basis, which has to be of the same operator. "" for no checkpoint
+  void SetCheckpoint(const string &file, int interval = 20){
+    fCheckpoint = file; fCheckpointInterval = interval;
+  }
+  int GetNIteration() const{ return fNIteration; }
+  /// \retval the number of eigenpairs found, fewer than nEigen if the Krylov
+  /// space is exhausted first
+  int GetNEigen() const{ return fEnergy.size(); }
+  double GetEnergy(int i = 0) const;
+  /// \retval the local segment of the i-th eigenvector, rows [r0, r1) of
+  /// TAMPI::Partition
+  const vector<double> &GetVector(int i = 0) const;
+  /// the Gauss quadrature of the strength of the last Strength(): the energies
+  /// e, eigenvalues of T, ascending, and the strengths s = |v|^2*z_0k^2, which
+  /// reproduce the first 2*nStep moments of the true distribution
+  void GetStrength(vector<double> &e, vector<double> &s) const;
+  /// \retval S(E) = -Im <v|1/(E+i*eta-H)|v> / pi, i.e. the strength folded
+  /// with a Lorentzian of half width eta, by the continued fraction of T
+  double StrengthFunction(double e, double eta) const;
+  double GetTotalStrength() const{ return fStrength0; } ///< \retval |v|^2
+
+private:
+  TALanczos();
+  /// O*q for the local rows, q being the local segment
+  void Multiply(const vector<double> &q, vector<double> &w);
+  /// Rayleigh-Ritz with fRefine in the space of the eigenvectors
+  void Refine();
+
+  static TALanczos *kInstance;
+  TAOperator *fOperator;
+  TAOperator *fRefine; ///< the operator for the final refinement
+  int fNEigen; ///< number of the lowest eigenpairs wanted
+  int fMaxIteration; ///< maximum dimension of the Krylov space
+  double fTolerance; ///< relative tolerance on the residuals
+  bool fWarmStart; ///< whether to start from the former eigenvectors
+  string fCheckpoint; ///< the checkpoint file, "" for none
+  int fCheckpointInterval; ///< iterations between two checkpoints
+  int fNIteration; ///< dimension of the Krylov space upon convergence
+  int fR0, fR1; ///< the local rows [fR0, fR1)
+  vector<double> fFull; ///< buffer for the whole vector gathered
+  vector<double> fEnergy; ///< the eigenvalues, in ascending order
+  vector<vector<double> > fVector; ///< local segments of the eigenvectors
+  double fStrength0; ///< |v|^2 of the last Strength()
+  vector<double> fAlpha, fBeta; ///< and the diagonal and subdiagonal of T
+};
+
+#endif
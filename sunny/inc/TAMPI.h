@@ -0,0 +1,56 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAMPI.h
+  \class TAMPI
+  \brief A thin wrapper of the MPI calls used by the distributed eigensolvers.
+  The basis index range is cut into Size() contiguous blocks, one per rank, and
+  the vectors are stored as the local segments. Compiled without SUNNY_MPI
+  (cmake -DSUNNY_MPI=ON), it degenerates to a single rank holding everything,
+  so the callers need no #ifdef of their own.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAMPI_h_
+#define _TAMPI_h_
+
+#include <vector>
+
+using std::vector;
+
+class TAMPI{
+public:
+  /// to be called at the beginning of main(). Ranks other than 0 are silenced
+  static void Init(int *argc, char ***argv);
+  /// to be called at the end of main()
+  static void Finalize();
+  static int Rank(){ return kRank; }
+  static int Size(){ return kSize; }
+  static bool IsRoot(){ return 0 == kRank; }
+
+  /// the block [r0, r1) of [0, n) owned by rank
+  static void Partition(int n, int rank, int &r0, int &r1);
+  /// the block [r0, r1) of [0, n) owned by this rank
+  static void Partition(int n, int &r0, int &r1){ Partition(n, kRank, r0, r1); }
+  /// \retval sum of x over all ranks
+  static double Sum(double x);
+  /// element-wise sum of x over all ranks, in place
+  static void Sum(vector<double> &x);
+  /// \retval the dot product of two distributed vectors, given the local segments
+  static double Dot(const vector<double> &a, const vector<double> &b);
+  /// collect the local segments of all ranks into the whole vector of length n
+  /// \param k: for k vectors interleaved, k values per row
+  static void AllGather(const vector<double> &local, vector<double> &global,
+    int n, int k = 1);
+  static void Barrier();
+  /// the local segment [r0, r1) of the j-th starting vector of the iterative
+  /// solvers, a function of the global index only, so that their results are
+  /// independent of the number of ranks
+  static void StartVector(int r0, int r1, int j, double *x);
+
+private:
+  static int kRank, kSize;
+};
+
+#endif
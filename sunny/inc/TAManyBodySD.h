@@ -21,7 +21,10 @@ class TAManyBodySDManager;
 
 class TAManyBodySD{
 public:
-	TAManyBodySD(int index, int nParticle, int *SPState);
+	/// \param arr: storage of nParticle ints for fSPStateArr owned by the caller,
+	/// e.g. carved from the TAArena of TAManyBodySDManager. If nullptr, the SD
+	/// allocates and owns its own array
+	TAManyBodySD(int index, int nParticle, int *SPState, int *arr = nullptr);
 	virtual ~TAManyBodySD();
 	short Get2M() const{ return f2M; } ///< \retval the total jz*2
 	TASingleParticleState *operator[](int i);
@@ -43,6 +46,7 @@ protected:
 	TABit fBit; // bit representation of this, can hold 128 SP states
 	/// Dynamically memory allocation. The length is the number of particles
 	int *fSPStateArr;
+	bool fOwnSPStateArr; ///< whether fSPStateArr is to be deleted by this
 };
 
 #endif
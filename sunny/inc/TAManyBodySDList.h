@@ -4,7 +4,8 @@
 	\class TAManyBodySDList
 	\brief A list to store many-body Slater determinants, classified by M, which is
 	the 3rd component jz of the total angular momentum. So M is the same for each
-	member of this list.
+	member of this list. The SDs are in the order they are generated, i.e. the
+	lexicographic order of their occupied SP states, unless Reorder()-ed.
 	\author SUN Yazhou
 	\date Created: 2020/01/31
 	\date Last modified: 2020/02/11 by SUN Yazhou
@@ -16,13 +17,24 @@
 #define _TAManyBodySDList_h_
 
 #include <vector>
+#include <unordered_map>
+#include "TAException.h"
+#include "TABit.h"
 
 class TAManyBodySD;
 
 using std::vector;
+using std::unordered_map;
 
 class TAManyBodySDList{
 public:
+	/// orders of the SDs, see Reorder()
+	enum EOrder{
+		kLexicographic, ///< as generated, by the occupied SP states
+		kRCM, ///< reverse Cuthill-McKee on the coupling graph of a 2-body H
+		kConfiguration ///< grouped by the occupations of the (n,l,j) orbitals
+	};
+
 	TAManyBodySDList(short twoM);
 	virtual ~TAManyBodySDList();
 
@@ -32,7 +44,19 @@ public:
 	void Print() const;
 	void PrintInBit() const; ///< Print all the mbsd-s in bit mode
 	int GetNBasis() const{ return fManyBodySDVec.size(); }
-	TAManyBodySD *operator[](int i) const; ///< return fManyBodySDVec[i]
+	/// return fManyBodySDVec[i], range-checked by the TACHECK policy only
+	TAManyBodySD *operator[](int i) const{
+		TACHECK(i >= 0 && i < int(fManyBodySDVec.size()), "TAManyBodySDList",
+			"operator[]: index i: %d out of range.", i);
+		return fManyBodySDVec[i];
+	}
+	/// for bulk traversal
+	vector<TAManyBodySD *>::const_iterator begin() const{
+		return fManyBodySDVec.begin();
+	}
+	vector<TAManyBodySD *>::const_iterator end() const{
+		return fManyBodySDVec.end();
+	}
 
 	/// \retval <rr|a+_p * a_q|cc>
 	int Integral(int rr, int p, int q, int cc) const;
@@ -41,9 +65,60 @@ public:
 	/// \retval <rr|a+_p*a+_q*a+_r * a_s*a_t*a_u|cc>
 	int Integral(int rr, int p, int q, int r, int s, int t, int u, int cc) const;
 
+	/// \retval index of the SD with the occupation of bit, -1 if not in the list
+	int Find(const TABit &bit) const;
+	/// Put the SDs in order, e.g. for the locality of H*v: the lexicographic
+	/// order scatters the non-zeros of each row of H over the whole basis, while
+	/// kRCM gathers them close to the diagonal, and kConfiguration into blocks
+	/// of configurations, in each of which the former order is kept. The
+	/// permutation is recorded, see GetOriginalIndex(). To be called before any
+	/// index into the list is taken, i.e. before H or its vectors are made
+	void Reorder(EOrder order);
+	/// \retval the index of the i-th SD in the order as generated
+	int GetOriginalIndex(int i) const{
+		return fOriginal.empty() ? i : fOriginal[i];
+	}
+	/// y[GetOriginalIndex(i)] = x[i], e.g. a whole eigenvector back to the order
+	/// as generated
+	void ToOriginalOrder(const vector<double> &x, vector<double> &y) const;
+	/// the SDs coupled to SD i by an operator of rank nDiff or lower conserving M,
+	/// i.e. those differing from it by at most nDiff SP states, i included, in
+	/// ascending order: the pattern of row i of H, without a scan over the basis
+	void Coupled(int i, int nDiff, vector<int> &cols) const;
+	/// the SDs coupled to each SD by a 1-body or a 2-body operator conserving M,
+	/// i.e. those differing by at most two SP states: adj[off[i], off[i+1])
+	void CouplingGraph(vector<long> &off, vector<int> &adj) const;
+	/// The batch form of Integral. An operator string of rank k is 2k ints
+	/// {p1..pk, q1..qk} for a+_p1..a+_pk * a_q1..a_qk, in the argument order of
+	/// Integral, k <= kMaxRank. The i-th string O_i of ops[2k*i, 2k*(i+1))
+	/// takes |cc> to phase[i]*|target[i]>, so that <rr|O_i|cc> = phase[i] if rr
+	/// is target[i], and 0 otherwise. phase[i] = 0 and target[i] = -1 if O_i|cc>
+	/// vanishes or is out of the list. The partial products are kept, so that
+	/// strings sharing their last annihilators with the previous one resume
+	/// from there: order ops with the annihilators varying slowest. The
+	/// targets are looked for in list to, this one by default, e.g. another M
+	/// block for operators changing M.
+	void Apply(int cc, int rank, const int *ops, int nOp, int *phase,
+		int *target, const TAManyBodySDList *to = nullptr) const;
+	/// the same for one operator string op and a block of kets
+	void Apply(const int *op, int rank, const int *kets, int nKet, int *phase,
+		int *target) const;
+	static const int kMaxRank = 3; ///< the maximum rank of the operator strings
+
 protected:
+	struct TABitHash{
+		size_t operator()(const TABit &b) const{ return b.Hash(); }
+	};
+	struct TABitEqual{
+		bool operator()(const TABit &a, const TABit &b) const{ return a.SameBit(b); }
+	};
+
 	short f2M; ///< the uniform M*2 for this list
 	vector<TAManyBodySD *> fManyBodySDVec;
+	/// the SD bits to their indices, for Find
+	unordered_map<TABit, int, TABitHash, TABitEqual> fIndexMap;
+	/// the indices of the SDs in the order as generated, empty if not reordered
+	vector<int> fOriginal;
 };
 
 #endif
@@ -13,9 +13,15 @@
 
 #include <vector>
 #include <list>
+#include <map>
+#include <string>
+#include "TAArena.h"
+#include "TAManyBodySDList.h"
 
 using std::vector;
 using std::list;
+using std::string;
+using std::map;
 
 class TAManyBodySD;
 class TAManyBodySDList;
@@ -27,13 +33,31 @@ public:
   void GenerateManyBodySD();
   void MSchemeGo(); ///< generate the M-scheme many-body state basis
   TAManyBodySDList *GetMBSDListM();
+  /// \retval the M-scheme basis of 2M = twoM, made on first demand, e.g. for
+  /// the transitions between M blocks. Empty if no SD has twoM
+  TAManyBodySDList *GetMBSDList(short twoM);
+  /// user input, to be set before the basis generation
+  /// defaults: sp.txt, 3 particles and 2M = 1
+  void SetSPFile(const string &file){ fSPFile = file; }
+  void SetNParticle(short n){ fNParticle = n; }
+  void Set2M(short twoM){ f2M = twoM; }
+  /// the order of the SDs in the M-scheme lists, see TAManyBodySDList::Reorder
+  /// default: kLexicographic, i.e. as generated
+  void SetOrder(TAManyBodySDList::EOrder order){ fOrder = order; }
 
 protected:
   TAManyBodySDManager();
 
   static TAManyBodySDManager *kInstance;
+  string fSPFile; ///< the single particle state input file
+  short fNParticle; ///< number of particles
+  short f2M; ///< 2M of the M-scheme basis
+  TAManyBodySDList::EOrder fOrder; ///< the order of the SDs in the lists
   vector<TAManyBodySD *> fManyBodySDVec; ///< the total MBSDs
+  /// where the MBSDs and their SP state arrays are placed, in one go
+  TAArena fArena;
   TAManyBodySDList *fManyBodySDListM; ///< M-scheme many-body basis
+  map<short, TAManyBodySDList *> fMBSDListMap; ///< the other M blocks
 };
 
 #endif
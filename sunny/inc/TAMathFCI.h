@@ -13,8 +13,11 @@
 #ifndef _TAMathFCI_h_
 #define _TAMathFCI_h_
 
+#include <vector>
 #include "TAMatrix.h"
 
+using std::vector;
+
 class TABit;
 
 class TAMathFCI{
@@ -36,18 +39,43 @@ public:
   /// \return n!
   static int Factorial(int n);
 
+  //////////// angular momentum algebra, in doubled arguments ///////////////
+  /// \retval the Wigner 3j symbol (j1 j2 j3; m1 m2 m3), e.g. ThreeJ(1, 1, 2,
+  /// 1, -1, 0) for (1/2 1/2 1; 1/2 -1/2 0)
+  static double ThreeJ(int tj1, int tj2, int tj3, int tm1, int tm2, int tm3);
+  /// \retval the Wigner 6j symbol {j1 j2 j3; j4 j5 j6}
+  static double SixJ(int tj1, int tj2, int tj3, int tj4, int tj5, int tj6);
+
   //////////// linear algebra operations ///////////////////
   /// solve dominant eigenvalue using power method \retval dominant eigenvalue
   /// \param v the initial vector, and would converge to the eigenvector
   static double EigenPower(const TAMatrix2D &ma, TAMatrix2D &v);
 
-  /// Gram-Schmidt orthogonalization of A. A must be nonsingular
+  /// Gram-Schmidt orthogonalization of A. The columns of A linearly dependent
+  /// on the former ones are reported and left zero in Q
   /// \retval Q  the resulting orthogonal matrix
   /// \param norm  whether to normalize the orthogonalized vector
   static void GramSchmidt(const TAMatrix2D &A, TAMatrix2D &Q);
-  /// implement QR factorization: A=QR. A must be nonsingular
-  /// Q is orthogonal, and R is uppper triangular
+  /// implement QR factorization: A=QR, by HouseholderQR. A is nr x nc, with
+  /// nr >= nc; Q (nr x nc) has orthonormal columns, and R (nc x nc) is upper
+  /// triangular with non-negative diagonal
   static void QR(const TAMatrix2D &A, TAMatrix2D &Q, TAMatrix2D &R);
+  /// blocked Householder QR of the column-major m x n a, in place as LAPACK
+  /// dgeqrf: R in the upper triangle, the Householder vectors below it, and
+  /// their factors in tau[min(m,n)]. The reflectors of nb columns are applied
+  /// to the rest at once as I-V*T*V^T, two sweeps over each column
+  static void HouseholderQR(double *a, long m, int n, double *tau,
+    int nb = 32);
+  /// overwrite the first n columns of a, as out of HouseholderQR, with the
+  /// explicit Q. n <= min(m, the columns factorized)
+  static void HouseholderQ(double *a, long m, int n, const double *tau,
+    int nb = 32);
+  /// tall-skinny QR of the block of k long vectors distributed over the MPI
+  /// ranks: x (column-major, nl local rows, column j at x+j*nl) is replaced
+  /// by the orthonormal Q, and R (k x k, the same on all the ranks) is upper
+  /// triangular with non-negative diagonal. The local blocks are factorized
+  /// by HouseholderQR, and only their k x k R go through allreduce
+  static void TSQR(double *x, long nl, int k, TAMatrix2D &R);
   /// solve all the eigenvalues of a matrix using QR method
   /// \param v: to store all the eigenvalues
   static void EigenQR(const TAMatrix2D &A, TAMatrix2D &v);
@@ -56,6 +84,21 @@ public:
   /// \param P: column vectors represent eigenvector
   /// \param v: stores eigenvalues corresponding to the eigenvectors in P
   static void EigenJacobi(const TAMatrix2D &A, TAMatrix2D &P, TAMatrix2D &v);
+  /// solve all the eigenvalues and eigenvectors of a symmetric A using
+  /// Householder tridiagonalization followed by the implicit QL method
+  /// \param P: column vectors represent eigenvector
+  /// \param v: eigenvalues in ascending order, corresponding to columns in P
+  static void EigenHouseholder(const TAMatrix2D &A, TAMatrix2D &P,
+    TAMatrix2D &v);
+  /// solve a symmetric tridiagonal matrix using the implicit QL method
+  /// \param d: the diagonal, overwritten by eigenvalues in ascending order
+  /// \param e: the subdiagonal, e[i] couples i and i+1; destroyed on output
+  /// \param z: if not null, should be the transformation matrix (unit matrix
+  /// for a bare tridiagonal one) upon input; its columns are then rotated into
+  /// the eigenvectors, in the same order as d. Any number of its rows may be
+  /// given, e.g. the last row of the unit matrix for the last components only
+  static void EigenTridiagonal(vector<double> &d, vector<double> &e,
+    TAMatrix2D *z = nullptr);
 };
 
 #endif
@@ -15,6 +15,7 @@
 #define _TAMatrix_h_
 
 #include <vector>
+#include <complex>
 #include <iostream>
 #include <initializer_list>
 
@@ -70,6 +71,12 @@ public:
   const vec_t<T> &rv(int r) const{ return (*this)[r]; } ///< const version
   vec_t<T> &cv(int c); ///< col vector i
   const vec_t<T> &cv(int c) const; ///< const version
+  /// raw access for bulk traversal, the elements being stored row by row:
+  /// data()[i*ncol()+j] = (*this)[i][j]
+  T *data(){ return fData; }
+  const T *data() const{ return fData; }
+  T *RowData(int r){ return fData + long(r)*fNColumn; } ///< &(*this)[r][0]
+  const T *RowData(int r) const{ return fData + long(r)*fNColumn; }
 
 	int GetNRow() const{ return nrow(); }
 	int GetNColumn() const{ return ncol(); }
@@ -94,6 +101,7 @@ private:
 typedef TAMatrix<double> TAMatrix2D;
 typedef TAMatrix<TAMatrix2D> TAMatrix4D; /// 4-th order tensor
 typedef TAMatrix<TAMatrix4D> TAMatrix6D; /// 6-th order tensor
+typedef TAMatrix<std::complex<double> > TAMatrixC; /// complex matrix
 
 #include "TAMatrix.hpp" // the definition of template class TAMatri
 
@@ -179,36 +179,28 @@ TAMatrix<T> &TAMatrix<T>::operator=(double b){
 
 template<class T>
 vec_t<T> &TAMatrix<T>::operator[](int r){
-  if(r < 0 || r >= fNRow){
-    TAException::Error("TAMatrix<T>",
-      "operator[]: Input row %d out of range, max: %d", r, fRowVEC.size()-1);
-  }
+  TACHECK(r >= 0 && r < fNRow, "TAMatrix<T>",
+    "operator[]: Input row %d out of range, max: %d", r, fNRow-1);
   return *fRowVEC[r];
 } // end of member function operator[]
 template<class T>
 const vec_t<T> &TAMatrix<T>::operator[](int r) const{
   // XXX: return (*this)[row]; WRONG: const function won't call non-const ones
-  if(r < 0 || r >= fNRow){
-    TAException::Error("TAMatrix<T>",
-      "operator[]: Input row %d out of range, max: %d", r, fRowVEC.size()-1);
-  }
+  TACHECK(r >= 0 && r < fNRow, "TAMatrix<T>",
+    "operator[]: Input row %d out of range, max: %d", r, fNRow-1);
   return *fRowVEC[r];
 } // end of member function operator[]
 template<class T>
 vec_t<T> &TAMatrix<T>::cv(int c){
-  if(c < 0 || c >= fNColumn){
-    TAException::Error("TAMatrix<T>",
-      "cv: Input column %d out of range, max: %d", c, fColVEC.size()-1);
-  }
+  TACHECK(c >= 0 && c < fNColumn, "TAMatrix<T>",
+    "cv: Input column %d out of range, max: %d", c, fNColumn-1);
   return *fColVEC[c];
 } // end of member function operator[]
 template<class T>
 const vec_t<T> &TAMatrix<T>::cv(int c) const{
   // XXX: return (*this)[row]; WRONG: const function won't call non-const ones
-  if(c < 0 || c >= fNColumn){
-    TAException::Error("TAMatrix<T>",
-      "cv: Input column %d out of range, max: %d", c, fColVEC.size()-1);
-  }
+  TACHECK(c >= 0 && c < fNColumn, "TAMatrix<T>",
+    "cv: Input column %d out of range, max: %d", c, fNColumn-1);
   return *fColVEC[c];
 } // end of member function operator[]
 
@@ -285,13 +277,16 @@ Matrix size mismatch: fNColumn: %d, ma.fNRow: %d", fNColumn, ma.fNRow);
     TAException::Error("TAMatrix<T>", "operator*: Input matrix fData is NULL.");
   }
 
+  // over the raw rows, in i-k-j order for contiguous access to ma and ma_t
   TAMatrix<T> ma_t(fNRow, ma.fNColumn);
+  const int nc = ma.fNColumn;
   for(int i = 0; i < fNRow; i++){
-    for(int j = 0; j < ma.fNColumn; j++){
-      double tmp = (rv(i) * ma.cv(j))[0];
-      ma_t[i][j] += tmp;
-      //this->rv(i) * ma.cv(j);
-    } // end for over columns
+    T *c = ma_t.RowData(i);
+    const T *a = RowData(i);
+    for(int k = 0; k < fNColumn; k++){
+      const T *b = ma.RowData(k);
+      for(int j = 0; j < nc; j++) c[j] += a[k]*b[j];
+    } // end for over k
   } // end for over rows
   return ma_t;
 } // end operator*(const TAMatrix<T> &)
@@ -326,9 +321,8 @@ template<class T>
 TAMatrix<T> TAMatrix<T>::Transpose() const{
   TAMatrix<T> ma_t(fNColumn, fNRow);
   for(int i = 0; i < fNRow; i++){
-    for(int j = 0; j < fNColumn; j++){
-      ma_t[i][j] = (*fColVEC[i])[j];
-    } // end for over columns
+    const T *a = RowData(i);
+    for(int j = 0; j < fNColumn; j++) ma_t.fData[j*fNRow+i] = a[j];
   } // end for over rows
   return ma_t;
 } // end of member function Transpose
@@ -373,7 +367,7 @@ bool TAMatrix<T>::IsSymmetric() const{
   if(!IsSquare()) return false;
   for(int i = 0; i < fNRow; i++){
     for(int j = 0; j < fNColumn; j++){
-      if(fabs((*fRowVEC[i])[j] - (*fColVEC[i])[j]) > 1E-6) return false;
+      if(std::abs((*fRowVEC[i])[j] - (*fColVEC[i])[j]) > 1E-6) return false;
     } // end for over j
   } // end for over i
   return true;
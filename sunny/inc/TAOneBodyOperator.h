@@ -0,0 +1,88 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAOneBodyOperator.h
+  \class TAOneBodyOperator
+  \brief The mu-th component of a one-body spherical tensor operator of rank
+  lambda, O = sum_pq <p|O|q> a+_p * a_q, e.g. the electromagnetic transition
+  operators. It is defined by the reduced matrix elements <a||O||b> between the
+  SP states, functions of their n, l and j, from which <p|O|q> follow by the
+  Wigner-Eckart theorem
+    <j m|O_mu|j' m'> = (-1)^(j-m) * (j lambda j'; -m mu m') * <j||O||j'>,
+  in Edmonds' convention, the SP states being |(l 1/2) j m>. O is applied to
+  the many-body states matrix-free with TAManyBodySDList::Apply, from one M
+  block to another if mu != 0. From <Jf Mf|O_mu|Ji Mi> the reduced matrix
+  element and B(lambda; Ji -> Jf) follow as well, J being identified by <J^2>.
+  The states are the local segments of TAMPI::Partition over their M blocks,
+  as out of TALanczos, so the strengths come in the process of the
+  diagonalization, with no vector dumps.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAOneBodyOperator_h_
+#define _TAOneBodyOperator_h_
+
+#include <vector>
+#include <functional>
+
+using std::vector;
+
+class TASingleParticleState;
+class TAManyBodySDList;
+
+class TAOneBodyOperator{
+public:
+  /// \retval <a||O||b>
+  typedef std::function<double(TASingleParticleState *a,
+    TASingleParticleState *b)> TAReduced;
+
+  /// \param lambda, mu: the rank and the component of O
+  /// \param reduced: the reduced matrix elements between the SP states
+  TAOneBodyOperator(int lambda, int mu, const TAReduced &reduced);
+  virtual ~TAOneBodyOperator(){}
+
+  /// e*r^lambda*Y_lambda, with the harmonic oscillator radial functions of
+  /// length b, positive at the origin. B(E2) in e^2*b^4 for b = 1 and e = 1
+  static TAReduced E(int lambda, double b = 1., double e = 1.);
+  /// sqrt(3/4pi)*(gl*l + gs*s), in nuclear magnetons. Defaults: free proton
+  static TAReduced M1(double gl = 1., double gs = 5.586);
+  /// the angular momentum j
+  static TAReduced J();
+
+  int GetLambda() const{ return fLambda; }
+  int GetMu() const{ return fMu; }
+  /// \retval <p|O|q>
+  double operator()(int p, int q) const;
+  /// y = O*x, x over the basis from, y over the basis to, which should be the
+  /// M block of 2M(from) + 2mu, both as local segments
+  void Multiply(const TAManyBodySDList *from, const vector<double> &x,
+    const TAManyBodySDList *to, vector<double> &y) const;
+  /// \retval <y|O|x>, x over the basis from, and y over to
+  double Element(const TAManyBodySDList *to, const vector<double> &y,
+    const TAManyBodySDList *from, const vector<double> &x) const;
+  /// \retval <Jf||O||Ji> from <Jf Mf|O|Ji Mi>, which is element, 2*M from
+  /// the M blocks. \param tJf, tJi: 2*Jf and 2*Ji
+  double Reduced(int tJf, const TAManyBodySDList *to, const vector<double> &y,
+    int tJi, const TAManyBodySDList *from, const vector<double> &x) const;
+  /// \retval B(lambda; Ji -> Jf) = |<Jf||O||Ji>|^2 / (2Ji+1), Ji and Jf of x
+  /// and y identified by AngularMomentum()
+  double B(const TAManyBodySDList *to, const vector<double> &y,
+    const TAManyBodySDList *from, const vector<double> &x) const;
+
+  /// \retval J of x over list, from <J^2> = 2|J_+1 x|^2 + M^2 + M. J is not
+  /// a good quantum number if H is not rotationally invariant, which is
+  /// reported, without stopping, if 2J is not close to an integer
+  static double AngularMomentum(const TAManyBodySDList *list,
+    const vector<double> &x);
+
+protected:
+  int fLambda, fMu;
+  int fNSPState;
+  vector<double> fME; ///< <p|O|q> at fME[p*fNSPState+q]
+  /// the (p,q) with <p|O|q> != 0, as the operator strings of Apply
+  vector<int> fOp;
+  vector<double> fOpCoe; ///< and their <p|O|q>
+};
+
+#endif
@@ -0,0 +1,53 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAOperator.h
+  \class TAOperator
+  \brief Abstract interface of a symmetric many-body operator in the M-scheme
+  basis, as seen by the iterative eigensolvers: all they need is the product
+  w = O*v for a range of rows. Concrete operators decide how the matrix
+  elements are stored, if at all.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAOperator_h_
+#define _TAOperator_h_
+
+#include <vector>
+
+using std::vector;
+
+class TAOperator{
+public:
+  virtual ~TAOperator(){}
+
+  /// \retval dimension of the basis
+  virtual int GetNBasis() const = 0;
+  /// w[i-r0] = sum_j <i|O|j>*v[j], for rows i in [r0, r1)
+  /// \param v: the whole vector, of length GetNBasis()
+  /// \param w: the resulting segment, resized to r1-r0
+  virtual void Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1) = 0;
+  /// the same for k vectors at once, stored interleaved: w[(i-r0)*k+l] =
+  /// sum_j <i|O|j>*v[j*k+l], l in [0, k). The concrete operators load each
+  /// matrix element once for all the k vectors; by default Multiply() k times
+  /// \param v: the whole vectors, of length k*GetNBasis()
+  /// \param w: the resulting segments, resized to k*(r1-r0)
+  virtual void MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1);
+};
+
+inline void TAOperator::MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1){
+  const int n = GetNBasis();
+  vector<double> x(n), y;
+  w.resize(long(k)*(r1 - r0));
+  for(int l = 0; l < k; l++){
+    for(int j = 0; j < n; j++) x[j] = v[long(j)*k + l];
+    Multiply(x, y, r0, r1);
+    for(int i = 0; i < r1 - r0; i++) w[long(i)*k + l] = y[i];
+  } // end for over vectors
+} // end of member function MultiplyBlock
+
+#endif
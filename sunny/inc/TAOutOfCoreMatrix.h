@@ -0,0 +1,86 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAOutOfCoreMatrix.h
+  \class TAOutOfCoreMatrix
+  \brief A sparse symmetric matrix kept on local disk instead of in memory, for
+  Hamiltonians too large for RAM. The rows are computed once, packed into
+  blocks of compressed sparse rows (CSR) and appended to a scratch file. The
+  product O*v then streams the blocks back, reading block k+1 in the background
+  while block k is being multiplied (double buffering), so that the disk time
+  hides behind the arithmetic. Under MPI each rank stores its own rows only,
+  in a file of its own.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAOutOfCoreMatrix_h_
+#define _TAOutOfCoreMatrix_h_
+
+#include <string>
+#include <cstdio>
+#include "TAOperator.h"
+
+using std::string;
+
+class TAHamiltonian;
+
+class TAOutOfCoreMatrix : public TAOperator{
+public:
+  /// \param file: the scratch file, suffixed by the rank under MPI
+  TAOutOfCoreMatrix(const string &file);
+  virtual ~TAOutOfCoreMatrix();
+
+  /// compute the rows of this rank and write them to disk block by block
+  void Build(TAHamiltonian *h);
+  virtual int GetNBasis() const override{ return fNBasis; }
+  /// w[i-r0] = sum_j <i|O|j>*v[j], for rows i in [r0, r1), which must be
+  /// stored on this rank
+  virtual void Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1) override;
+  /// the same for k vectors interleaved, the file streamed once for them all
+  virtual void MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1) override;
+
+  /// \param nnz: number of non-zero elements per block, default: 1<<22
+  void SetBlockSize(long nnz){ fBlockSize = nnz; }
+  /// \param opt: store the values in float, to halve the disk traffic. The
+  /// products are still accumulated in double. To be set before Build()
+  void SetSinglePrecision(bool opt = true){ fSingle = opt; }
+  /// \param opt: whether to keep the scratch file after destruction
+  void SetKeepFile(bool opt = true){ fKeepFile = opt; }
+  const string &GetFile() const{ return fFile; }
+  long GetNNZ() const{ return fNNZ; }
+  int GetNBlock() const{ return fBlockR0.size(); }
+
+  /// a block of consecutive rows in CSR form
+  struct TABlock{
+    int r0, r1; ///< rows [r0, r1)
+    vector<long> ptr; ///< row i starts at ptr[i-r0] in col and val
+    vector<int> col;
+    vector<double> val;
+    vector<float> valf; ///< val in single precision
+  };
+
+private:
+  void WriteBlock(const TABlock &b); ///< append b to the file
+  void ReadBlock(int k, TABlock *b); ///< read the k-th block into b
+  /// Multiply and MultiplyBlock: stream the blocks, each through a scalar
+  /// kernel for k = 1, or one for k interleaved vectors
+  void Stream(const vector<double> &v, int k, vector<double> &w, int r0,
+    int r1);
+
+  string fFile;
+  FILE *fStream;
+  bool fKeepFile;
+  bool fSingle; ///< whether the values are stored in float
+  long fBlockSize; ///< number of non-zero elements per block
+  int fNBasis;
+  int fR0, fR1; ///< rows [fR0, fR1) stored in this object
+  long fNNZ; ///< total number of non-zero elements stored
+  vector<int> fBlockR0; ///< the first row of each block
+  vector<long> fBlockOffset; ///< the position of each block in the file
+  TABlock fBuffer[2]; ///< the double buffer for streaming
+};
+
+#endif
@@ -0,0 +1,104 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAProfiler.h
+  \class TAProfiler
+  \brief Low-overhead instrumentation of the hot paths: per-phase wall time,
+  counters of the operator-string integrals, number of non-zero matrix elements
+  per row, and a periodic progress/ETA line for long loops. The results can be
+  exported in JSON. The TAPROF_* macros are the only intended entry points, and
+  they compile to nothing unless SUNNY_PROFILE is defined (cmake -DSUNNY_PROFILE=ON).
+  This is a singleton class.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAProfiler_h_
+#define _TAProfiler_h_
+
+#include <map>
+#include <string>
+
+using std::map;
+using std::string;
+
+class TAProfiler{
+public:
+  /// the hot-path counters
+  enum ECounter{
+    kIntegral1N, kIntegral2N, kIntegral3N, ///< Integral calls
+    kZero1N, kZero2N, kZero3N, ///< Integral calls with zero phase
+    kElement, ///< TAHamiltonian::Element calls
+    kElementPruned, ///< Element calls skipped by the excitation rank
+    kElement1N, kElement2N, kElement3N, ///< the k-body parts of the elements
+    kRowCacheHit, kRowCacheMiss, ///< TAHamiltonian::Row calls
+    kApply, kApplyZero, ///< operator strings by TAManyBodySDList::Apply
+    kNCounter
+  };
+
+  /// RAII timer: accumulates the wall time of its scope to a phase
+  class TAPhase{
+  public:
+    TAPhase(const char *name) : fName(name), fStart(Now()){}
+    ~TAPhase(){ TAProfiler::Instance()->AddPhase(fName, Now() - fStart); }
+  private:
+    const char *fName;
+    double fStart;
+  };
+
+  virtual ~TAProfiler();
+  static TAProfiler *Instance();
+  static double Now(); ///< \retval wall time in seconds
+
+  void AddPhase(const char *name, double sec);
+  /// record the number of non-zero matrix elements in a row
+  void AddRow(int nnz){ fNNZRow[nnz]++; }
+  /// print a progress line with ETA, at most once every fProgressInterval
+  /// seconds \param done, total: finished and total number of work items
+  void Progress(const char *name, long done, long total);
+  void SetProgressInterval(double sec){ fProgressInterval = sec; }
+  void Reset(); ///< clear all the records
+  void Print() const; ///< display the records
+  void ExportJSON(const string &file) const; ///< write the records to file
+
+  static unsigned long long kCounter[kNCounter];
+
+protected:
+  TAProfiler();
+
+  static TAProfiler *kInstance;
+  /// phase name -> {number of calls, accumulated seconds}
+  map<string, std::pair<long, double> > fPhase;
+  map<int, long> fNNZRow; ///< nnz -> number of rows with so many nnz-s
+  double fProgressInterval; ///< seconds between two progress lines
+  double fProgressLast; ///< time of the last progress line
+  double fProgressStart; ///< time of the first call of a progress loop
+};
+
+#ifdef SUNNY_PROFILE
+#define TAPROF_CONCAT_(a, b) a##b
+#define TAPROF_CONCAT(a, b) TAPROF_CONCAT_(a, b)
+/// time the rest of the enclosing scope as phase name
+#define TAPROF_PHASE(name) \
+  TAProfiler::TAPhase TAPROF_CONCAT(taprof_phase_, __LINE__)(name)
+#ifdef _OPENMP // the counters may be hit by several threads at once
+#define TAPROF_COUNT(c) \
+  (__atomic_fetch_add(&TAProfiler::kCounter[TAProfiler::c], 1, __ATOMIC_RELAXED))
+#else
+#define TAPROF_COUNT(c) (++TAProfiler::kCounter[TAProfiler::c])
+#endif
+#define TAPROF_ROW(nnz) TAProfiler::Instance()->AddRow(nnz)
+#define TAPROF_PROGRESS(name, done, total) \
+  TAProfiler::Instance()->Progress(name, done, total)
+#define TAPROF_EXPORT(file) \
+  do{ TAProfiler::Instance()->Print(); \
+    TAProfiler::Instance()->ExportJSON(file); }while(0)
+#else
+#define TAPROF_PHASE(name)
+#define TAPROF_COUNT(c) ((void)0)
+#define TAPROF_ROW(nnz) ((void)0)
+#define TAPROF_PROGRESS(name, done, total) ((void)0)
+#define TAPROF_EXPORT(file) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,64 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAPropagator.h
+  \class TAPropagator
+  \brief The time evolution |psi(t)> = exp(-iHt)|psi(0)> (hbar = 1) of a
+  many-body state under a symmetric operator H, using only the products H*v.
+  Each step builds a short Krylov space of H from |psi>, in which exp(-iH*tau)
+  is that of the small tridiagonal T, known from its eigenpairs. tau is chosen
+  adaptively: the error of a step is estimated by beta_m*|[exp(-iT*tau)e_1]_m|,
+  the leak out of the Krylov space, and tau is cut, at no extra H*v, until the
+  error is below tol*tau, then grown for the next step. The states are complex
+  local segments of TAMPI::Partition, as in TALanczos, H acting on their real
+  and imaginary parts.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAPropagator_h_
+#define _TAPropagator_h_
+
+#include <vector>
+#include <complex>
+
+using std::vector;
+
+class TAOperator;
+
+class TAPropagator{
+public:
+  typedef std::complex<double> cplx;
+
+  /// \param op: H, default: TAHamiltonian
+  TAPropagator(TAOperator *op = nullptr);
+  virtual ~TAPropagator(){}
+
+  /// \param m: the maximum dimension of the Krylov spaces, default: 30
+  void SetKrylovDim(int m){ fKrylovDim = m; }
+  /// \param tol: the error allowed per unit time, default: 1E-10
+  void SetTolerance(double tol){ fTolerance = tol; }
+
+  /// psi = exp(-iHt)*psi, psi being the local segment. \retval steps taken
+  int Propagate(vector<cplx> &psi, double t);
+  /// \retval <a|b>, summed over the ranks
+  static cplx Dot(const vector<cplx> &a, const vector<cplx> &b);
+  /// \retval <psi|H|psi>
+  double Energy(const vector<cplx> &psi);
+  int GetNMultiply() const{ return fNMultiply; } ///< \retval H*v done so far
+  double GetError() const{ return fError; } ///< \retval error estimate so far
+
+protected:
+  /// w = H*q for the local rows, q being the local segment
+  void Multiply(const vector<cplx> &q, vector<cplx> &w);
+
+  TAOperator *fOperator;
+  int fKrylovDim;
+  double fTolerance;
+  double fTau; ///< the step to try next
+  int fNMultiply;
+  double fError; ///< the sum of the errors of the steps
+  vector<double> fLocal, fFull, fW; ///< buffers for H*v, (re, im) interleaved
+};
+
+#endif
@@ -0,0 +1,70 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TASelectedCI.h
+  \class TASelectedCI
+  \brief Iterative selected configuration interaction on top of the M-scheme
+  many-body basis. Starting from a reference space of the lowest-lying SDs, the
+  SDs whose first-order perturbative amplitude |<a|H|psi>/(E0-<a|H|a>)| exceeds
+  a threshold are added to the variational space, which is then diagonalized
+  again. The SDs left out are accounted for by the Epstein-Nesbet second-order
+  perturbative (PT2) correction. This is a singleton class.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TASelectedCI_h_
+#define _TASelectedCI_h_
+
+#include <vector>
+
+using std::vector;
+
+class TAHamiltonian;
+
+class TASelectedCI{
+public:
+  virtual ~TASelectedCI();
+  static TASelectedCI *Instance();
+
+  void Go(); ///< initiate the selected-CI iterations
+
+  /// \param n: number of the lowest-energy SDs composing the reference space
+  void SetNReference(int n){ fNReference = n; }
+  /// \param eps: SDs with |<a|H|psi>/(E0-Haa)| > eps are selected
+  void SetThreshold(double eps){ fThreshold = eps; }
+  void SetMaxIteration(int n){ fMaxIteration = n; }
+  double GetEnergy() const{ return fEnergy; } ///< the variational energy
+  double GetPT2() const{ return fPT2; } ///< the EN-PT2 correction
+  /// \retval indices of the selected SDs in the M-scheme basis
+  const vector<int> &GetSelected() const{ return fSelected; }
+  /// \retval the ground state vector in the selected space, same order
+  /// as GetSelected()
+  const vector<double> &GetVector() const{ return fVector; }
+
+private:
+  TASelectedCI();
+  /// select the reference space from the diagonal of H
+  void Initialize();
+  /// diagonalize H in the selected space, assign fEnergy and fVector
+  void Diagonalize();
+  /// calculate <a|H|psi> for all the unselected SDs, add the important ones
+  /// to the selected space, and sum up the PT2 correction for the rest
+  /// \param add: whether to enlarge the selected space
+  /// \retval number of newly selected SDs
+  int Select(bool add);
+
+  static TASelectedCI *kInstance;
+  TAHamiltonian *fHamiltonian;
+  int fNReference; ///< number of SDs in the reference space
+  double fThreshold; ///< threshold on the first-order amplitudes
+  int fMaxIteration; ///< maximum number of selection rounds
+  vector<double> fHDiag; ///< <a|H|a> for all the M-scheme SDs
+  vector<int> fSelected; ///< the selected SDs
+  vector<bool> fIsSelected; ///< fIsSelected[a]: whether a is selected
+  vector<double> fVector; ///< ground state in the selected space
+  double fEnergy; ///< variational energy in the selected space
+  double fPT2; ///< EN-PT2 correction from the unselected SDs
+};
+
+#endif
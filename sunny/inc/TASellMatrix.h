@@ -0,0 +1,90 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TASellMatrix.h
+  \class TASellMatrix<T>
+  \brief An in-core sparse matrix in the sliced ELLPACK form SELL-C-sigma
+  (Kreutzer et al.), for SIMD products with rows of very different lengths,
+  as those of H over the configurations. The rows are sorted by length within
+  windows of sigma rows and cut into chunks of C rows, each stored column by
+  column and padded to its longest row, so that the C rows of a chunk go
+  through the C lanes of the vector registers, x gathered by the column
+  indices. C is 1, 2 or 4 times the SIMD width, chosen by the padding it takes
+  unless set. The values are stored in T and the products accumulated in
+  double, as in TASparseMatrix. The kernels use AVX-512 or AVX2+FMA when the
+  compiler targets them (cmake -DSUNNY_NATIVE=ON), see TABLAS. Under MPI only
+  the rows of this rank are stored.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TASellMatrix_h_
+#define _TASellMatrix_h_
+
+#include <vector>
+#include "TAOperator.h"
+#include "TASparseMatrix.h"
+
+using std::vector;
+
+class TAHamiltonian;
+
+template<class T>
+class TASellMatrix : public TAOperator{
+public:
+  /// \param chunk: C, rounded up to 1, 2 or 4 times SIMDWidth(), 0 for auto
+  /// \param sigma: the sorting window, rounded up to a multiple of C, default:
+  /// 0 for 256
+  TASellMatrix(int chunk = 0, int sigma = 0);
+  virtual ~TASellMatrix(){}
+
+  /// compute and store the rows of this rank, packed window by window as
+  /// they come from TAHamiltonian::SparseRow, with no full copy in between
+  void Build(TAHamiltonian *h);
+  /// the same rows as m
+  void Build(const TASparseMatrix<T> &m);
+  virtual int GetNBasis() const override{ return fNBasis; }
+  /// w[i-r0] = sum_j <i|O|j>*v[j], for rows i in [r0, r1), which must be
+  /// stored on this rank. Accumulated in double
+  virtual void Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1) override;
+  /// the same for k vectors interleaved, each element read once for them all
+  virtual void MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1) override;
+
+  int GetChunk() const{ return fChunk; }
+  int GetSigma() const{ return fSigma; }
+  long GetNNZ() const{ return fNNZ; }
+  long GetNStored() const{ return fVal.size(); } ///< \retval nnz + padding
+  /// \retval memory taken by the matrix elements and indices
+  long GetBytes() const;
+  /// \retval the doubles per vector register of the kernels, 4 for generic
+  static int SIMDWidth();
+
+protected:
+  /// y[r] = row r of chunk c times x, r in [0, C)
+  void Chunk(const double *x, long c, double *y) const;
+  /// y[r*k+j] = row r of chunk c times x_j, x holding k vectors interleaved
+  void ChunkBlock(const double *x, int k, long c, double *y) const;
+  /// \retval the chunks [c0, c1) holding the local rows [i0, i1)
+  void ChunkRange(int i0, int i1, long &c0, long &c1) const;
+  /// the body of Build(): the rows [r0, r1) of an n*n matrix, row i got by
+  /// row(i, cols, vals), packed into the chunks
+  template<class F>
+  void Pack(int n, int r0, int r1, F row);
+
+  int fChunk, fSigma; ///< C and sigma
+  int fNBasis;
+  int fR0, fR1; ///< rows [fR0, fR1) stored in this object
+  long fNNZ;
+  vector<long> fChunkPtr; ///< chunk c starts at fChunkPtr[c] in fVal and fCol
+  vector<int> fRow; ///< the local row in each lane, -1 for the padding
+  vector<int> fLen; ///< the length of the row in each lane, 0 for the padding
+  vector<T> fVal; ///< chunk by chunk, column by column, C lanes each
+  vector<int> fCol;
+  vector<double> fY; ///< buffer for a chunk of the product
+};
+
+#include "TASellMatrix.hpp"
+
+#endif
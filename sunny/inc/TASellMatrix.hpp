@@ -0,0 +1,236 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TASellMatrix.hpp
+  \class TASellMatrix<T>
+  \brief An in-core sparse matrix in the sliced ELLPACK form SELL-C-sigma.
+  This is the definition file for the member methods. The SIMD kernels for
+  float and double are in TASellMatrix.cxx
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <algorithm>
+#include "TAHamiltonian.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+template<> int TASellMatrix<double>::SIMDWidth();
+template<> int TASellMatrix<float>::SIMDWidth();
+template<> void TASellMatrix<double>::Chunk(const double *x, long c,
+  double *y) const;
+template<> void TASellMatrix<float>::Chunk(const double *x, long c,
+  double *y) const;
+template<> void TASellMatrix<double>::ChunkBlock(const double *x, int k,
+  long c, double *y) const;
+template<> void TASellMatrix<float>::ChunkBlock(const double *x, int k,
+  long c, double *y) const;
+
+template<class T>
+TASellMatrix<T>::TASellMatrix(int chunk, int sigma) : fChunk(chunk),
+    fSigma(sigma), fNBasis(0), fR0(0), fR1(0), fNNZ(0){
+  fChunkPtr.assign(1, 0);
+} // end of the constructor
+
+template<class T>
+int TASellMatrix<T>::SIMDWidth(){ return 4; }
+
+template<class T>
+void TASellMatrix<T>::Build(TAHamiltonian *h){
+  TAPROF_PHASE("TASellMatrix::Build");
+  int r0, r1;
+  TAMPI::Partition(h->GetNBasis(), r0, r1);
+  Pack(h->GetNBasis(), r0, r1, [h](int i, vector<int> &cols,
+      vector<double> &vals){ h->SparseRow(i, cols, vals); });
+} // end of member function Build
+
+template<class T>
+void TASellMatrix<T>::Build(const TASparseMatrix<T> &m){
+  TAPROF_PHASE("TASellMatrix::Build");
+  Pack(m.GetNBasis(), m.GetR0(), m.GetR1(), [&m](int i, vector<int> &cols,
+      vector<double> &vals){ m.GetRow(i, cols, vals); });
+} // end of member function Build
+
+/// the rows are made window by window: those of a window are sorted by
+/// length, descending, and packed into chunks before the next window is made,
+/// so that no more than a window of rows is held besides the chunks. The
+/// chunks are padded with zeros at the last column of their rows, so that
+/// the gathers of the padding hit the cache lines of the row
+template<class T> template<class F>
+void TASellMatrix<T>::Pack(int n, int r0, int r1, F row){
+  fNBasis = n; fR0 = r0; fR1 = r1; fNNZ = 0;
+  const int nl = fR1 - fR0, w = SIMDWidth();
+  auto sigmaOf = [this](int C) -> int{
+    return ((fSigma > 0 ? fSigma : 256) + C - 1) / C * C;
+  };
+  // the local rows [b0, b0+|ptr|-1) made and not packed yet, in CSR form //
+  int b0 = 0;
+  vector<long> ptr(1, 0);
+  vector<int> col, cols;
+  vector<double> val, vals;
+  auto make = [&](int i1){ // up to local row i1
+    for(int i = b0 + int(ptr.size()) - 1; i < i1; i++){
+      row(fR0 + i, cols, vals);
+      col.insert(col.end(), cols.begin(), cols.end());
+      val.insert(val.end(), vals.begin(), vals.end());
+      ptr.push_back(col.size());
+      TAPROF_PROGRESS("TASellMatrix::Build", i + 1, nl);
+    } // end for over rows
+  };
+  auto len = [&](int i) -> long{ return ptr[i-b0+1] - ptr[i-b0]; };
+  // the local rows [s, e) in the order of the chunks //
+  vector<int> order;
+  auto sorted = [&](int s, int e){
+    order.resize(e - s);
+    for(int i = s; i < e; i++) order[i-s] = i;
+    std::stable_sort(order.begin(), order.end(),
+      [&len](int a, int b){ return len(a) > len(b); });
+  };
+  auto stored = [&](int C, int e) -> long{ // nnz + padding of rows [0, e)
+    long m = 0;
+    for(int s = 0; s < e; s += sigmaOf(C)){
+      sorted(s, std::min(s + sigmaOf(C), e));
+      for(size_t q = 0; q < order.size(); q += C) m += C*len(order[q]);
+    } // end for over windows
+    return m;
+  };
+
+  // C: the widest of w, 2w and 4w up to 16 rows, for independent chains of
+  // FMAs, unless the padding of the leading rows grows by more than 5% over
+  // that of w. Wider chunks measured no faster //
+  const int e0 = std::min(nl, sigmaOf(4*w));
+  make(e0);
+  int u = 1;
+  if(fChunk > 0) while(u < 4 && u*w < fChunk) u *= 2;
+  else{
+    const long n1 = stored(w, e0);
+    while(u < 4 && 2*u*w <= 16 && stored(2*u*w, e0) <= 1.05*n1) u *= 2;
+  } // end else
+  fChunk = u*w;
+  fSigma = sigmaOf(fChunk);
+
+  // pack the chunks, the room guessed from the leading rows //
+  const int C = fChunk;
+  fChunkPtr.assign(1, 0);
+  fRow.clear(); fLen.clear(); fVal.clear(); fCol.clear();
+  if(e0){
+    const long guess = 1.05 * stored(C, e0) / e0 * nl;
+    fVal.reserve(guess); fCol.reserve(guess);
+  } // end if
+  fRow.reserve((nl + C - 1) / C * C); fLen.reserve(fRow.capacity());
+  for(int s = 0; s < nl; s += fSigma){
+    const int e = std::min(s + fSigma, nl);
+    make(e);
+    sorted(s, e);
+    for(size_t q = 0; q < order.size(); q += C){
+      const long p0 = fVal.size(), width = len(order[q]);
+      fVal.resize(p0 + C*width, T(0)); fCol.resize(p0 + C*width, 0);
+      for(int r = 0; r < C; r++){
+        const int i = q + r < order.size() ? order[q + r] : -1;
+        fRow.push_back(i);
+        fLen.push_back(i < 0 ? 0 : len(i));
+        if(i < 0) continue;
+        const long a = ptr[i-b0], li = len(i);
+        for(long l = 0; l < width; l++){
+          fCol[p0 + l*C + r] = l < li ? col[a + l] : li ? col[a + li - 1] : 0;
+          if(l < li) fVal[p0 + l*C + r] = T(val[a + l]);
+        } // end for over l
+        fNNZ += li;
+      } // end for over r
+      fChunkPtr.push_back(fVal.size());
+    } // end for over chunks
+    // drop the rows packed //
+    const long a = ptr[e-b0];
+    col.erase(col.begin(), col.begin() + a);
+    val.erase(val.begin(), val.begin() + a);
+    ptr.erase(ptr.begin(), ptr.begin() + (e - b0));
+    for(long &p : ptr) p -= a;
+    b0 = e;
+  } // end for over windows
+
+  const long nStored = fVal.size();
+  TAINFO("TASellMatrix", "Build: rows [%d, %d), nnz: %ld, C: %d, sigma: %d, \
+filled: %.1f%%, %d-byte values, %.1f MB", fR0, fR1, fNNZ, fChunk, fSigma,
+    nStored ? 100.*fNNZ/nStored : 100., int(sizeof(T)), GetBytes() / 1048576.);
+} // end of member function Pack
+
+template<class T>
+long TASellMatrix<T>::GetBytes() const{
+  return fVal.size()*sizeof(T) + fCol.size()*sizeof(int) +
+    fChunkPtr.size()*sizeof(long) + (fRow.size() + fLen.size())*sizeof(int);
+} // end of member function GetBytes
+
+/// the windows before that of i0 are full, of sigma/C chunks each
+template<class T>
+void TASellMatrix<T>::ChunkRange(int i0, int i1, long &c0, long &c1) const{
+  const long nChunk = fChunkPtr.size() - 1, cw = fSigma / fChunk;
+  c0 = std::min(nChunk, i0 / fSigma * cw);
+  c1 = i1 > i0 ? std::min(nChunk, ((i1 - 1) / fSigma + 1) * cw) : c0;
+} // end of member function ChunkRange
+
+template<class T>
+void TASellMatrix<T>::Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1){
+  TAPROF_PHASE("TASellMatrix::Multiply");
+  if(int(v.size()) != fNBasis || r0 < fR0 || r1 > fR1 || r0 > r1)
+    TAException::Error("TASellMatrix", "Multiply: |v|: %d, rows [%d, %d) \
+while [%d, %d) stored", int(v.size()), r0, r1, fR0, fR1);
+  w.resize(r1 - r0);
+  const int i0 = r0 - fR0, i1 = r1 - fR0, C = fChunk;
+  long c0, c1;
+  ChunkRange(i0, i1, c0, c1);
+  fY.resize(C);
+  for(long c = c0; c < c1; c++){
+    Chunk(v.data(), c, fY.data());
+    for(int r = 0; r < C; r++){
+      const int i = fRow[c*C + r];
+      if(i >= i0 && i < i1) w[i - i0] = fY[r];
+    } // end for over r
+  } // end for over chunks
+} // end of member function Multiply
+
+template<class T>
+void TASellMatrix<T>::MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1){
+  TAPROF_PHASE("TASellMatrix::MultiplyBlock");
+  if(long(v.size()) != long(fNBasis)*k || r0 < fR0 || r1 > fR1 || r0 > r1)
+    TAException::Error("TASellMatrix", "MultiplyBlock: |v|: %ld for %d \
+vectors, rows [%d, %d) while [%d, %d) stored", long(v.size()), k, r0, r1,
+      fR0, fR1);
+  w.resize(long(r1 - r0)*k);
+  const int i0 = r0 - fR0, i1 = r1 - fR0, C = fChunk;
+  long c0, c1;
+  ChunkRange(i0, i1, c0, c1);
+  fY.resize(long(C)*k);
+  for(long c = c0; c < c1; c++){
+    ChunkBlock(v.data(), k, c, fY.data());
+    for(int r = 0; r < C; r++){
+      const int i = fRow[c*C + r];
+      if(i >= i0 && i < i1) std::copy(fY.begin() + long(r)*k,
+        fY.begin() + long(r + 1)*k, w.begin() + long(i - i0)*k);
+    } // end for over r
+  } // end for over chunks
+} // end of member function MultiplyBlock
+
+template<class T>
+void TASellMatrix<T>::Chunk(const double *x, long c, double *y) const{
+  const int C = fChunk;
+  const long p0 = fChunkPtr[c], width = (fChunkPtr[c+1] - p0) / C;
+  for(int r = 0; r < C; r++) y[r] = 0.;
+  for(long l = 0; l < width; l++) for(int r = 0; r < C; r++)
+    y[r] += double(fVal[p0 + l*C + r]) * x[fCol[p0 + l*C + r]];
+} // end of member function Chunk
+
+template<class T>
+void TASellMatrix<T>::ChunkBlock(const double *x, int k, long c,
+    double *y) const{
+  const int C = fChunk;
+  const long p0 = fChunkPtr[c];
+  std::fill(y, y + long(C)*k, 0.);
+  for(int r = 0; r < C; r++) for(int l = 0; l < fLen[c*C + r]; l++){
+    const long p = p0 + long(l)*C + r;
+    const double a = fVal[p], *xr = x + long(fCol[p])*k;
+    for(int j = 0; j < k; j++) y[long(r)*k + j] += a * xr[j];
+  } // end for over r and l
+} // end of member function ChunkBlock
@@ -0,0 +1,76 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAShiftInvert.h
+  \class TAShiftInvert
+  \brief The eigenstates of a symmetric operator H nearest to a target energy
+  sigma, deep in the spectrum, without those below. The iterations are
+  x <- (H-s)^(-1)*x, the linear systems solved by MINRES, which takes the
+  symmetric indefinite H-s with only the products H*v. The shift s stays at
+  sigma until x has settled on the state nearest to it, then follows the
+  Rayleigh quotient <x|H|x>, for the cubic convergence of the Rayleigh quotient
+  iteration. More states are found one after another, each kept orthogonal to
+  those found before. The vectors are distributed over the MPI ranks as in
+  TALanczos.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TAShiftInvert_h_
+#define _TAShiftInvert_h_
+
+#include <vector>
+
+using std::vector;
+
+class TAOperator;
+
+class TAShiftInvert{
+public:
+  /// \param op: H, default: TAHamiltonian
+  TAShiftInvert(TAOperator *op = nullptr);
+  virtual ~TAShiftInvert(){}
+
+  void SetTarget(double sigma){ fTarget = sigma; } ///< default: 0
+  void SetNEigen(int n){ fNEigen = n; } ///< the states nearest to the target
+  /// \param tol: converged once the residual |H*x-E*x| < tol*max(1,|E|)
+  void SetTolerance(double tol){ fTolerance = tol; }
+  /// \param tol: the shift follows the Rayleigh quotient once the residual is
+  /// below tol*max(1,|E|), default: 1E-2
+  void SetRQITolerance(double tol){ fRQITolerance = tol; }
+  void SetMaxIteration(int n){ fMaxIteration = n; } ///< the outer iterations
+  /// \param n, tol: the limits of MINRES, iterations and relative residual
+  void SetMINRES(int n, double tol){ fMaxMINRES = n; fMINRESTolerance = tol; }
+
+  void Go(); ///< find the states
+  int GetNEigen() const{ return fEnergy.size(); }
+  double GetEnergy(int i = 0) const;
+  /// \retval the local segment of the i-th eigenvector, rows [r0, r1) of
+  /// TAMPI::Partition
+  const vector<double> &GetVector(int i = 0) const;
+  int GetNMultiply() const{ return fNMultiply; } ///< \retval H*v done in Go()
+
+  /// solve (H-s)*x = b by MINRES, x starting from 0, all as local segments
+  /// \retval the number of iterations
+  int MINRES(double s, const vector<double> &b, vector<double> &x);
+
+protected:
+  /// H*q for the local rows, q being the local segment
+  void Multiply(const vector<double> &q, vector<double> &w);
+  /// orthogonalize x to the states found, and normalize it
+  void Orthonormalize(vector<double> &x) const;
+
+  TAOperator *fOperator;
+  double fTarget;
+  int fNEigen;
+  double fTolerance, fRQITolerance;
+  int fMaxIteration, fMaxMINRES;
+  double fMINRESTolerance;
+  int fNMultiply;
+  int fR0, fR1; ///< the local rows [fR0, fR1)
+  vector<double> fFull; ///< buffer for the whole vector gathered
+  vector<double> fEnergy; ///< the eigenvalues, in the order found
+  vector<vector<double> > fVector; ///< local segments of the eigenvectors
+};
+
+#endif
@@ -20,6 +20,10 @@ public:
 		short _2j, short _2mj, double energy);
 	virtual ~TASingleParticleState();
 	short GetMj(){ return f2mj; } /// \return the third component mj
+	short GetN() const{ return fn; } ///< \return the number of radial nodes
+	short GetL() const{ return fl; } ///< \return the orbital angular momentum
+	short Get2J() const{ return f2j; } ///< \return the angular momentum*2
+	short Get2Mj() const{ return f2mj; } ///< \return the third component*2
 	double GetEnergy(){ return fEnergy; }
 	void Print() const; ///< print the single particle state
 
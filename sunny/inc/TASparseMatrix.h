@@ -0,0 +1,79 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TASparseMatrix.h
+  \class TASparseMatrix<T>
+  \brief An in-core sparse matrix in compressed sparse row (CSR) form, for the
+  eigen-iterations bound by memory traffic. The values are stored in T (float
+  halves the traffic of double), and the column indices either as plain 32-bit
+  integers or delta-encoded within each row in a variable number of bytes.
+  Whatever T is, the products are accumulated in double. Under MPI only the
+  rows of this rank are stored.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifndef _TASparseMatrix_h_
+#define _TASparseMatrix_h_
+
+#include <vector>
+#include "TAOperator.h"
+
+using std::vector;
+
+class TAHamiltonian;
+
+template<class T>
+class TASparseMatrix : public TAOperator{
+public:
+  /// storage of the column indices
+  enum EIndex{
+    kIndex32, ///< one 32-bit integer per element
+    kIndexDelta ///< distance to the previous column in the row, 7 bits a byte
+  };
+
+  TASparseMatrix(EIndex index = kIndex32);
+  virtual ~TASparseMatrix(){}
+
+  /// compute and store the rows of this rank
+  void Build(TAHamiltonian *h);
+  /// empty the matrix, so as to be filled by AddRow() from row r0 on
+  void Clear(int nBasis, int r0 = 0);
+  /// append a row, cols ascending
+  void AddRow(const vector<int> &cols, const vector<double> &vals);
+  virtual int GetNBasis() const override{ return fNBasis; }
+  /// w[i-r0] = sum_j <i|O|j>*v[j], for rows i in [r0, r1), which must be
+  /// stored on this rank. Accumulated in double
+  virtual void Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1) override;
+  /// the same for k vectors interleaved, each element read once for them all
+  virtual void MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1) override;
+
+  EIndex GetIndex() const{ return fIndex; }
+  int GetR0() const{ return fR0; } ///< \retval the first row stored
+  int GetR1() const{ return fR1; } ///< \retval the last row stored + 1
+  int GetRowLength(int i) const{ return fPtr[i-fR0+1] - fPtr[i-fR0]; }
+  /// the columns, ascending, and values of the stored row i
+  void GetRow(int i, vector<int> &cols, vector<double> &vals) const;
+  long GetNNZ() const{ return fVal.size(); }
+  /// \retval memory taken by the matrix elements and indices
+  long GetBytes() const;
+
+  /// append the delta code of cols to idx
+  static void EncodeDelta(const int *cols, int n, vector<unsigned char> &idx);
+
+protected:
+  EIndex fIndex;
+  int fNBasis;
+  int fR0, fR1; ///< rows [fR0, fR1) stored in this object
+  vector<long> fPtr; ///< row i starts at fPtr[i-fR0] in fVal
+  vector<T> fVal;
+  vector<int> fCol; ///< column indices, kIndex32
+  vector<long> fIdxPtr; ///< row i starts at fIdxPtr[i-fR0] in fIdx
+  vector<unsigned char> fIdx; ///< the delta code, kIndexDelta
+};
+
+#include "TASparseMatrix.hpp"
+
+#endif
@@ -0,0 +1,170 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TASparseMatrix.hpp
+  \class TASparseMatrix<T>
+  \brief An in-core sparse matrix in compressed sparse row (CSR) form. This is
+  the definition file for the member methods
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include "TAHamiltonian.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+template<class T>
+TASparseMatrix<T>::TASparseMatrix(EIndex index) : fIndex(index), fNBasis(0),
+    fR0(0), fR1(0){
+  fPtr.assign(1, 0); fIdxPtr.assign(1, 0);
+} // end of the constructor
+
+template<class T>
+void TASparseMatrix<T>::Build(TAHamiltonian *h){
+  TAPROF_PHASE("TASparseMatrix::Build");
+  int r0, r1;
+  TAMPI::Partition(h->GetNBasis(), r0, r1);
+  Clear(h->GetNBasis(), r0);
+  vector<int> cols; vector<double> vals;
+  for(int rr = r0; rr < r1; rr++){
+    h->SparseRow(rr, cols, vals);
+    AddRow(cols, vals);
+    TAPROF_PROGRESS("TASparseMatrix::Build", rr - fR0 + 1, r1 - fR0);
+  } // end for over rows
+
+  TAINFO("TASparseMatrix", "Build: rows [%d, %d), nnz: %ld, %d-byte values, \
+%s indices, %.1f MB", fR0, fR1, GetNNZ(), int(sizeof(T)),
+    kIndexDelta == fIndex ? "delta" : "32-bit", GetBytes() / 1048576.);
+} // end of member function Build
+
+template<class T>
+void TASparseMatrix<T>::Clear(int nBasis, int r0){
+  fNBasis = nBasis; fR0 = fR1 = r0;
+  fPtr.assign(1, 0); fIdxPtr.assign(1, 0);
+  fVal.clear(); fCol.clear(); fIdx.clear();
+} // end of member function Clear
+
+template<class T>
+void TASparseMatrix<T>::AddRow(const vector<int> &cols,
+    const vector<double> &vals){
+  if(cols.size() != vals.size())
+    TAException::Error("TASparseMatrix", "AddRow: |cols|: %d != |vals|: %d",
+      int(cols.size()), int(vals.size()));
+  for(double x : vals) fVal.push_back(T(x));
+  fPtr.push_back(fVal.size());
+  if(kIndexDelta == fIndex){
+    EncodeDelta(cols.data(), cols.size(), fIdx);
+    fIdxPtr.push_back(fIdx.size());
+  } // end if
+  else fCol.insert(fCol.end(), cols.begin(), cols.end());
+  fR1++;
+} // end of member function AddRow
+
+/// the first column is coded as is, the rest as the distance to the previous
+/// one, in 7-bit groups, low groups first, the high bit meaning "more to come"
+template<class T>
+void TASparseMatrix<T>::EncodeDelta(const int *cols, int n,
+    vector<unsigned char> &idx){
+  int c0 = 0;
+  for(int k = 0; k < n; k++){
+    unsigned d = cols[k] - c0;
+    c0 = cols[k];
+    while(d >= 0x80){ idx.push_back((d & 0x7f) | 0x80); d >>= 7; }
+    idx.push_back(d);
+  } // end for over k
+} // end of member function EncodeDelta
+
+template<class T>
+void TASparseMatrix<T>::GetRow(int i, vector<int> &cols,
+    vector<double> &vals) const{
+  if(i < fR0 || i >= fR1)
+    TAException::Error("TASparseMatrix", "GetRow: row %d while [%d, %d) \
+stored", i, fR0, fR1);
+  cols.clear(); vals.clear();
+  const unsigned char *p = kIndexDelta == fIndex ?
+    fIdx.data() + fIdxPtr[i-fR0] : nullptr;
+  int c = 0;
+  for(long k = fPtr[i-fR0]; k < fPtr[i-fR0+1]; k++){
+    if(kIndexDelta == fIndex){
+      unsigned d = *p & 0x7f;
+      for(int sh = 7; *p++ & 0x80; sh += 7) d |= unsigned(*p & 0x7f) << sh;
+      c += d;
+    } // end if
+    else c = fCol[k];
+    cols.push_back(c);
+    vals.push_back(fVal[k]);
+  } // end for over k
+} // end of member function GetRow
+
+template<class T>
+long TASparseMatrix<T>::GetBytes() const{
+  return fVal.size()*sizeof(T) + fPtr.size()*sizeof(long) +
+    fCol.size()*sizeof(int) + fIdx.size() + fIdxPtr.size()*sizeof(long);
+} // end of member function GetBytes
+
+template<class T>
+void TASparseMatrix<T>::Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1){
+  TAPROF_PHASE("TASparseMatrix::Multiply");
+  if(int(v.size()) != fNBasis || r0 < fR0 || r1 > fR1 || r0 > r1)
+    TAException::Error("TASparseMatrix", "Multiply: |v|: %d, rows [%d, %d) \
+while [%d, %d) stored", int(v.size()), r0, r1, fR0, fR1);
+  w.resize(r1 - r0);
+  const double *pv = v.data();
+  if(kIndexDelta == fIndex){
+    for(int i = r0; i < r1; i++){
+      const unsigned char *p = fIdx.data() + fIdxPtr[i-fR0];
+      double s = 0.;
+      int c = 0;
+      for(long k = fPtr[i-fR0]; k < fPtr[i-fR0+1]; k++){
+        unsigned d = *p & 0x7f;
+        for(int sh = 7; *p++ & 0x80; sh += 7) d |= unsigned(*p & 0x7f) << sh;
+        c += d;
+        s += double(fVal[k]) * pv[c];
+      } // end for over k
+      w[i-r0] = s;
+    } // end for over rows
+    return;
+  } // end if
+  for(int i = r0; i < r1; i++){
+    double s = 0.;
+    for(long k = fPtr[i-fR0]; k < fPtr[i-fR0+1]; k++)
+      s += double(fVal[k]) * pv[fCol[k]];
+    w[i-r0] = s;
+  } // end for over rows
+} // end of member function Multiply
+
+template<class T>
+void TASparseMatrix<T>::MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1){
+  TAPROF_PHASE("TASparseMatrix::MultiplyBlock");
+  if(long(v.size()) != long(fNBasis)*k || r0 < fR0 || r1 > fR1 || r0 > r1)
+    TAException::Error("TASparseMatrix", "MultiplyBlock: |v|: %ld for %d \
+vectors, rows [%d, %d) while [%d, %d) stored", long(v.size()), k, r0, r1,
+      fR0, fR1);
+  w.assign(long(r1 - r0)*k, 0.);
+  const double *pv = v.data();
+  if(kIndexDelta == fIndex){
+    for(int i = r0; i < r1; i++){
+      const unsigned char *p = fIdx.data() + fIdxPtr[i-fR0];
+      double *s = w.data() + long(i - r0)*k;
+      int c = 0;
+      for(long l = fPtr[i-fR0]; l < fPtr[i-fR0+1]; l++){
+        unsigned d = *p & 0x7f;
+        for(int sh = 7; *p++ & 0x80; sh += 7) d |= unsigned(*p & 0x7f) << sh;
+        c += d;
+        const double a = fVal[l], *x = pv + long(c)*k;
+        for(int j = 0; j < k; j++) s[j] += a * x[j];
+      } // end for over l
+    } // end for over rows
+    return;
+  } // end if
+  for(int i = r0; i < r1; i++){
+    double *s = w.data() + long(i - r0)*k;
+    for(long l = fPtr[i-fR0]; l < fPtr[i-fR0+1]; l++){
+      const double a = fVal[l], *x = pv + long(fCol[l])*k;
+      for(int j = 0; j < k; j++) s[j] += a * x[j];
+    } // end for over l
+  } // end for over rows
+} // end of member function MultiplyBlock
@@ -14,6 +14,7 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <complex>
 
 #include "TAException.h"
 
@@ -25,12 +26,19 @@ using std::ios_base;
 template<class T>
 bool inline isBasic(){
   if(typeid(T) == typeid(double) || typeid(T) == typeid(int)
-      || typeid(T) == typeid(short) || typeid(T) == typeid(unsigned) ){
+      || typeid(T) == typeid(short) || typeid(T) == typeid(unsigned)
+      || typeid(T) == typeid(std::complex<double>) ){
     return true;
   }
   return false;
 } // end inline function isBasic
 
+/// \retval whether x is zero, for the basic types and the complex numbers
+template<class T>
+bool inline isZero(const T &x){ return !x; }
+template<class T>
+bool inline isZero(const std::complex<T> &x){ return x == std::complex<T>(); }
+
 // vector struct for the constituent vectors in the matrix
 template<class T>
 vec_t<T>::vec_t(int n) : fData(nullptr){
@@ -84,19 +92,16 @@ vec_t<T> &vec_t<T>::operator=(vec_t &&v){
 }
 template<class T>
 T &vec_t<T>::operator[](int i){
-  if(i < 0 || i >= int(this->size())){
-    TAException::Error("vec_t<T>", "operator[]: Input i=%d, out of range.", i);
-  }
-  return *this->at(i);
+  TACHECK(i >= 0 && i < int(this->size()),
+    "vec_t<T>", "operator[]: Input i=%d, out of range.", i);
+  return *vector<T *>::operator[](i);
 }
 template<class T>
 const T &vec_t<T>::operator[](int i) const{
   /// XXX: return (*this)[i]; WRONG: trigger self-calling, an endless recursion
-  if(i < 0 || i >= int(this->size())){
-    TAException::Error("vec_t<T>",
-      "operator[] const: Input i=%d, out of range.", i);
-  }
-  return *this->at(i);
+  TACHECK(i >= 0 && i < int(this->size()),
+    "vec_t<T>", "operator[] const: Input i=%d, out of range.", i);
+  return *vector<T *>::operator[](i);
 }
 template<class T>
 vec_t<T> vec_t<T>::operator+(
@@ -137,7 +142,7 @@ vec_t<T> vec_t<T>::operator*(const vec_t<T> &v) const{
   bool basicType = isBasic<T>();
   vec_t<T> prod(1); // automatically initialized to zero upon construction
   for(int i = n; i--;){
-    if(basicType && (!v[i] || !(*this)[i]) ) continue;
+    if(basicType && (isZero(v[i]) || isZero((*this)[i])) ) continue;
     if(1. == v[i]) prod[0] += (*this)[i];
     else if(1. == (*this)[i]) prod[0] += v[i];
     else prod[0] += (*this)[i] * v[i];
@@ -163,7 +168,7 @@ template<class T>
 vec_t<T> vec_t<T>::operator/(const T &v) const{
   const int n = this->size();
   vec_t<T> prod(n);
-  if(isBasic<T>() && v == 0)
+  if(isBasic<T>() && isZero(v))
     TAException::Error("vec_t<T>", "operator/: Input object is zero.");
   for(int i = 0; i < n; i++) prod[i] = (*this)[i] / v;
   return prod;
@@ -192,7 +197,7 @@ vec_t<T> &vec_t<T>::operator/=(const T &b){
   if(!isBasic<T>()){
     TAException::Error("vec_t<T>", "operator/=: Input not of basic type.");
   }
-  if(!b) TAException::Error("vec_t<T>", "operator/=: Input is zero.");
+  if(isZero(b)) TAException::Error("vec_t<T>", "operator/=: Input is zero.");
   for(T *t : (*this)) *t /= b;
   return *this;
 }
@@ -200,6 +205,13 @@ template<class T>
 T vec_t<T>::norm(){
   return sqrt(((*this)*(*this))[0]);
 }
+/// the complex vectors take the hermitian norm sqrt(sum_i |v_i|^2)
+template<>
+inline std::complex<double> vec_t<std::complex<double> >::norm(){
+  double s = 0.;
+  for(std::complex<double> *t : (*this)) s += std::norm(*t);
+  return sqrt(s);
+}
 template<class T>
 void vec_t<T>::normalize(){
   const T m(norm());
@@ -0,0 +1,60 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAArena.cxx
+  \class TAArena
+  \brief A bump-pointer memory arena. Memory is carved in order out of large
+  chunks, and is only given back all at once by Release() or the destructor,
+  so that a myriad of small objects of the same lifetime, e.g. the many-body
+  SDs of TAManyBodySDManager, cost no malloc/free each and lie contiguously.
+  Objects placed in the arena are not destructed by it: the owner calls their
+  destructors, if nontrivial, before Release().
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cstdint>
+#include <new>
+#include "TAArena.h"
+#include "TAException.h"
+
+TAArena::TAArena(size_t chunkSize) : fChunkSize(chunkSize ? chunkSize : 1<<20),
+    fCur(nullptr), fEnd(nullptr), fCapacity(0), fUsed(0){}
+
+TAArena::~TAArena(){
+  Release();
+} // end of the destructor
+
+void TAArena::NewChunk(size_t bytes){
+  // the chunks from operator new are aligned for any fundamental type
+  const size_t size = bytes > fChunkSize ? bytes : fChunkSize;
+  char *p = static_cast<char *>(::operator new(size));
+  fChunk.push_back(p);
+  fCur = p; fEnd = p + size;
+  fCapacity += size;
+} // end of member function NewChunk
+
+void *TAArena::Allocate(size_t bytes, size_t align){
+  if(!align || (align & (align - 1)))
+    TAException::Error("TAArena", "Allocate: alignment %d is not a power of 2",
+      int(align));
+  uintptr_t p = (reinterpret_cast<uintptr_t>(fCur) + align - 1) & ~(align - 1);
+  if(!fCur || p + bytes > reinterpret_cast<uintptr_t>(fEnd)){
+    NewChunk(bytes + align);
+    p = (reinterpret_cast<uintptr_t>(fCur) + align - 1) & ~(align - 1);
+  } // end if
+  fCur = reinterpret_cast<char *>(p + bytes);
+  fUsed += bytes;
+  return reinterpret_cast<void *>(p);
+} // end of member function Allocate
+
+void TAArena::Reserve(size_t bytes){
+  if(!fCur || size_t(fEnd - fCur) < bytes) NewChunk(bytes);
+} // end of member function Reserve
+
+void TAArena::Release(){
+  for(char *p : fChunk) ::operator delete(p);
+  fChunk.clear();
+  fCur = fEnd = nullptr;
+  fCapacity = fUsed = 0;
+} // end of member function Release
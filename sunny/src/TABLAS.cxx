@@ -0,0 +1,163 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TABLAS.cxx
+  \class TABLAS
+  \brief BLAS-1 kernels on contiguous double arrays, in place and free of any
+  allocation, for the vector work of the Krylov solvers and orthogonalizations.
+  They are vectorized with AVX-512 or AVX2+FMA when the compiler targets them
+  (cmake -DSUNNY_NATIVE=ON for the host CPU), and fall back to plain loops
+  otherwise. The multi-vector kernels sweep y in cache-sized chunks, so that y
+  is read from memory once for all the m vectors instead of m times.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cmath>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "TABLAS.h"
+
+#if defined(__AVX512F__)
+#define TABLAS_AVX512
+#elif defined(__AVX2__) && defined(__FMA__)
+#define TABLAS_AVX2
+#endif
+
+static const long kChunk = 1024; ///< 8 kB of y per chunk, to stay in L1
+
+#ifdef TABLAS_AVX512
+// summed by hand: _mm512_reduce_add_pd trips -Wuninitialized in GCC 12
+static inline double HSum(__m512d a){
+  alignas(64) double t[8];
+  _mm512_store_pd(t, a);
+  return ((t[0] + t[1]) + (t[2] + t[3])) + ((t[4] + t[5]) + (t[6] + t[7]));
+} // end of function HSum
+#endif
+
+#ifdef TABLAS_AVX2
+static inline double HSum(__m256d a){
+  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+} // end of function HSum
+#endif
+
+double TABLAS::Dot(const double *x, const double *y, long n){
+  long i = 0;
+  double s = 0.;
+#if defined(TABLAS_AVX512)
+  __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+  for(; i + 16 <= n; i += 16){
+    s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i), _mm512_loadu_pd(y+i), s0);
+    s1 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i+8), _mm512_loadu_pd(y+i+8), s1);
+  } // end for over i
+  s = HSum(_mm512_add_pd(s0, s1));
+#elif defined(TABLAS_AVX2)
+  __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+  for(; i + 8 <= n; i += 8){
+    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i), _mm256_loadu_pd(y+i), s0);
+    s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i+4), _mm256_loadu_pd(y+i+4), s1);
+  } // end for over i
+  s = HSum(_mm256_add_pd(s0, s1));
+#else
+  double s0 = 0., s1 = 0., s2 = 0., s3 = 0.; // independent chains
+  for(; i + 4 <= n; i += 4){
+    s0 += x[i]*y[i]; s1 += x[i+1]*y[i+1];
+    s2 += x[i+2]*y[i+2]; s3 += x[i+3]*y[i+3];
+  } // end for over i
+  s = (s0 + s1) + (s2 + s3);
+#endif
+  for(; i < n; i++) s += x[i]*y[i];
+  return s;
+} // end of member function Dot
+
+void TABLAS::Axpy(double a, const double *x, double *y, long n){
+  long i = 0;
+#if defined(TABLAS_AVX512)
+  const __m512d va = _mm512_set1_pd(a);
+  for(; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(y+i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x+i),
+      _mm512_loadu_pd(y+i)));
+#elif defined(TABLAS_AVX2)
+  const __m256d va = _mm256_set1_pd(a);
+  for(; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(y+i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x+i),
+      _mm256_loadu_pd(y+i)));
+#endif
+  for(; i < n; i++) y[i] += a*x[i];
+} // end of member function Axpy
+
+void TABLAS::Scal(double a, double *x, long n){
+  long i = 0;
+#if defined(TABLAS_AVX512)
+  const __m512d va = _mm512_set1_pd(a);
+  for(; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(x+i, _mm512_mul_pd(va, _mm512_loadu_pd(x+i)));
+#elif defined(TABLAS_AVX2)
+  const __m256d va = _mm256_set1_pd(a);
+  for(; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(x+i, _mm256_mul_pd(va, _mm256_loadu_pd(x+i)));
+#endif
+  for(; i < n; i++) x[i] *= a;
+} // end of member function Scal
+
+double TABLAS::Nrm2(const double *x, long n){
+  return sqrt(Dot(x, x, n));
+} // end of member function Nrm2
+
+double TABLAS::AxpyDot(double a, const double *x, double *y, const double *z,
+    long n){
+  long i = 0;
+  double s = 0.;
+#if defined(TABLAS_AVX512)
+  const __m512d va = _mm512_set1_pd(a);
+  __m512d s0 = _mm512_setzero_pd();
+  for(; i + 8 <= n; i += 8){
+    const __m512d vy = _mm512_fmadd_pd(va, _mm512_loadu_pd(x+i),
+      _mm512_loadu_pd(y+i));
+    _mm512_storeu_pd(y+i, vy);
+    s0 = _mm512_fmadd_pd(vy, _mm512_loadu_pd(z+i), s0);
+  } // end for over i
+  s = HSum(s0);
+#elif defined(TABLAS_AVX2)
+  const __m256d va = _mm256_set1_pd(a);
+  __m256d s0 = _mm256_setzero_pd();
+  for(; i + 4 <= n; i += 4){
+    const __m256d vy = _mm256_fmadd_pd(va, _mm256_loadu_pd(x+i),
+      _mm256_loadu_pd(y+i));
+    _mm256_storeu_pd(y+i, vy);
+    s0 = _mm256_fmadd_pd(vy, _mm256_loadu_pd(z+i), s0);
+  } // end for over i
+  s = HSum(s0);
+#endif
+  for(; i < n; i++){ y[i] += a*x[i]; s += y[i]*z[i]; }
+  return s;
+} // end of member function AxpyDot
+
+void TABLAS::MultiDot(const double *const *x, int m, const double *y, long n,
+    double *c){
+  for(int k = 0; k < m; k++) c[k] = 0.;
+  for(long i0 = 0; i0 < n; i0 += kChunk){
+    const long len = n - i0 < kChunk ? n - i0 : kChunk;
+    for(int k = 0; k < m; k++) c[k] += Dot(x[k] + i0, y + i0, len);
+  } // end for over chunks
+} // end of member function MultiDot
+
+void TABLAS::MultiAxpy(const double *c, const double *const *x, int m,
+    double *y, long n){
+  for(long i0 = 0; i0 < n; i0 += kChunk){
+    const long len = n - i0 < kChunk ? n - i0 : kChunk;
+    for(int k = 0; k < m; k++) if(c[k]) Axpy(c[k], x[k] + i0, y + i0, len);
+  } // end for over chunks
+} // end of member function MultiAxpy
+
+const char *TABLAS::ISA(){
+#if defined(TABLAS_AVX512)
+  return "AVX-512";
+#elif defined(TABLAS_AVX2)
+  return "AVX2+FMA";
+#else
+  return "generic";
+#endif
+} // end of member function ISA
@@ -40,7 +40,7 @@ TABit::~TABit(){}
 void TABit::SetBit(const int *arr, int np){
   Reset(); // set fBit array to zero
   for(int i = 0; i < np; i++){
-    if(arr[i] < 0 || arr[i] >= int(sizeof(fBit))){
+    if(arr[i] < 0 || arr[i] >= int(sizeof(fBit) * 8)){
       TAException::Error("TAMathFCI",
         "Bit: The input SP state ouf of range, arr[%d]: %d", i, arr[i]);
     }
@@ -84,10 +84,7 @@ TABit &TABit::Create(int p){
       "Create: SP state %d to create a particle on \
 is out of range. nbit: %d", p, nbit);
   }
-  int np = 0; // number of particles
-  for(int i = 0; i < p; i++){
-    if(fBit[i/32] & (1 << i%32)) np++; // single-particle state i occupied
-  } // end for over i
+  const int np = NBelow(p); // number of particles below p
   if(fBit[p/32] & (1 << p%32)){ // single-particle state p is occupied
     fPhase = 0; // occupied in SPS p, cannot create on an occupied SPS
     return *this; // Pauli's exclusion principle
@@ -108,10 +105,7 @@ TABit &TABit::Annhilate(int p){
       "Annhilate: SP state %d to annhilate a particle on \
 is out of range. nbit: %d", p, nbit);
   }
-  int np = 0; // number of particles
-  for(int i = 0; i < p; i++){
-    if(fBit[i/32] & (1 << i%32)) np++; // single-particle state i occupied
-  } // end for over i
+  const int np = NBelow(p); // number of particles below p
   if(fBit[p/32] & (1 << p%32)){ // single-particle state p is occupied
     fBit[p/32] -= (1 << p%32); // a particle on SPS p annhilated
   }
@@ -144,6 +138,35 @@ int TABit::operator*(const TABit &bit) const{
   return phase; // the two states are parallel
 } // end of member function operator*
 
+/// \retval number of SP states occupied below p
+int TABit::NBelow(int p) const{
+  int n = 0;
+  for(int i = 0; i < p/32; i++) n += __builtin_popcount(fBit[i]);
+  if(p%32) n += __builtin_popcount(fBit[p/32] & ((1u << p%32) - 1));
+  return n;
+} // end of member function NBelow
+
+/// \retval whether the two have the same SP states occupied, phases aside
+bool TABit::SameBit(const TABit &bit) const{
+  return !memcmp(fBit, bit.fBit, sizeof(fBit));
+} // end of member function SameBit
+
+/// \retval a hash of the occupation
+unsigned long TABit::Hash() const{
+  unsigned long h = 14695981039346656037UL; // FNV-1a over the words
+  static const int nword = sizeof(fBit) / sizeof(unsigned);
+  for(int i = 0; i < nword; i++){ h ^= fBit[i]; h *= 1099511628211UL; }
+  return h;
+} // end of member function Hash
+
+/// \retval number of SP states occupied in *this but empty in bit
+int TABit::NDiff(const TABit &bit) const{
+  static const int nword = sizeof(fBit) / sizeof(unsigned);
+  int n = 0;
+  for(int i = 0; i < nword; i++) n += __builtin_popcount(fBit[i] & ~bit.fBit[i]);
+  return n;
+} // end of member function NDiff
+
 /// Print in bit
 void TABit::PrintInBit() const{
   static const int nbit = sizeof(fBit) * 8; // 1 byte = 8 bits
@@ -0,0 +1,429 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TABlockEigen.cxx
+  \class TABlockEigen
+  \brief Block eigensolvers for the lowest eigenpairs of a symmetric operator,
+  for when many states are wanted: O is applied to a block of k vectors at a
+  time by TAOperator::MultiplyBlock, so that each matrix element, stored or
+  computed on the fly, is loaded once and used k times. Two methods:
+  the block Lanczos method with full reorthogonalization, restarted from the
+  Ritz vectors once the Krylov space reaches its maximum size, and LOBPCG,
+  the locally optimal block preconditioned conjugate gradient (Knyazev),
+  here without a preconditioner, whose subspace [X, W, P] stays 3k wide. The
+  blocks are orthonormalized by TAMathFCI::TSQR, and distributed over the MPI
+  ranks as local segments, as in TALanczos. With SetCheckpoint(), the current
+  block is saved now and then, and a rerun starts from it.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include "TABlockEigen.h"
+#include "TACheckpoint.h"
+#include "TAOperator.h"
+#include "TAHamiltonian.h"
+#include "TAMathFCI.h"
+#include "TAMatrix.h"
+#include "TABLAS.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+TABlockEigen::TABlockEigen(TAOperator *op, EMethod method) : fOperator(op),
+    fMethod(method), fNEigen(1), fBlockSize(0), fMaxIteration(300),
+    fMaxBlock(20), fTolerance(1E-8), fCheckpointInterval(20), fCkp(nullptr),
+    fSlot(0), fNIteration(0), fNMultiply(0), fR0(0), fR1(0){
+  if(!fOperator) fOperator = TAHamiltonian::Instance();
+} // end of the constructor
+
+double TABlockEigen::GetEnergy(int i) const{
+  if(i < 0 || i >= int(fEnergy.size()))
+    TAException::Error("TABlockEigen", "GetEnergy: %d out of range [0, %d)",
+      i, int(fEnergy.size()));
+  return fEnergy[i];
+} // end of member function GetEnergy
+
+const vector<double> &TABlockEigen::GetVector(int i) const{
+  if(i < 0 || i >= int(fVector.size()))
+    TAException::Error("TABlockEigen", "GetVector: %d out of range [0, %d)",
+      i, int(fVector.size()));
+  return fVector[i];
+} // end of member function GetVector
+
+/// the local blocks interleaved, gathered, and multiplied all at once
+void TABlockEigen::Multiply(const double *x, int k, double *hx){
+  TAPROF_PHASE("TABlockEigen::Multiply");
+  const int n = fOperator->GetNBasis(), nl = fR1 - fR0;
+  fPack.resize(long(nl)*k);
+  for(int j = 0; j < k; j++) for(int i = 0; i < nl; i++)
+    fPack[long(i)*k + j] = x[i + long(j)*nl];
+  TAMPI::AllGather(fPack, fFull, n, k);
+  fOperator->MultiplyBlock(fFull, k, fW, fR0, fR1);
+  for(int j = 0; j < k; j++) for(int i = 0; i < nl; i++)
+    hx[i + long(j)*nl] = fW[long(i)*k + j];
+  fNMultiply += k;
+  fNIteration++;
+} // end of member function Multiply
+
+void TABlockEigen::Gram(const vector<const double *> &a,
+    const vector<const double *> &b, vector<double> &c) const{
+  const int m = a.size(), k = b.size(), nl = fR1 - fR0;
+  c.resize(long(m)*k);
+  for(int j = 0; j < k; j++)
+    TABLAS::MultiDot(a.data(), m, b[j], nl, c.data() + long(j)*m);
+  TAMPI::Sum(c);
+} // end of member function Gram
+
+/// block classical Gram-Schmidt, twice for the stability
+void TABlockEigen::Project(double *x, int k,
+    const vector<const double *> &q) const{
+  const int m = q.size(), nl = fR1 - fR0;
+  if(!m || !k) return;
+  vector<const double *> px(k);
+  for(int j = 0; j < k; j++) px[j] = x + long(j)*nl;
+  vector<double> c;
+  for(int pass = 0; pass < 2; pass++){
+    Gram(q, px, c);
+    for(double &ck : c) ck = -ck;
+    for(int j = 0; j < k; j++)
+      TABLAS::MultiAxpy(c.data() + long(j)*m, q.data(), m, x + long(j)*nl, nl);
+  } // end for over passes
+} // end of member function Project
+
+void TABlockEigen::Start(vector<double> &x, int k) const{
+  const int nl = fR1 - fR0;
+  x.resize(long(nl)*k);
+  for(int j = 0; j < k; j++) for(int i = 0; i < nl; i++){
+    unsigned long long z = (((unsigned long long)j) << 32) + fR0 + i +
+      0x9E3779B97F4A7C15ULL; // splitmix64
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    x[i + long(j)*nl] = double(z >> 11) / 9007199254740992. - 0.5;
+  } // end for over i and j
+} // end of member function Start
+
+bool TABlockEigen::Resume(vector<double> &x, int k){
+  if(!fCkp || !fCkp->GetNRecord()) return false;
+  if(fCkp->GetNRecord() != k){
+    TAException::Warn("TABlockEigen", "Resume: %ld vectors in %s, while the \
+block size is %d. Started anew.", fCkp->GetNRecord(),
+      fCkp->GetFile().c_str(), k);
+    return false;
+  } // end if
+  const int nl = fR1 - fR0;
+  x.resize(long(nl)*k);
+  vector<double> xl;
+  double theta = 0., theta0 = 0.;
+  for(int l = 0; l < k; l++){
+    fCkp->Read(l, &theta, xl);
+    std::copy(xl.begin(), xl.end(), x.begin() + long(l)*nl);
+    if(!l) theta0 = theta;
+  } // end for over l
+  TAINFO("TABlockEigen", "Resume: X from %s, E0: %f", fCkp->GetFile().c_str(),
+    theta0);
+  return true;
+} // end of member function Resume
+
+/// the slots [fSlot, fSlot+k) alternate between 0 and k, so that the X last
+/// committed is never overwritten before the new one is
+void TABlockEigen::Save(const vector<double> &x, const vector<double> &theta,
+    int k){
+  if(!fCkp) return;
+  const int nl = fR1 - fR0;
+  vector<double> rec;
+  rec.reserve(long(nl + 1)*k);
+  for(int l = 0; l < k; l++){
+    rec.push_back(theta[l]);
+    rec.insert(rec.end(), x.begin() + long(l)*nl, x.begin() + long(l + 1)*nl);
+  } // end for over l
+  fCkp->Write(std::move(rec), fSlot, fSlot, k);
+  fSlot = fSlot ? 0 : k;
+} // end of member function Save
+
+void TABlockEigen::Go(){
+  TAPROF_PHASE("TABlockEigen::Go");
+  const int n = fOperator->GetNBasis();
+  if(!n) TAException::Error("TABlockEigen", "Go: empty basis.");
+  TAMPI::Partition(n, fR0, fR1);
+  const int nl = fR1 - fR0;
+  const int nev = std::min(std::max(fNEigen, 1), n);
+  const int k = std::min(std::max(fBlockSize, nev), n);
+  fEnergy.clear(); fVector.clear();
+  fNIteration = fNMultiply = 0;
+  if(3*k < n){
+    std::unique_ptr<TACheckpoint> ckp;
+    if(fCheckpoint.size()){
+      ckp.reset(new TACheckpoint(fCheckpoint));
+      ckp->Open(n, fR0, fR1, 1, TACheckpoint::Fingerprint(fOperator));
+      fSlot = ckp->GetNRecord() && !ckp->GetFirst() ? k : 0;
+    } // end if
+    fCkp = ckp.get();
+    if(kLOBPCG == fMethod) LOBPCG(nev, k);
+    else BlockLanczos(nev, k);
+    fCkp = nullptr;
+  } // end if
+  else{ // too small a basis for the subspaces: O is diagonalized as a whole
+    TAMatrix2D h(n, n), P, v;
+    h = 0.;
+    vector<double> x, hx(long(nl)*k);
+    for(int b0 = 0; b0 < n; b0 += k){
+      const int kb = std::min(k, n - b0);
+      x.assign(long(nl)*kb, 0.);
+      for(int l = 0; l < kb; l++) if(b0 + l >= fR0 && b0 + l < fR1)
+        x[b0 + l - fR0 + long(l)*nl] = 1.;
+      Multiply(x.data(), kb, hx.data());
+      for(int l = 0; l < kb; l++) for(int i = 0; i < nl; i++)
+        h[fR0 + i][b0 + l] = hx[i + long(l)*nl];
+    } // end for over blocks
+    vector<double> hv(long(n)*n);
+    for(int i = fR0; i < fR1; i++)
+      std::copy(h.RowData(i), h.RowData(i) + n, hv.begin() + long(i)*n);
+    TAMPI::Sum(hv);
+    for(int i = 0; i < n; i++) for(int j = 0; j <= i; j++)
+      h[i][j] = h[j][i] = (hv[long(i)*n + j] + hv[long(j)*n + i]) / 2.;
+    TAMathFCI::EigenHouseholder(h, P, v);
+    for(int j = 0; j < nev; j++){
+      fEnergy.push_back(v[j][0]);
+      fVector.push_back(vector<double>(nl));
+      for(int i = 0; i < nl; i++) fVector[j][i] = P[fR0 + i][j];
+    } // end for over j
+  } // end else
+  for(int j = 0; j < int(fEnergy.size()); j++)
+    TAINFO("TABlockEigen", "Go: E[%d] = %f, block size: %d, O*X: %d, \
+ranks: %d", j, fEnergy[j], k, fNIteration, TAMPI::Size());
+} // end of member function Go
+
+/// Q_0 = X, then O*Q_j = sum_i Q_i*T_ij + Q_j+1*B_j: the new block is made
+/// orthogonal to all the former ones, twice, the coefficients giving the block
+/// tridiagonal T, and orthonormalized by TSQR, its R being B_j. The residual
+/// of the Ritz pair (theta, Q*z) is |B_j*z_j|, z_j the last k rows of z
+void TABlockEigen::BlockLanczos(int nev, int k){
+  TAPROF_PHASE("TABlockEigen::BlockLanczos");
+  const int n = fOperator->GetNBasis(), nl = fR1 - fR0;
+  const int maxBlock = std::min(std::max(fMaxBlock, 2), n / k);
+  vector<double> x;
+  if(!Resume(x, k)) Start(x, k);
+  TAMatrix2D R, R1, G, Z, v;
+  TAMathFCI::TSQR(x.data(), nl, k, R);
+  vector<vector<double> > Q; // the Lanczos blocks
+  vector<const double *> pq, pw(k);
+  vector<double> w(long(nl)*k), c, cc, z(k), res(k), theta(k);
+  TAMatrix2D T(maxBlock*k, maxBlock*k);
+  bool converged = false;
+  int nRestart = 0;
+  while(true){
+    Q.assign(1, x);
+    pq.clear();
+    T = 0.;
+    int m = 0; // the dimension of the Krylov space
+    bool full = false;
+    for(int j = 0; !full; j++){
+      m = (j + 1)*k;
+      for(int l = 0; l < k; l++) pq.push_back(Q[j].data() + long(l)*nl);
+      Multiply(Q[j].data(), k, w.data());
+      for(int l = 0; l < k; l++) pw[l] = w.data() + long(l)*nl;
+      c.assign(long(m)*k, 0.);
+      for(int pass = 0; pass < 2; pass++){
+        Gram(pq, pw, cc);
+        for(long l = 0; l < long(m)*k; l++){ c[l] += cc[l]; cc[l] = -cc[l]; }
+        for(int l = 0; l < k; l++)
+          TABLAS::MultiAxpy(cc.data() + long(l)*m, pq.data(), m,
+            w.data() + long(l)*nl, nl);
+      } // end for over passes
+      for(int l = 0; l < k; l++) for(int i = 0; i < m; i++)
+        T[i][j*k + l] = c[i + long(l)*m];
+      // once more if w is rank-deficient, whose Q out of TSQR then has
+      // columns not orthogonal to the former blocks: B_j = R2*R1 //
+      TAMathFCI::TSQR(w.data(), nl, k, R1);
+      Project(w.data(), k, pq);
+      TAMathFCI::TSQR(w.data(), nl, k, R);
+      R *= R1;
+
+      // the Ritz pairs, T symmetrized from its upper block triangle //
+      G.Resize(m, m);
+      for(int a = 0; a < m; a++) for(int b = 0; b < m; b++)
+        G[a][b] = a / k <= b / k ? T[a][b] : T[b][a];
+      TAMathFCI::EigenHouseholder(G, Z, v);
+      converged = true;
+      double resMax = 0.;
+      for(int i = 0; i < std::min(k, m); i++){
+        for(int r = 0; r < k; r++){
+          z[r] = 0.;
+          for(int l = r; l < k; l++) z[r] += R[r][l] * Z[j*k + l][i];
+        } // end for over r
+        res[i] = TABLAS::Nrm2(z.data(), k);
+        if(i < nev){
+          resMax = std::max(resMax, res[i]);
+          if(res[i] > fTolerance*std::max(1., fabs(v[i][0]))) converged = false;
+        } // end if
+      } // end for over i
+      TADEBUG("TABlockEigen", "BlockLanczos: block %d, E0: %f, residual: %g",
+        j, v[0][0], resMax);
+      full = converged || j + 1 == maxBlock || fNIteration >= fMaxIteration;
+      if(!full) Q.push_back(w);
+    } // end for over blocks
+
+    // the k lowest Ritz vectors, to output or to restart from //
+    x.assign(long(nl)*k, 0.);
+    for(int l = 0; l < k; l++){
+      for(int i = 0; i < m; i++) c[i] = Z[i][l];
+      TABLAS::MultiAxpy(c.data(), pq.data(), m, x.data() + long(l)*nl, nl);
+    } // end for over l
+    if(converged || fNIteration >= fMaxIteration) break;
+    for(int l = 0; l < k; l++) theta[l] = v[l][0];
+    Save(x, theta, k);
+    nRestart++;
+    TADEBUG("TABlockEigen", "BlockLanczos: restart %d", nRestart);
+  } // end while
+  if(!converged) TAException::Warn("TABlockEigen", "BlockLanczos: not \
+converged within %d block products, %d restarts", fNIteration, nRestart);
+  for(int j = 0; j < nev; j++){
+    fEnergy.push_back(v[j][0]);
+    fVector.push_back(vector<double>(x.begin() + long(j)*nl,
+      x.begin() + long(j + 1)*nl));
+  } // end for over j
+} // end of member function BlockLanczos
+
+/// Rayleigh-Ritz in the span of S = [X, W, P], all orthonormal: X the Ritz
+/// vectors, W the residuals O*x-theta*x of those not converged, and P the
+/// former step, the part of the new X out of the former one, orthonormalized
+/// in the small space of the coefficients (Hetmaniuk and Lehoucq), so that O*P
+/// comes out of O*S with no extra product
+void TABlockEigen::LOBPCG(int nev, int k){
+  TAPROF_PHASE("TABlockEigen::LOBPCG");
+  const int nl = fR1 - fR0;
+  vector<double> x, hx(long(nl)*k), w, hw, p, hp;
+  vector<double> xn, hxn, pn, hpn; // the new X and P
+  if(!Resume(x, k)) Start(x, k);
+  TAMatrix2D R, G, Z, v;
+  TAMathFCI::TSQR(x.data(), nl, k, R);
+  Multiply(x.data(), k, hx.data());
+  int nw = 0, np = 0;
+  vector<const double *> ps, phs, pxp;
+  vector<double> gram, c, res(k), theta(k), zp;
+  vector<bool> locked(k);
+  bool converged = false;
+  while(true){
+    // Rayleigh-Ritz //
+    const int m = k + nw + np;
+    ps.clear(); phs.clear();
+    for(int l = 0; l < k; l++){
+      ps.push_back(x.data() + long(l)*nl);
+      phs.push_back(hx.data() + long(l)*nl);
+    } // end for over l
+    for(int l = 0; l < nw; l++){
+      ps.push_back(w.data() + long(l)*nl);
+      phs.push_back(hw.data() + long(l)*nl);
+    } // end for over l
+    for(int l = 0; l < np; l++){
+      ps.push_back(p.data() + long(l)*nl);
+      phs.push_back(hp.data() + long(l)*nl);
+    } // end for over l
+    Gram(ps, phs, gram);
+    G.Resize(m, m);
+    for(int i = 0; i < m; i++) for(int j = 0; j <= i; j++)
+      G[i][j] = G[j][i] = (gram[i + long(j)*m] + gram[j + long(i)*m]) / 2.;
+    TAMathFCI::EigenHouseholder(G, Z, v);
+    xn.assign(long(nl)*k, 0.); hxn.assign(long(nl)*k, 0.);
+    c.resize(m);
+    for(int l = 0; l < k; l++){
+      theta[l] = v[l][0];
+      for(int i = 0; i < m; i++) c[i] = Z[i][l];
+      TABLAS::MultiAxpy(c.data(), ps.data(), m, xn.data() + long(l)*nl, nl);
+      TABLAS::MultiAxpy(c.data(), phs.data(), m, hxn.data() + long(l)*nl, nl);
+    } // end for over l
+    // the new P: the coefficients of the new X, those of X zeroed, made
+    // orthonormal to the new X and among themselves by Gram-Schmidt //
+    int npn = 0;
+    zp.resize(long(m)*k);
+    for(int l = 0; l < k && m > k; l++){
+      double *zl = zp.data() + long(npn)*m;
+      for(int i = 0; i < m; i++) zl[i] = i < k ? 0. : Z[i][l];
+      for(int pass = 0; pass < 2; pass++){
+        for(int q = 0; q < k; q++){
+          double s = 0.;
+          for(int i = 0; i < m; i++) s += Z[i][q] * zl[i];
+          for(int i = 0; i < m; i++) zl[i] -= s * Z[i][q];
+        } // end for over q
+        for(int q = 0; q < npn; q++){
+          const double *zq = zp.data() + long(q)*m;
+          const double s = TABLAS::Dot(zq, zl, m);
+          TABLAS::Axpy(-s, zq, zl, m);
+        } // end for over q
+      } // end for over passes
+      const double nrm = TABLAS::Nrm2(zl, m);
+      if(nrm < 1E-8) continue; // no new direction
+      TABLAS::Scal(1. / nrm, zl, m);
+      npn++;
+    } // end for over l
+    pn.assign(long(nl)*npn, 0.); hpn.assign(long(nl)*npn, 0.);
+    for(int l = 0; l < npn; l++){
+      TABLAS::MultiAxpy(zp.data() + long(l)*m, ps.data(), m,
+        pn.data() + long(l)*nl, nl);
+      TABLAS::MultiAxpy(zp.data() + long(l)*m, phs.data(), m,
+        hpn.data() + long(l)*nl, nl);
+    } // end for over l
+    x.swap(xn); hx.swap(hxn); p.swap(pn); hp.swap(hpn);
+    np = npn;
+
+    // the residuals, and the new W of those not converged //
+    w.assign(long(nl)*k, 0.);
+    for(int l = 0; l < k; l++){
+      double *wl = w.data() + long(l)*nl;
+      std::copy(hx.begin() + long(l)*nl, hx.begin() + long(l + 1)*nl, wl);
+      res[l] = TABLAS::AxpyDot(-theta[l], x.data() + long(l)*nl, wl, wl, nl);
+    } // end for over l
+    TAMPI::Sum(res);
+    converged = true;
+    double resMax = 0.;
+    nw = 0;
+    for(int l = 0; l < k; l++){
+      res[l] = sqrt(res[l]);
+      locked[l] = res[l] < fTolerance*std::max(1., fabs(theta[l]));
+      if(l < nev){
+        resMax = std::max(resMax, res[l]);
+        if(!locked[l]) converged = false;
+      } // end if
+      if(locked[l] || !res[l]) continue;
+      double *wn = w.data() + long(nw)*nl;
+      if(nw != l) std::copy(w.begin() + long(l)*nl, w.begin() + long(l + 1)*nl,
+        wn);
+      TABLAS::Scal(1. / res[l], wn, nl);
+      nw++;
+    } // end for over l
+    TADEBUG("TABlockEigen", "LOBPCG: iteration %d, E0: %f, residual: %g, \
+active: %d", fNIteration, theta[0], resMax, nw);
+    if(converged || fNIteration >= fMaxIteration || !nw) break;
+    if(fNIteration % std::max(fCheckpointInterval, 1) == 0) Save(x, theta, k);
+    pxp.clear();
+    for(int l = 0; l < k; l++) pxp.push_back(x.data() + long(l)*nl);
+    for(int l = 0; l < np; l++) pxp.push_back(p.data() + long(l)*nl);
+    for(int pass = 0; pass < 2; pass++){
+      Project(w.data(), nw, pxp);
+      TAMathFCI::TSQR(w.data(), nl, nw, R);
+    } // end for over passes
+    // drop the residuals that are already in span{X, P} //
+    int nk = 0;
+    for(int l = 0; l < nw; l++){
+      if(R[l][l] < 1E-8) continue;
+      if(nk != l) std::copy(w.begin() + long(l)*nl, w.begin() + long(l + 1)*nl,
+        w.begin() + long(nk)*nl);
+      nk++;
+    } // end for over l
+    nw = nk;
+    if(!nw) break;
+    hw.resize(long(nl)*nw);
+    Multiply(w.data(), nw, hw.data());
+  } // end while
+  if(!converged) TAException::Warn("TABlockEigen", "LOBPCG: not converged \
+within %d block products", fNIteration);
+  for(int j = 0; j < nev; j++){
+    fEnergy.push_back(theta[j]);
+    fVector.push_back(vector<double>(x.begin() + long(j)*nl,
+      x.begin() + long(j + 1)*nl));
+  } // end for over j
+} // end of member function LOBPCG
@@ -0,0 +1,169 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TACheckpoint.cxx
+  \class TACheckpoint
+  \brief A checkpoint file of an iterative eigensolver, from which a run killed
+  e.g. by a node failure resumes where it was. The file holds records of one
+  size, each nScalar numbers followed by the local segment of a vector, and a
+  header telling which of them are committed: [first, first+count). Write()
+  puts the records to disk in the background, and commits them, by rewriting
+  the header, only once they are all flushed, so that a crash at any moment
+  leaves the last complete checkpoint behind. Under MPI each rank writes its
+  own segments to a file of its own. The header also holds a fingerprint of
+  the operator, see Fingerprint(), so that a checkpoint of another basis or
+  Hamiltonian of the same dimension is never resumed from.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cstring>
+#include <unistd.h>
+#include "TACheckpoint.h"
+#include "TAOperator.h"
+#include "TAHamiltonian.h"
+#include "TAJumpTable.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+/// the file: kMagic, n, r0, r1, nScalar, fingerprint, first, count, then the
+/// records
+static const char kMagic[8] = {'S', 'U', 'N', 'N', 'Y', 'C', 'K', '2'};
+static const long kHeader = sizeof(kMagic) + 4*sizeof(int) +
+  sizeof(unsigned long);
+
+TACheckpoint::TACheckpoint(const string &file) : fFile(file),
+    fStream(nullptr), fNBasis(0), fR0(0), fR1(0), fNScalar(0),
+    fFingerprint(0), fFirst(0), fCount(0), fNextFirst(0), fNextCount(0){
+  if(TAMPI::Size() > 1) fFile += "." + std::to_string(TAMPI::Rank());
+} // end of the constructor
+
+TACheckpoint::~TACheckpoint(){
+  Wait();
+  if(fStream) fclose(fStream);
+} // end of the destructor
+
+long TACheckpoint::Offset(long slot) const{
+  return kHeader + 2*sizeof(long) + slot*(fNScalar + fR1 - fR0)*sizeof(double);
+} // end of member function Offset
+
+unsigned long TACheckpoint::Fingerprint(TAOperator *op){
+  if(!op) TAException::Error("TACheckpoint", "Fingerprint: op is nullptr");
+  const int n = op->GetNBasis();
+  int r0, r1;
+  TAMPI::Partition(n, r0, r1);
+  vector<double> x(n), y;
+  TAMPI::StartVector(0, n, 0, x.data());
+  op->Multiply(x, y, r0, r1);
+  vector<double> s(2, 0.);
+  for(int i = r0; i < r1; i++){
+    s[0] += x[i] * y[i-r0]; s[1] += y[i-r0] * y[i-r0];
+  } // end for over i
+  TAMPI::Sum(s);
+  unsigned long h = n, b[2];
+  memcpy(b, s.data(), sizeof(b)); // bit for bit: reruns are deterministic
+  for(unsigned long u : b) h = h * 1099511628211UL ^ u;
+  const TAHamiltonian *ham = dynamic_cast<const TAHamiltonian *>(op);
+  if(ham && ham->GetMBSDListM())
+    h = h * 1099511628211UL ^ TAJumpTable::Fingerprint(ham->GetMBSDListM());
+  return h;
+} // end of member function Fingerprint
+
+long TACheckpoint::Open(int n, int r0, int r1, int nScalar,
+    unsigned long fingerprint){
+  Wait();
+  if(fStream) fclose(fStream);
+  fNBasis = n; fR0 = r0; fR1 = r1; fNScalar = nScalar;
+  fFingerprint = fingerprint;
+  fFirst = fCount = 0;
+
+  // what is in the file already //
+  bool ok = false;
+  if((fStream = fopen(fFile.c_str(), "r+b"))){
+    char magic[sizeof(kMagic)];
+    int h[4];
+    unsigned long fp = 0;
+    ok = fread(magic, 1, sizeof(kMagic), fStream) == sizeof(kMagic) &&
+      !memcmp(magic, kMagic, sizeof(kMagic)) &&
+      fread(h, sizeof(int), 4, fStream) == 4 && h[0] == n && h[1] == r0 &&
+      h[2] == r1 && h[3] == nScalar &&
+      fread(&fp, sizeof(fp), 1, fStream) == 1 && fp == fingerprint &&
+      fread(&fFirst, sizeof(long), 1, fStream) == 1 &&
+      fread(&fCount, sizeof(long), 1, fStream) == 1 &&
+      fFirst >= 0 && fCount >= 0 && !fseek(fStream, 0, SEEK_END) &&
+      ftell(fStream) >= Offset(fFirst + fCount);
+  } // end if
+  // the records committed by all the ranks: the same first, the least count //
+  const int size = TAMPI::Size(), rank = TAMPI::Rank();
+  vector<double> c(2*size, 0.);
+  c[rank] = ok ? fFirst : -1.;
+  c[size + rank] = ok ? fCount : 0.;
+  TAMPI::Sum(c);
+  for(int i = 0; i < size; i++){
+    if(c[i] != c[rank]) ok = false;
+    if(c[size + i] < fCount) fCount = c[size + i];
+  } // end for over ranks
+  if(ok && fCount) return fCount;
+
+  // start anew //
+  if(fStream) fclose(fStream);
+  if(!(fStream = fopen(fFile.c_str(), "w+b")))
+    TAException::Error("TACheckpoint", "Open: cannot open %s", fFile.c_str());
+  fFirst = fCount = 0;
+  const int h[4] = {n, r0, r1, nScalar};
+  if(fwrite(kMagic, 1, sizeof(kMagic), fStream) != sizeof(kMagic) ||
+      fwrite(h, sizeof(int), 4, fStream) != 4 ||
+      fwrite(&fFingerprint, sizeof(fFingerprint), 1, fStream) != 1 ||
+      fwrite(&fFirst, sizeof(long), 1, fStream) != 1 ||
+      fwrite(&fCount, sizeof(long), 1, fStream) != 1 || fflush(fStream))
+    TAException::Error("TACheckpoint", "Open: writing %s failed.",
+      fFile.c_str());
+  return 0;
+} // end of member function Open
+
+void TACheckpoint::Read(long i, double *s, vector<double> &x){
+  if(!fStream || i < 0 || i >= fCount)
+    TAException::Error("TACheckpoint", "Read: record %ld not in [0, %ld)", i,
+      fCount);
+  x.resize(fR1 - fR0);
+  if(fseek(fStream, Offset(fFirst + i), SEEK_SET) ||
+      fread(s, sizeof(double), fNScalar, fStream) != size_t(fNScalar) ||
+      fread(x.data(), sizeof(double), x.size(), fStream) != x.size())
+    TAException::Error("TACheckpoint", "Read: record %ld of %s unreadable.",
+      i, fFile.c_str());
+} // end of member function Read
+
+void TACheckpoint::Write(vector<double> &&data, long at, long first,
+    long count){
+  if(!fStream) TAException::Error("TACheckpoint", "Write: Open() not called.");
+  if(data.size() % (fNScalar + fR1 - fR0))
+    TAException::Error("TACheckpoint", "Write: %ld numbers, not whole records \
+of %d", long(data.size()), fNScalar + fR1 - fR0);
+  Wait();
+  fNextFirst = first; fNextCount = count;
+  fPending = std::async(std::launch::async, &TACheckpoint::Flush, this,
+    std::move(data), at, first, count);
+} // end of member function Write
+
+/// the records are flushed to the disk before the header, so that the header
+/// never tells of records not written yet
+bool TACheckpoint::Flush(vector<double> data, long at, long first,
+    long count){
+  bool ok = !fseek(fStream, Offset(at), SEEK_SET) &&
+    fwrite(data.data(), sizeof(double), data.size(), fStream) == data.size() &&
+    !fflush(fStream) && !fsync(fileno(fStream));
+  ok = ok && !fseek(fStream, kHeader, SEEK_SET) &&
+    fwrite(&first, sizeof(long), 1, fStream) == 1 &&
+    fwrite(&count, sizeof(long), 1, fStream) == 1 &&
+    !fflush(fStream) && !fsync(fileno(fStream));
+  return ok;
+} // end of member function Flush
+
+void TACheckpoint::Wait(){
+  TAPROF_PHASE("TACheckpoint::Wait"); // the writing time not hidden
+  if(!fPending.valid()) return;
+  if(fPending.get()){ fFirst = fNextFirst; fCount = fNextCount; }
+  else TAException::Warn("TACheckpoint", "Wait: writing %s failed. Disk \
+full? The checkpoint is not updated.", fFile.c_str());
+} // end of member function Wait
@@ -0,0 +1,112 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAComponentMatrix.cxx
+  \class TAComponentMatrix
+  \brief The Hamiltonian H(lambda, mu) = H_1N + lambda*H_2N + mu*H_3N for scans
+  of the coupling strengths. The 1N, 2N and 3N parts are computed once and
+  stored in CSR form on one sparsity pattern, their values side by side, and
+  the product combines them on the fly, so that a new point of the scan costs
+  SetScale() instead of a new matrix. Under MPI only the rows of this rank are
+  stored. Best used with TALanczos::SetWarmStart(), which starts each point
+  from the eigenvectors of the previous one.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include "TAComponentMatrix.h"
+#include "TAHamiltonian.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+TAComponentMatrix::TAComponentMatrix() : fNBasis(0), fR0(0), fR1(0),
+    fNComponent(0), fLambda(1.), fMu(1.){
+  fPtr.assign(1, 0);
+} // end of the constructor
+
+void TAComponentMatrix::Build(TAHamiltonian *h){
+  TAPROF_PHASE("TAComponentMatrix::Build");
+  fNBasis = h->GetNBasis();
+  TAMPI::Partition(fNBasis, fR0, fR1);
+  fPtr.assign(1, 0); fCol.clear(); fVal.clear();
+  vector<int> cols;
+  vector<double> vals[3];
+  vector<bool> has(3, false); // whether the parts are there at all
+  for(int rr = fR0; rr < fR1; rr++){
+    h->ComponentRow(rr, cols, vals);
+    fCol.insert(fCol.end(), cols.begin(), cols.end());
+    fPtr.push_back(fCol.size());
+    for(int j = 0; j < int(cols.size()); j++) for(int k = 0; k < 3; k++){
+      fVal.push_back(vals[k][j]);
+      if(vals[k][j]) has[k] = true;
+    } // end for over j and k
+    TAPROF_PROGRESS("TAComponentMatrix::Build", rr - fR0 + 1, fR1 - fR0);
+  } // end for over rows
+  // drop the trailing parts absent on all the ranks //
+  fNComponent = 3;
+  while(fNComponent > 1 && !TAMPI::Sum(double(has[fNComponent-1])))
+    fNComponent--;
+  if(fNComponent < 3){
+    const long nnz = fCol.size();
+    for(long l = 0; l < nnz; l++) for(int k = 0; k < fNComponent; k++)
+      fVal[l*fNComponent + k] = fVal[l*3 + k];
+    fVal.resize(nnz*fNComponent);
+  } // end if
+
+  TAINFO("TAComponentMatrix", "Build: rows [%d, %d), nnz: %ld, %d parts, \
+%.1f MB", fR0, fR1, GetNNZ(), fNComponent, GetBytes() / 1048576.);
+} // end of member function Build
+
+/// w[i-r0] = sum_j <i|H(lambda, mu)|j>*v[j], for rows i in [r0, r1)
+void TAComponentMatrix::Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1){
+  TAPROF_PHASE("TAComponentMatrix::Multiply");
+  if(int(v.size()) != fNBasis || r0 < fR0 || r1 > fR1 || r0 > r1)
+    TAException::Error("TAComponentMatrix", "Multiply: |v|: %d, rows [%d, %d) \
+not within [%d, %d) stored", int(v.size()), r0, r1, fR0, fR1);
+  w.resize(r1 - r0);
+  const double c[3] = {1., fLambda, fMu};
+  const int nc = fNComponent;
+  const int *col = fCol.data();
+  const double *val = fVal.data();
+  for(int rr = r0; rr < r1; rr++){
+    double s = 0.;
+    for(long l = fPtr[rr-fR0]; l < fPtr[rr-fR0+1]; l++){
+      const double *x = val + l*nc;
+      double me = x[0];
+      for(int k = 1; k < nc; k++) me += c[k] * x[k];
+      s += me * v[col[l]];
+    } // end for over elements
+    w[rr-r0] = s;
+  } // end for over rows
+} // end of member function Multiply
+
+void TAComponentMatrix::MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1){
+  TAPROF_PHASE("TAComponentMatrix::MultiplyBlock");
+  if(long(v.size()) != long(fNBasis)*k || r0 < fR0 || r1 > fR1 || r0 > r1)
+    TAException::Error("TAComponentMatrix", "MultiplyBlock: |v|: %ld for %d \
+vectors, rows [%d, %d) not within [%d, %d) stored", long(v.size()), k, r0, r1,
+      fR0, fR1);
+  w.assign(long(r1 - r0)*k, 0.);
+  const double c[3] = {1., fLambda, fMu};
+  const int nc = fNComponent;
+  const int *col = fCol.data();
+  const double *val = fVal.data();
+  for(int rr = r0; rr < r1; rr++){
+    double *s = w.data() + long(rr - r0)*k;
+    for(long l = fPtr[rr-fR0]; l < fPtr[rr-fR0+1]; l++){
+      const double *x = val + l*nc;
+      double me = x[0];
+      for(int q = 1; q < nc; q++) me += c[q] * x[q];
+      const double *y = v.data() + long(col[l])*k;
+      for(int j = 0; j < k; j++) s[j] += me * y[j];
+    } // end for over elements
+  } // end for over rows
+} // end of member function MultiplyBlock
+
+long TAComponentMatrix::GetBytes() const{
+  return fVal.size()*sizeof(double) + fCol.size()*sizeof(int) +
+    fPtr.size()*sizeof(long);
+} // end of member function GetBytes
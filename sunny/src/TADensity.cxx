@@ -0,0 +1,91 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TADensity.cxx
+  \class TADensity
+  \brief One-body densities of the many-body states, e.g. the eigenvectors of
+  TALanczos: the (transition) density matrix rho_pq = <a|a+_p * a_q|b> for all
+  the (p,q) at once, and the occupation numbers n_p = <a|a+_p * a_p|a>. The
+  states are given as the local segments of TAMPI::Partition over the M-scheme
+  basis of TAManyBodySDManager. One sweep over the kets of this rank applies
+  all the a+_p * a_q conserving M by TAManyBodySDList::Apply, threaded with
+  OpenMP (cmake -DSUNNY_OPENMP=ON, the default) and summed over the ranks.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include "TADensity.h"
+#include "TAManyBodySDManager.h"
+#include "TAManyBodySDList.h"
+#include "TAManyBodySD.h"
+#include "TASingleParticleState.h"
+#include "TASingleParticleStateManager.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+/// rho[p][q] = <a|a+_p * a_q|b> = sum_j b_j * sum_i a_i * <i|a+_p * a_q|j>
+void TADensity::OneBody(const vector<double> &a, const vector<double> &b,
+    TAMatrix2D &rho){
+  TAPROF_PHASE("TADensity::OneBody");
+  const TAManyBodySDList *list =
+    TAManyBodySDManager::Instance()->GetMBSDListM();
+  const int n = list->GetNBasis();
+  int r0, r1;
+  TAMPI::Partition(n, r0, r1);
+  if(int(a.size()) != r1 - r0 || int(b.size()) != r1 - r0)
+    TAException::Error("TADensity", "OneBody: |a|: %d, |b|: %d, while the \
+local rows are [%d, %d)", int(a.size()), int(b.size()), r0, r1);
+  vector<double> full; // the whole bra
+  TAMPI::AllGather(a, full, n);
+
+  // a+_p * a_q conserving M, q varying slowest for the reuse in Apply //
+  const vector<TASingleParticleState *> &sp =
+    TASingleParticleStateManager::Instance()->GetSPStateVec();
+  const int nSP = sp.size();
+  vector<int> ops;
+  for(int q = 0; q < nSP; q++) for(int p = 0; p < nSP; p++)
+    if(sp[p]->GetMj() == sp[q]->GetMj()) ops.insert(ops.end(), {p, q});
+  const int nOp = ops.size() / 2;
+
+  vector<double> r(nSP*nSP, 0.);
+#pragma omp parallel
+  {
+    vector<double> rt(nSP*nSP, 0.); // of this thread
+    vector<int> phase(nOp), target(nOp);
+#pragma omp for schedule(dynamic, 64)
+    for(int j = r0; j < r1; j++){
+      const double bj = b[j-r0];
+      if(!bj) continue;
+      list->Apply(j, 1, ops.data(), nOp, phase.data(), target.data());
+      for(int i = 0; i < nOp; i++) if(phase[i])
+        rt[ops[2*i]*nSP + ops[2*i+1]] += full[target[i]] * phase[i] * bj;
+    } // end for over kets
+#pragma omp critical
+    for(int k = 0; k < nSP*nSP; k++) r[k] += rt[k];
+  } // end of the parallel region
+  TAMPI::Sum(r);
+  rho.Resize(nSP, nSP);
+  for(int p = 0; p < nSP; p++) for(int q = 0; q < nSP; q++)
+    rho[p][q] = r[p*nSP + q];
+} // end of member function OneBody
+
+/// n[p] = <a|a+_p * a_p|a> = sum_j a_j^2 * (p occupied in j)
+void TADensity::Occupation(const vector<double> &a, vector<double> &n){
+  const TAManyBodySDList *list =
+    TAManyBodySDManager::Instance()->GetMBSDListM();
+  const int nSP = TASingleParticleStateManager::Instance()->GetNSPState();
+  const int np = TAManyBodySD::GetNParticle();
+  int r0, r1;
+  TAMPI::Partition(list->GetNBasis(), r0, r1);
+  if(int(a.size()) != r1 - r0)
+    TAException::Error("TADensity", "Occupation: |a|: %d, while the local \
+rows are [%d, %d)", int(a.size()), r0, r1);
+  n.assign(nSP, 0.);
+  for(int j = r0; j < r1; j++){
+    const double w = a[j-r0] * a[j-r0];
+    const int *occ = (*list)[j]->IntArr();
+    for(int i = 0; i < np; i++) n[occ[i]] += w;
+  } // end for over kets
+  TAMPI::Sum(n);
+} // end of member function Occupation
@@ -4,14 +4,16 @@
 	\brief to print error, warnings, etc.
 	\author SUN Yazhou, asia.rabbit@163.com
 	\date Created: 2020/01/31
-	\date Last modified: 2020/02/28
+	\date Last modified: 2026/10/19
 	\copyright 2020, SUN Yazhou
 	\copyright SUNNY project, Anyang Normal University, IMP-CAS
 */
 
 
 #include <iostream>
+#include <string>
 #include <ctime>
+#include <cstdio>
 #include <stdarg.h> // variable arguments handle function declarations
 #include <cstdlib>
 #include "TAException.h"
@@ -20,11 +22,12 @@ using std::cout;
 using std::endl;
 
 // assignment and definition
-bool TAException::fIsSilent = false;
-bool TAException::fIsDebug = true;
+int TAException::fVerbose = TAException::kInfo;
+bool TAException::fIsPause = false;
+bool TAException::fIsInteractive = false;
 
 void TAException::Info(const char *cname, const char *fmt, ...){
-	if(fIsSilent) return;
+	if(fVerbose < kInfo) return;
 
 	va_list arg_ptr;
 	va_start(arg_ptr, fmt);
@@ -36,6 +39,21 @@ void TAException::Info(const char *cname, const char *fmt, ...){
 	cout << omsg;
 }
 
+// ask whether to go on after an error or a warning, in interactive mode only
+// \retval false if no more is to be asked
+static bool Ask(){
+	cout << "[q]: abort, [n]: do not stop any more, others: continue > "
+<< std::flush;
+	std::string str;
+	std::getline(std::cin, str);
+	cout << endl;
+	if(!str.empty() && str[0] == 'q'){
+		cout << "Aborting SUNNY...\n";
+		exit(1);
+	}
+	return str.empty() || str[0] != 'n';
+}
+
 void TAException::Error(const char *cname, const char *fmt, ...){
 	static bool nomore = false;
 	if(nomore) return;
@@ -47,28 +65,19 @@ void TAException::Error(const char *cname, const char *fmt, ...){
 \033[31;1m %s\n\033[0m", cname, fmt);
 	vsprintf(omsg, msg, arg_ptr);
 	va_end(arg_ptr);
-	cout << omsg;
+	cout << omsg << std::flush;
 
-	// select repeatability
-	if(!nomore){
-		cout << "[q]: abort, [n]: do not stop any more, others: continue > "
-<< std::flush;
-		std::string str;
-		std::getline(std::cin, str);
-		if(!str.empty() && (str.c_str())[0] == 'q'){
-			cout << "Aborting SUNNY...\n";
-			exit(1);
-		}
-		else if(!str.empty() && (str.c_str())[0] == 'n'){
-			nomore = true;
-		}
-		cout << endl;
+	// a batch run stops here, an interactive one may go on
+	if(!fIsInteractive){
+		cout << "Aborting SUNNY...\n";
+		exit(1);
 	}
+	nomore = !Ask();
 }
 
 void TAException::Warn(const char *cname, const char *fmt, ...){
 	static bool nomore = false;
-	if(nomore) return;
+	if(fVerbose < kWarn) return;
 
 	va_list arg_ptr;
 	va_start(arg_ptr, fmt);
@@ -77,27 +86,13 @@ void TAException::Warn(const char *cname, const char *fmt, ...){
 \033[0m\033[36;1m %s\n\033[0m", cname, fmt);
 	vsprintf(omsg, msg, arg_ptr);
 	va_end(arg_ptr);
-	cout << omsg;
+	cout << omsg << std::flush;
 
-	// select repeatability
-	if(!nomore){
-		cout << "[q]: abort, [n]: do not stop any more, others: continue > "
-<< std::flush;
-		std::string str;
-		std::getline(std::cin, str);
-		if(!str.empty() && (str.c_str())[0] == 'q'){
-			cout << "Aborting SUNNY...\n";
-			exit(1);
-		}
-		else if(!str.empty() && (str.c_str())[0] == 'n'){
-			nomore = true;
-		}
-		cout << endl;
-	}
+	if(fIsInteractive && !nomore) nomore = !Ask();
 }
 
 void TAException::Debug(const char *cname, const char *fmt, ...){
-	if(!fIsDebug) return;
+	if(fVerbose < kDebug) return;
 
 	va_list arg_ptr;
 	va_start(arg_ptr, fmt);
@@ -107,6 +102,12 @@ void TAException::Debug(const char *cname, const char *fmt, ...){
 	va_end(arg_ptr);
 	cout << omsg;
 
-	cout << "Press ENTER to continue...";
+	Pause();
+}
+
+// wait for ENTER, only if pausing is enabled
+void TAException::Pause(){
+	if(!fIsPause) return;
+	cout << "Press ENTER to continue..." << std::flush;
 	getchar();
 }
@@ -15,6 +15,8 @@
 #include "TAFCI.h"
 #include "TAHamiltonian.h"
 #include "TAMathFCI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
 
 TAFCI *TAFCI::kInstance = nullptr;
 
@@ -33,7 +35,7 @@ void TAFCI::Go(){
   fHamiltonian->InitializeCoefficient(); // DEBUG
   TAMatrix2D &H = fHamiltonian->Matrix();
 //  for(int i = H.nrow(); i--;) H[i][i] -= 16.;
-  H.Print();
+  TADEBUG_DO(H.Print());
 
   const int n = H.ncol();
   TAMatrix2D v(n);
@@ -62,4 +64,6 @@ void TAFCI::Go(){
   // Jacobi method to calculate all the eigenvalues and eigenvectors of a matrix
   TAMatrix2D P(n, n);
   TAMathFCI::EigenJacobi(A, P, vv);
+
+  TAPROF_EXPORT("sunny_profile.json");
 } // end of member function Go
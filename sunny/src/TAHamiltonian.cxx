@@ -14,18 +14,23 @@
   \copyright SUNNY project, Anyang Normal University, IMP-CAS
 */
 
+#include <algorithm>
 #include "TAManyBodySD.h"
 #include "TAHamiltonian.h"
 #include "TAManyBodySDList.h"
 #include "TAManyBodySDManager.h"
 #include "TASingleParticleState.h"
 #include "TASingleParticleStateManager.h"
+#include "TAJumpTable.h"
+#include "TAProfiler.h"
 
 
 TAHamiltonian *TAHamiltonian::kInstance = nullptr;
 
 TAHamiltonian::TAHamiltonian() : fCoe1N(0), fCoe2N(0), fCoe3N(0),
-  fMBSDListM(0), fMatrix(0), fNSPState(0), fNMBSD(0){
+  fMBSDListM(0), fMatrix(0), fNSPState(0), fNMBSD(0), fRowCacheSize(1L<<22),
+  fRowCacheNNZ(0), fOpReady(false), fOpVersion(0),
+  fJumpTable(nullptr), fJumpReady(false){
   // prepare the basis of the representation //
   TAManyBodySDManager *mbsdManager = TAManyBodySDManager::Instance();
   mbsdManager->MSchemeGo(); // generate many-body basis
@@ -51,6 +56,7 @@ TAMatrix2D &TAHamiltonian::Matrix(){
   if(fMatrix && !fMatrix->IsEmpty()){
     return *fMatrix;
   }
+  TAPROF_PHASE("TAHamiltonian::Matrix");
   if(!fCoe1N){
     TAException::Error("TAHamiltonian",
       "Matrix: 1-body operator coefficient matrix not assigned.");
@@ -73,6 +79,10 @@ TAMatrix2D &TAHamiltonian::Matrix(){
   // loop to generate each matrix element for the hamiltonian //
   if(fMatrix){ delete fMatrix; fMatrix = nullptr; }
   fMatrix = new TAMatrix2D(fNMBSD, fNMBSD); // allot memery to a nxn matrix
+  if(JumpTable()){ // gathered from the jumps
+    fJumpTable->Matrix(*fMatrix);
+    return *fMatrix;
+  } // end if
   // initialize to a specific initial value //
   for(int i = fNMBSD; i--;) for(int j = fNMBSD; j--;) (*fMatrix)[i][j] = -9999.;
 
@@ -80,6 +90,12 @@ TAMatrix2D &TAHamiltonian::Matrix(){
     for(int cc = 0; cc < fNMBSD; cc++){
       MatrixElement(rr, cc); // assign matrix element H[i][j]
     } // end for over columns
+#ifdef SUNNY_PROFILE
+    int nnz = 0;
+    for(int cc = 0; cc < fNMBSD; cc++) if((*fMatrix)[rr][cc]) nnz++;
+    TAPROF_ROW(nnz);
+#endif
+    TAPROF_PROGRESS("TAHamiltonian::Matrix", rr + 1, fNMBSD);
   } // end for over rows
 
   return *fMatrix;
@@ -94,87 +110,356 @@ void TAHamiltonian::MatrixElement(int rr, int cc){
     (*fMatrix)[rr][cc] = (*fMatrix)[cc][rr];
     return;
   }
-  (*fMatrix)[rr][cc] = MatrixElement1N(rr, cc) +
-    MatrixElement2N(rr, cc) + MatrixElement3N(rr, cc);
+  (*fMatrix)[rr][cc] = Element(rr, cc);
 } // end of member function MatrixElement
 
+/// w[i-r0] = sum_j <i|H|j>*v[j], for rows i in [r0, r1)
+void TAHamiltonian::Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1){
+  TAPROF_PHASE("TAHamiltonian::Multiply");
+  if(int(v.size()) != fNMBSD || r0 < 0 || r1 > fNMBSD || r0 > r1)
+    TAException::Error("TAHamiltonian", "Multiply: |v|: %d, rows [%d, %d), \
+fNMBSD: %d", int(v.size()), r0, r1, fNMBSD);
+  const bool stored = fMatrix && !fMatrix->IsEmpty();
+  if(!stored && JumpTable()){
+    fJumpTable->Multiply(v, w, r0, r1);
+    return;
+  } // end if
+  w.assign(r1 - r0, 0.);
+  // the rows generated right here, each used once: a sweep over all of them
+  // would only churn the LRU cache of Row(), kept for random access //
+  vector<int> col;
+  vector<double> val;
+  for(int rr = r0; rr < r1; rr++){
+    double s = 0.;
+    if(stored){
+      const double *h = fMatrix->RowData(rr);
+      for(int cc = 0; cc < fNMBSD; cc++) s += h[cc] * v[cc];
+    } // end if
+    else{
+      SparseRow(rr, col, val);
+      for(int k = col.size(); k--;) s += val[k] * v[col[k]];
+    } // end else
+    w[rr-r0] = s;
+  } // end for over rows
+} // end of member function Multiply
+
+void TAHamiltonian::MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1){
+  TAPROF_PHASE("TAHamiltonian::MultiplyBlock");
+  if(long(v.size()) != long(fNMBSD)*k || r0 < 0 || r1 > fNMBSD || r0 > r1)
+    TAException::Error("TAHamiltonian", "MultiplyBlock: |v|: %ld for %d \
+vectors, rows [%d, %d), fNMBSD: %d", long(v.size()), k, r0, r1, fNMBSD);
+  const bool stored = fMatrix && !fMatrix->IsEmpty();
+  if(!stored && JumpTable()){
+    fJumpTable->MultiplyBlock(v, k, w, r0, r1);
+    return;
+  } // end if
+  w.assign(long(r1 - r0)*k, 0.);
+  const double *pv = v.data();
+  vector<int> col; // the rows generated as in Multiply
+  vector<double> val;
+  for(int rr = r0; rr < r1; rr++){
+    double *s = w.data() + long(rr - r0)*k;
+    if(stored){
+      const double *h = fMatrix->RowData(rr);
+      for(int cc = 0; cc < fNMBSD; cc++){
+        const double a = h[cc], *x = pv + long(cc)*k;
+        if(a) for(int j = 0; j < k; j++) s[j] += a * x[j];
+      } // end for over columns
+      continue;
+    } // end if
+    SparseRow(rr, col, val);
+    for(int l = col.size(); l--;){
+      const double a = val[l], *x = pv + long(col[l])*k;
+      for(int j = 0; j < k; j++) s[j] += a * x[j];
+    } // end for over elements
+  } // end for over rows
+} // end of member function MultiplyBlock
+
+/// the non-zero elements of row rr, <rr|H|cols[k]> = vals[k], cols ascending
+void TAHamiltonian::SparseRow(int rr, vector<int> &cols, vector<double> &vals){
+  if(rr < 0 || rr >= fNMBSD)
+    TAException::Error("TAHamiltonian", "SparseRow: row %d not in [0, %d)",
+      rr, fNMBSD);
+  cols.clear(); vals.clear();
+  if(fMatrix && !fMatrix->IsEmpty()){
+    const double *h = fMatrix->RowData(rr);
+    for(int cc = 0; cc < fNMBSD; cc++)
+      if(h[cc]){ cols.push_back(cc); vals.push_back(h[cc]); }
+    return;
+  } // end if
+  if(!fCoe1N)
+    TAException::Error("TAHamiltonian",
+      "SparseRow: 1-body operator coefficient matrix not assigned.");
+  // only the SDs a k-body H reaches from rr, by at most k excitations //
+  fMBSDListM->Coupled(rr, fCoe3N ? 3 : (fCoe2N ? 2 : 1), cols);
+  int n = 0;
+  for(int cc : cols){
+    const double me = Element(rr, cc);
+    if(me){ cols[n++] = cc; vals.push_back(me); }
+  } // end for over the coupled SDs
+  cols.resize(n);
+} // end of member function SparseRow
+
+/// the non-zero elements of row rr by the 1N, 2N and 3N parts of H
+void TAHamiltonian::ComponentRow(int rr, vector<int> &cols,
+    vector<double> vals[3]){
+  if(rr < 0 || rr >= fNMBSD)
+    TAException::Error("TAHamiltonian", "ComponentRow: row %d not in [0, %d)",
+      rr, fNMBSD);
+  if(!fCoe1N)
+    TAException::Error("TAHamiltonian",
+      "ComponentRow: 1-body operator coefficient matrix not assigned.");
+  cols.clear();
+  for(int k = 0; k < 3; k++) vals[k].clear();
+  const TABit &bit = (*fMBSDListM)[rr]->Bit();
+  // a k-body operator connects SDs differing in at most k SP states //
+  vector<int> coupled;
+  fMBSDListM->Coupled(rr, fCoe3N ? 3 : (fCoe2N ? 2 : 1), coupled);
+  for(int cc : coupled){
+    const int nDiff = bit.NDiff((*fMBSDListM)[cc]->Bit());
+    const double me1 = nDiff <= 1 ? MatrixElement1N(rr, cc) : 0.;
+    const double me2 = nDiff <= 2 ? MatrixElement2N(rr, cc) : 0.;
+    const double me3 = MatrixElement3N(rr, cc);
+    if(!me1 && !me2 && !me3) continue;
+    cols.push_back(cc);
+    vals[0].push_back(me1); vals[1].push_back(me2); vals[2].push_back(me3);
+  } // end for over columns
+} // end of member function ComponentRow
+
+/// \retval row rr, computed on first demand and kept in an LRU cache
+/// The row is computed outside the lock, so that threads may compute rows at
+/// once; a row computed meanwhile by another thread is taken instead
+shared_ptr<const TAHamiltonian::TARow> TAHamiltonian::Row(int rr){
+  {
+    std::lock_guard<std::mutex> lock(fRowMutex);
+    auto it = fRowCache.find(rr);
+    if(it != fRowCache.end()){ // move to the front of the LRU list
+      TAPROF_COUNT(kRowCacheHit);
+      fRowLRU.splice(fRowLRU.begin(), fRowLRU, it->second.second);
+      return it->second.first;
+    } // end if
+  }
+  TAPROF_COUNT(kRowCacheMiss);
+  shared_ptr<TARow> row(new TARow);
+  SparseRow(rr, row->col, row->val);
+  if(fRowCacheSize <= 0) return row;
+
+  std::lock_guard<std::mutex> lock(fRowMutex);
+  auto it = fRowCache.find(rr);
+  if(it != fRowCache.end()) return it->second.first;
+  // evict the least recently used rows to make room //
+  const long nnz = row->col.size();
+  while(fRowLRU.size() && fRowCacheNNZ + nnz > fRowCacheSize){
+    auto last = fRowCache.find(fRowLRU.back());
+    fRowCacheNNZ -= last->second.first->col.size();
+    fRowCache.erase(last);
+    fRowLRU.pop_back();
+  } // end while
+  fRowLRU.push_front(rr);
+  fRowCache[rr] = std::make_pair(row, fRowLRU.begin());
+  fRowCacheNNZ += nnz;
+  return row;
+} // end of member function Row
+
+/// rows [r0, r1) in rows[0, r1-r0)
+void TAHamiltonian::Rows(int r0, int r1,
+    vector<shared_ptr<const TARow> > &rows){
+  rows.resize(r1 > r0 ? r1 - r0 : 0);
+  for(int rr = r0; rr < r1; rr++) rows[rr-r0] = Row(rr);
+} // end of member function Rows
+
+void TAHamiltonian::SetRowCacheSize(long nnz){
+  std::lock_guard<std::mutex> lock(fRowMutex);
+  fRowCacheSize = nnz;
+  while(fRowLRU.size() && fRowCacheNNZ > fRowCacheSize){
+    auto last = fRowCache.find(fRowLRU.back());
+    fRowCacheNNZ -= last->second.first->col.size();
+    fRowCache.erase(last);
+    fRowLRU.pop_back();
+  } // end while
+} // end of member function SetRowCacheSize
+
+void TAHamiltonian::ClearRowCache(){
+  std::lock_guard<std::mutex> lock(fRowMutex);
+  fRowCache.clear(); fRowLRU.clear(); fRowCacheNNZ = 0;
+} // end of member function ClearRowCache
+
+/// \retval <row|H|cc>, by bisection
+double TAHamiltonian::TARow::operator()(int cc) const{
+  auto it = std::lower_bound(col.begin(), col.end(), cc);
+  if(it == col.end() || *it != cc) return 0.;
+  return val[it - col.begin()];
+} // end of member function operator()
+
+/// \retval <rr|H|cc>, calculated on the fly without touching fMatrix
+double TAHamiltonian::Element(int rr, int cc){
+  if(!fCoe1N){
+    TAException::Error("TAHamiltonian",
+      "Element: 1-body operator coefficient matrix not assigned.");
+  }
+  TAPROF_COUNT(kElement);
+  // a k-body operator connects SDs differing in at most k SP states //
+  const int nDiff =
+    (*fMBSDListM)[rr]->Bit().NDiff((*fMBSDListM)[cc]->Bit());
+  if(nDiff > (fCoe3N ? 3 : (fCoe2N ? 2 : 1))){
+    TAPROF_COUNT(kElementPruned);
+    return 0.;
+  } // end if
+  double me = MatrixElement3N(rr, cc);
+  if(nDiff <= 2) me += MatrixElement2N(rr, cc);
+  if(nDiff <= 1) me += MatrixElement1N(rr, cc);
+  return me;
+} // end of member function Element
+
 /// \retval calculate and return the 1-body part (t+u) of the ME for H
 double TAHamiltonian::MatrixElement1N(int rr, int cc){
-  double me = 0., phase, force;
-  for(int p = 0; p < fNSPState; p++){
-    for(int q = 0; q < fNSPState; q++){
-      /// Integral(rr, p, q, cc): <rr|a+_p * a_q|cc>
-      if(!(phase = fMBSDListM->Integral(rr, p, q, cc)) ||
-         !(force = (*fCoe1N)[p][q]) ) continue;
-      me += force * phase;
-    } // end for over annhilation operators a_q
-  } // end for over creation operators a+_p
-  return me;
+  TAPROF_COUNT(kElement1N);
+  return PartElement(0, rr, cc);
 } // end member function MatrixElement1N
 
 /// \retval calculate and return the 2-body part v(r1, r2) of the ME for H
 double TAHamiltonian::MatrixElement2N(int rr, int cc){
-  double me = 0., phase, force;
   if(!fCoe2N) return 0.; // 2N force is not assigned
-  for(int p = 0; p < fNSPState; p++){
+  TAPROF_COUNT(kElement2N);
+  return PartElement(1, rr, cc);
+} // end member function MatrixElement2N
+
+/// the 1N, 2N and 3N terms of H as the adjoint operator strings, the
+/// annihilators varying slowest so that TAManyBodySDList::Apply reuses the
+/// partial products
+void TAHamiltonian::BuildOpString(){
+  for(int k = 0; k < 3; k++){ fOp[k].clear(); fOpCoe[k].clear(); }
+  // <rr|a+_p * a_q|cc> = <cc|a+_q * a_p|rr> //
+  for(int p = 0; p < fNSPState; p++) for(int q = 0; q < fNSPState; q++){
+    const double force = (*fCoe1N)[p][q];
+    if(!force) continue;
+    fOp[0].insert(fOp[0].end(), {q, p});
+    fOpCoe[0].push_back(force);
+  } // end for over p and q
+  // <rr|a+_p*a+_q * a_s*a_r|cc> = <cc|a+_r*a+_s * a_q*a_p|rr>, 4 = (2!)^2 //
+  if(fCoe2N) for(int p = 0; p < fNSPState; p++){
     for(int q = 0; q < fNSPState; q++){
       if(q == p) continue; // Pauli's exclusion principle
-      for(int r = 0; r < fNSPState; r++){ // -------------------------------
-        for(int s = 0; s < fNSPState; s++){
-          if(s == r) continue; // Pauli's exclusion principle
-          /// Integral(rr, p, q, r, s, cc): <rr|a+_p*a+_q * a_s*a_r|cc>
-          if(!(phase = fMBSDListM->Integral(rr, p, q, s, r, cc)) ||
-             !(force = (*fCoe2N)[p][q][r][s]) ) continue;
-//          cout << "<rr|p+ q+ s r|cc>" << endl; // DEBUG
-//          printf("<%d|%d+ %d+ %d %d|%d>\n", rr, p, q, s, r, cc); // DEBUG
-//          cout << "force: " << force << " phase: " << phase << endl; // DEBUG
-//          getchar(); // DEBUG
-          me += force * phase;
-        } // end for over annhilation operators a_s
-      } // end for over annhilation operators a_r // -----------------------
-    } // end for over creation operators a+_q
-  } // end for over creation operators a+_p
-//  TAException::Debug("Mark1", "rr: %d, cc: %d, me: %f", rr, cc, me); // DEBUG
-  return me / 4.; // 4 = (2!)^2
-} // end member function MatrixElement2N
+      for(int r = 0; r < fNSPState; r++) for(int s = 0; s < fNSPState; s++){
+        if(s == r) continue; // Pauli's exclusion principle
+        const double force = (*fCoe2N)[p][q][r][s];
+        if(!force) continue;
+        fOp[1].insert(fOp[1].end(), {r, s, q, p});
+        fOpCoe[1].push_back(force / 4.);
+      } // end for over r and s
+    } // end for over q
+  } // end for over p
+  // <rr|a+_p*a+_q*a+_r * a_u*a_t*a_s|cc> =
+  // <cc|a+_s*a+_t*a+_u * a_r*a_q*a_p|rr>, 36 = (3!)^2 //
+  if(fCoe3N) for(int p = 0; p < fNSPState; p++){
+    for(int q = 0; q < fNSPState; q++){
+      if(q == p) continue; // Pauli's exclusion principle
+      for(int r = 0; r < fNSPState; r++){
+        if(r == p || r == q) continue; // Pauli's exclusion principle
+        for(int s = 0; s < fNSPState; s++) for(int t = 0; t < fNSPState; t++){
+          if(t == s) continue; // Pauli's exclusion principle
+          for(int u = 0; u < fNSPState; u++){
+            if(u == s || u == t) continue; // Pauli's exclusion principle
+            const double force = (*fCoe3N)[p][q][r][s][t][u];
+            if(!force) continue;
+            fOp[2].insert(fOp[2].end(), {s, t, u, r, q, p});
+            fOpCoe[2].push_back(force / 36.);
+          } // end for over u
+        } // end for over s and t
+      } // end for over r
+    } // end for over q
+  } // end for over p
+  fOpReady = true;
+} // end of member function BuildOpString
+
+void TAHamiltonian::ClearOpString(){
+  fOpReady = false;
+  fOpVersion++; // the rows kept by PartElement are out of date
+  fJumpReady = false;
+} // end of member function ClearOpString
+
+/// the rows of H_1N, H_2N and H_3N last computed on a thread, see PartElement
+struct TAPartRow{
+  TAPartRow() : h(nullptr), version(-1), row{-1, -1, -1}{}
+  const TAHamiltonian *h; ///< the H and its fOpVersion they are of
+  long version;
+  int row[3];
+  /// row[k] of H_k, sparse: <row[k]|H_k|col[k][j]> = val[k][j], col ascending
+  vector<int> col[3];
+  vector<double> val[3];
+  /// scratch for the operator strings applied: the phases, and the columns
+  /// reached, paired with their terms for the merge
+  vector<int> phase, target;
+  vector<std::pair<int, double> > term;
+};
+
+/// \retval <rr|H_k|cc>, from the row rr of H_k as a whole
+double TAHamiltonian::PartElement(int k, int rr, int cc){
+  if(!fOpReady){
+    std::lock_guard<std::mutex> lock(fOpMutex);
+    if(!fOpReady) BuildOpString();
+  } // end if
+  static thread_local TAPartRow pr;
+  if(pr.h != this || pr.version != fOpVersion){
+    pr.h = this; pr.version = fOpVersion;
+    pr.row[0] = pr.row[1] = pr.row[2] = -1;
+  } // end if
+  vector<int> &col = pr.col[k];
+  vector<double> &val = pr.val[k];
+  if(rr != pr.row[k]){
+    const int nOp = fOpCoe[k].size();
+    pr.phase.resize(nOp); pr.target.resize(nOp);
+    fMBSDListM->Apply(rr, k + 1, fOp[k].data(), nOp, pr.phase.data(),
+      pr.target.data());
+    // the terms sorted by column and those of the same column summed up //
+    pr.term.clear();
+    for(int i = 0; i < nOp; i++) if(pr.phase[i])
+      pr.term.emplace_back(pr.target[i], fOpCoe[k][i] * pr.phase[i]);
+    std::sort(pr.term.begin(), pr.term.end(),
+      [](const std::pair<int, double> &a, const std::pair<int, double> &b){
+        return a.first < b.first; });
+    col.clear(); val.clear();
+    for(const std::pair<int, double> &t : pr.term){
+      if(col.size() && col.back() == t.first) val.back() += t.second;
+      else{ col.push_back(t.first); val.push_back(t.second); }
+    } // end for over terms
+    pr.row[k] = rr;
+  } // end if
+  auto it = std::lower_bound(col.begin(), col.end(), cc);
+  if(it == col.end() || *it != cc) return 0.;
+  return val[it - col.begin()];
+} // end of member function PartElement
 
 /// \retval calculate and return the 3-body part v(r1,r2,r3) of the ME for H
 double TAHamiltonian::MatrixElement3N(int rr, int cc){
   if(!fCoe3N) return 0.; // 3N force is not needed
-  double me = 0., phase, force;
-  for(int p = 0; p < fNSPState; p++){
-    for(int q = 0; q < fNSPState; q++){
-      if(p == q) continue; // Pauli's exclusion principle
-      for(int r = 0; r < fNSPState; r++){
-        if(r == p || r == q) continue; // Pauli's exclusion principle
-        for(int s = 0; s < fNSPState; s++){ // -----------------------------
-          for(int t = 0; t < fNSPState; t++){
-            if(t == s) continue; // Pauli's exclusion principle
-            for(int u = 0; u < fNSPState; u++){
-              if(u == s || u == t) continue; // Pauli's exclusion principle
-              /// Integral(rr, p, q, r, s, t, u, cc):
-              /// <rr|a+_p*a+_q*a+_r * a_u*a_t*a_s|cc>
-              if(!(phase = fMBSDListM->Integral(rr, p, q, r, u, t, s, cc)) ||
-                 !(force = (*fCoe3N)[p][q][r][s][t][u]) ) continue;
-              me += force * phase;
-            } // end for over annhilation operators a_u
-          } // end for over annhilation operators a_t
-        } // end for over annhilation operators a_s // ---------------------
-      } // end for over creation operators a+_r
-    } // end for over creation operators a+_q
-  } // end for over creation operators a+_p
-  return me / 36.; // 36 = (3!)^2
+  TAPROF_COUNT(kElement3N);
+  return PartElement(2, rr, cc);
 } // end member function MatrixElement3N
 
 void TAHamiltonian::SetCoe1N(const TAMatrix2D &coe1N){
+  ClearRowCache();
+  ClearOpString();
+  if(fMatrix){ delete fMatrix; fMatrix = nullptr; } // of the former H
+  fJumpReady = false;
   if(fCoe1N){ delete fCoe1N; fCoe1N = nullptr; }
   fCoe1N = new TAMatrix2D(coe1N);
 } // end of member function SetCoe1N
 void TAHamiltonian::SetCoe2N(const TAMatrix4D &coe2N){
+  ClearRowCache();
+  ClearOpString();
+  if(fMatrix){ delete fMatrix; fMatrix = nullptr; } // of the former H
+  fJumpReady = false;
   if(fCoe2N){ delete fCoe2N; fCoe2N = nullptr; }
   fCoe2N = new TAMatrix4D(coe2N);
 } // end of member function SetCoe2N
 void TAHamiltonian::SetCoe3N(const TAMatrix6D &coe3N){
+  ClearRowCache();
+  ClearOpString();
+  if(fMatrix){ delete fMatrix; fMatrix = nullptr; } // of the former H
+  fJumpReady = false;
   if(fCoe3N){ delete fCoe3N; fCoe3N = nullptr; }
   fCoe3N = new TAMatrix6D(coe3N);
 } // end of member function SetCoe3N
@@ -183,16 +468,48 @@ void TAHamiltonian::SetMBSDListM(TAManyBodySDList *mbsd){
     TAException::Error("TAHamiltonian", "SetMBSDListM: Input pointer is null.");
   }
   fMBSDListM = mbsd;
+  fNMBSD = mbsd->GetNBasis();
+  if(fMatrix){ delete fMatrix; fMatrix = nullptr; } // of the former basis
+  fJumpTable = nullptr; // built on the former basis
+  ClearRowCache();
+  ClearOpString();
 } // end of member function SetMBSDListM
 
+void TAHamiltonian::SetJumpTable(TAJumpTable *table){
+  if(table && table->GetNBasis() != fMBSDListM->GetNBasis())
+    TAException::Error("TAHamiltonian", "SetJumpTable: the table is of \
+dimension %d, while the basis is of %d", table->GetNBasis(),
+      fMBSDListM->GetNBasis());
+  if(table && fCoe3N) TAException::Warn("TAHamiltonian", "SetJumpTable: the \
+table has no 3-body jumps, and is not used as long as H has a 3-body part");
+  fJumpTable = table;
+  fJumpReady = false;
+} // end of member function SetJumpTable
+
+/// \retval fJumpTable if it is set and applicable, with the coefficients
+TAJumpTable *TAHamiltonian::JumpTable(){
+  // the table has no 3-body jumps //
+  if(!fJumpTable || !fCoe1N || fCoe3N) return nullptr;
+  if(!fJumpReady){
+    fJumpTable->SetCoefficient(*fCoe1N, fCoe2N);
+    fJumpReady = true;
+  } // end if
+  return fJumpTable;
+} // end of member function JumpTable
+
 // so that this class could undergo a debugging test //
 // the coefficients of 1, 2 and 3-body force are all set to 1 //
-void TAHamiltonian::InitializeCoefficient(){
+void TAHamiltonian::InitializeCoefficient(bool has3N){
+  TAPROF_PHASE("TAHamiltonian::InitializeCoefficient");
   if(!fNSPState){
     TAException::Error("TAHamiltonian",
       "InitializeCoefficient: fNSPState not set yet.");
   }
 
+  ClearRowCache();
+  ClearOpString();
+  if(fMatrix){ delete fMatrix; fMatrix = nullptr; } // of the former H
+  fJumpReady = false;
   if(fCoe1N){ delete fCoe1N; fCoe1N = nullptr; }
   if(fCoe2N){ delete fCoe2N; fCoe2N = nullptr; }
   if(fCoe3N){ delete fCoe3N; fCoe3N = nullptr; }
@@ -221,8 +538,6 @@ void TAHamiltonian::InitializeCoefficient(){
   } // end for over i
   // initialize fCoe2N //
   TAMatrix2D tmpMinus = -1. * tmp;
-  static int cnt = 0;
-  cout << cnt++ << endl;
   fCoe2N = new TAMatrix4D(fNSPState, fNSPState);
   for(int i = 0; i < fNSPState; i++){
     for(int j = i; j < fNSPState; j++){
@@ -237,6 +552,7 @@ void TAHamiltonian::InitializeCoefficient(){
       }
     } // end for over j
   } // end for over i
+  if(!has3N) return;
   // initialize fCoe3N //
   fCoe3N = new TAMatrix6D(fNSPState, fNSPState);
   for(int i = 0; i < fNSPState; i++){
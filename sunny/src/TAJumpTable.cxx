@@ -0,0 +1,315 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAJumpTable.cxx
+  \class TAJumpTable
+  \brief The one- and two-body jumps of a many-body basis, i.e. all the non-
+  zero a+_p*a_q|j> = phase*|i> and a+_p*a+_q*a_s*a_r|j> = phase*|i> (p<q, r<s),
+  grouped by the orbitals (p,q) and (p,q,r,s). They depend on the basis only,
+  so are computed once, and may be saved to a file, to serve any number of
+  interactions: given the coefficients of H, each group gets one weight, and
+  H*v is a gather-and-multiply over the table with no bit operation at all.
+  This is an operator of the 1+2-body H, to be used e.g. in interaction fits.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include "TAJumpTable.h"
+#include "TAManyBodySDList.h"
+#include "TAManyBodySD.h"
+#include "TABit.h"
+#include "TASingleParticleState.h"
+#include "TASingleParticleStateManager.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+static const char kMagic[8] = {'S', 'U', 'N', 'N', 'Y', 'J', 'T', '1'};
+
+TAJumpTable::TAJumpTable() : fNSPState(0), fNBasis(0), fFingerprint(0){
+  for(int k = 0; k < 2; k++) fOffset[k].assign(1, 0);
+} // end of the constructor
+
+TAJumpTable::~TAJumpTable(){}
+
+unsigned long TAJumpTable::Fingerprint(const TAManyBodySDList *list){
+  unsigned long h = list->GetNBasis();
+  for(const TAManyBodySD *sd : *list)
+    h = h * 1099511628211UL ^ sd->Bit().Hash();
+  return h;
+} // end of member function Fingerprint
+
+void TAJumpTable::Build(const TAManyBodySDList *list){
+  TAPROF_PHASE("TAJumpTable::Build");
+  if(!list) TAException::Error("TAJumpTable", "Build: list is nullptr");
+  const vector<TASingleParticleState *> &sp =
+    TASingleParticleStateManager::Instance()->GetSPStateVec();
+  const int nSP = fNSPState = sp.size(), np = TAManyBodySD::GetNParticle();
+  fNBasis = list->GetNBasis();
+  fFingerprint = Fingerprint(list);
+  vector<short> mj(nSP);
+  for(int i = 0; i < nSP; i++) mj[i] = sp[i]->GetMj();
+
+  // collect the jumps out of each SD, then sort them into groups //
+  struct TAJump{
+    long g; int target, source; signed char phase;
+    bool operator<(const TAJump &b) const{
+      return g != b.g ? g < b.g : target != b.target ? target < b.target :
+        source < b.source;
+    }
+  };
+  vector<TAJump> jump[2];
+  for(int j = 0; j < fNBasis; j++){
+    const TABit &bit = (*list)[j]->Bit();
+    const int *occ = (*list)[j]->IntArr();
+    // a+_p * a_q //
+    for(int iq = 0; iq < np; iq++){
+      const int q = occ[iq];
+      TABit b1 = bit;
+      b1.Annhilate(q);
+      for(int p = 0; p < nSP; p++){
+        if(mj[p] != mj[q]) continue; // would be out of the M-scheme basis
+        TABit b2 = b1;
+        if(!b2.Create(p).GetPhase()) continue;
+        const int i = list->Find(b2);
+        if(i >= 0) jump[0].push_back(TAJump{long(p)*nSP + q, i, j,
+          static_cast<signed char>(b2.GetPhase())});
+      } // end for over p
+    } // end for over q
+    // a+_p*a+_q * a_s*a_r, p < q, r < s //
+    for(int ir = 0; ir < np; ir++) for(int is = ir + 1; is < np; is++){
+      const int r = occ[ir], s = occ[is];
+      TABit b1 = bit;
+      b1.Annhilate(r).Annhilate(s);
+      for(int p = 0; p < nSP; p++) for(int q = p + 1; q < nSP; q++){
+        if(mj[p] + mj[q] != mj[r] + mj[s]) continue;
+        TABit b2 = b1;
+        if(!b2.Create(q).Create(p).GetPhase()) continue;
+        const int i = list->Find(b2);
+        const long g = ((long(p)*nSP + q)*nSP + r)*nSP + s;
+        if(i >= 0) jump[1].push_back(TAJump{g, i, j,
+          static_cast<signed char>(b2.GetPhase())});
+      } // end for over p and q
+    } // end for over r and s
+    TAPROF_PROGRESS("TAJumpTable::Build", j + 1, fNBasis);
+  } // end for over source SDs
+
+  for(int k = 0; k < 2; k++){
+    std::sort(jump[k].begin(), jump[k].end());
+    const long n = jump[k].size();
+    fOrbit[k].clear(); fOffset[k].clear(); fWeight[k].clear();
+    fTarget[k].resize(n); fSource[k].resize(n); fPhase[k].resize(n);
+    for(long l = 0; l < n; l++){
+      const TAJump &t = jump[k][l];
+      if(!l || t.g != jump[k][l-1].g){ // a new group
+        fOffset[k].push_back(l);
+        long g = t.g;
+        int orb[4];
+        for(int m = 2*(k+1); m--;){ orb[m] = g % nSP; g /= nSP; }
+        fOrbit[k].insert(fOrbit[k].end(), orb, orb + 2*(k+1));
+      } // end if
+      fTarget[k][l] = t.target; fSource[k][l] = t.source; fPhase[k][l] = t.phase;
+    } // end for over jumps
+    fOffset[k].push_back(n);
+    vector<TAJump>().swap(jump[k]);
+  } // end for over k
+  TAINFO("TAJumpTable", "Build: %ld 1-body and %ld 2-body jumps in %ld + %ld \
+groups, %.1f MB", GetNJump(0), GetNJump(1), GetNGroup(0), GetNGroup(1),
+    GetBytes() / 1048576.);
+} // end of member function Build
+
+/// the weight of each group from the coefficients of H. The terms of
+/// TAHamiltonian::MatrixElement2N with (q,p) and (s,r) are the same operators
+/// as (p,q,r,s) up to a sign, so they add up into the group p<q, r<s
+void TAJumpTable::SetCoefficient(const TAMatrix2D &coe1N,
+    const TAMatrix4D *coe2N){
+  const vector<int> &o1 = fOrbit[0], &o2 = fOrbit[1];
+  fWeight[0].resize(GetNGroup(0));
+  for(long g = 0; g < GetNGroup(0); g++)
+    fWeight[0][g] = coe1N[o1[2*g]][o1[2*g+1]];
+  fWeight[1].assign(GetNGroup(1), 0.);
+  if(coe2N) for(long g = 0; g < GetNGroup(1); g++){
+    const int p = o2[4*g], q = o2[4*g+1], r = o2[4*g+2], s = o2[4*g+3];
+    const TAMatrix4D &v = *coe2N;
+    fWeight[1][g] = (v[p][q][r][s] - v[q][p][r][s] - v[p][q][s][r] +
+      v[q][p][s][r]) / 4.;
+  } // end for over groups
+} // end of member function SetCoefficient
+
+/// w[i-r0] = sum_j <i|H|j>*v[j], for rows i in [r0, r1)
+void TAJumpTable::Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1){
+  TAPROF_PHASE("TAJumpTable::Multiply");
+  if(int(v.size()) != fNBasis || r0 < 0 || r1 > fNBasis || r0 > r1)
+    TAException::Error("TAJumpTable", "Multiply: |v|: %d, rows [%d, %d), \
+fNBasis: %d", int(v.size()), r0, r1, fNBasis);
+  if(long(fWeight[0].size()) != GetNGroup(0))
+    TAException::Error("TAJumpTable", "Multiply: SetCoefficient not called.");
+  w.assign(r1 - r0, 0.);
+  const bool all = 0 == r0 && fNBasis == r1;
+  for(int k = 0; k < 2; k++){
+    const int *tgt = fTarget[k].data(), *src = fSource[k].data();
+    const signed char *ph = fPhase[k].data();
+    for(long g = 0; g < GetNGroup(k); g++){
+      const double wg = fWeight[k][g];
+      if(!wg) continue;
+      long l = fOffset[k][g];
+      const long l1 = fOffset[k][g+1];
+      if(!all) l = std::lower_bound(tgt + l, tgt + l1, r0) - tgt;
+      for(; l < l1 && tgt[l] < r1; l++) w[tgt[l]-r0] += wg * ph[l] * v[src[l]];
+    } // end for over groups
+  } // end for over k
+} // end of member function Multiply
+
+void TAJumpTable::MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1){
+  TAPROF_PHASE("TAJumpTable::MultiplyBlock");
+  if(long(v.size()) != long(fNBasis)*k || r0 < 0 || r1 > fNBasis || r0 > r1)
+    TAException::Error("TAJumpTable", "MultiplyBlock: |v|: %ld for %d \
+vectors, rows [%d, %d), fNBasis: %d", long(v.size()), k, r0, r1, fNBasis);
+  if(long(fWeight[0].size()) != GetNGroup(0))
+    TAException::Error("TAJumpTable",
+      "MultiplyBlock: SetCoefficient not called.");
+  w.assign(long(r1 - r0)*k, 0.);
+  const bool all = 0 == r0 && fNBasis == r1;
+  for(int q = 0; q < 2; q++){
+    const int *tgt = fTarget[q].data(), *src = fSource[q].data();
+    const signed char *ph = fPhase[q].data();
+    for(long g = 0; g < GetNGroup(q); g++){
+      const double wg = fWeight[q][g];
+      if(!wg) continue;
+      long l = fOffset[q][g];
+      const long l1 = fOffset[q][g+1];
+      if(!all) l = std::lower_bound(tgt + l, tgt + l1, r0) - tgt;
+      for(; l < l1 && tgt[l] < r1; l++){
+        const double a = wg * ph[l], *x = v.data() + long(src[l])*k;
+        double *s = w.data() + long(tgt[l] - r0)*k;
+        for(int j = 0; j < k; j++) s[j] += a * x[j];
+      } // end for over jumps
+    } // end for over groups
+  } // end for over q
+} // end of member function MultiplyBlock
+
+/// h = the dense matrix of H
+void TAJumpTable::Matrix(TAMatrix2D &h) const{
+  TAPROF_PHASE("TAJumpTable::Matrix");
+  if(long(fWeight[0].size()) != GetNGroup(0))
+    TAException::Error("TAJumpTable", "Matrix: SetCoefficient not called.");
+  h.Resize(fNBasis, fNBasis);
+  h = 0.;
+  for(int k = 0; k < 2; k++) for(long g = 0; g < GetNGroup(k); g++){
+    const double wg = fWeight[k][g];
+    if(wg) for(long l = fOffset[k][g]; l < fOffset[k][g+1]; l++)
+      h.RowData(fTarget[k][l])[fSource[k][l]] += wg * fPhase[k][l];
+  } // end for over groups
+} // end of member function Matrix
+
+long TAJumpTable::GetBytes() const{
+  long n = 0;
+  for(int k = 0; k < 2; k++){
+    n += fOrbit[k].size() * sizeof(int) + fOffset[k].size() * sizeof(long);
+    n += fTarget[k].size() * (2*sizeof(int) + sizeof(signed char));
+  } // end for over k
+  return n;
+} // end of member function GetBytes
+
+/// the file: kMagic, nSP, nBasis, fingerprint, then for k = 0, 1: the
+/// number of groups and jumps, the orbitals, offsets, targets, sources, phases
+/// written to a file of its own first, then renamed to file, so that file is
+/// either absent or whole to a concurrent reader
+void TAJumpTable::Write(const string &file) const{
+  const string tmp = file + ".tmp" + std::to_string(getpid());
+  FILE *f = fopen(tmp.c_str(), "wb");
+  if(!f) TAException::Error("TAJumpTable", "Write: cannot open %s",
+    tmp.c_str());
+  bool ok = fwrite(kMagic, 1, sizeof(kMagic), f) == sizeof(kMagic) &&
+    fwrite(&fNSPState, sizeof(int), 1, f) == 1 &&
+    fwrite(&fNBasis, sizeof(int), 1, f) == 1 &&
+    fwrite(&fFingerprint, sizeof(long), 1, f) == 1;
+  for(int k = 0; ok && k < 2; k++){
+    const long ng = GetNGroup(k), nj = GetNJump(k);
+    ok = fwrite(&ng, sizeof(long), 1, f) == 1 &&
+      fwrite(&nj, sizeof(long), 1, f) == 1 &&
+      fwrite(fOrbit[k].data(), sizeof(int), fOrbit[k].size(), f) ==
+        fOrbit[k].size() &&
+      fwrite(fOffset[k].data(), sizeof(long), ng + 1, f) == size_t(ng + 1) &&
+      fwrite(fTarget[k].data(), sizeof(int), nj, f) == size_t(nj) &&
+      fwrite(fSource[k].data(), sizeof(int), nj, f) == size_t(nj) &&
+      fwrite(fPhase[k].data(), 1, nj, f) == size_t(nj);
+  } // end for over k
+  ok = !fflush(f) && !fsync(fileno(f)) && ok;
+  if(fclose(f) || !ok || rename(tmp.c_str(), file.c_str())){
+    remove(tmp.c_str());
+    TAException::Error("TAJumpTable", "Write: failed writing %s",
+      file.c_str());
+  } // end if
+  TAINFO("TAJumpTable", "Write: %s, %.1f MB", file.c_str(),
+    GetBytes() / 1048576.);
+} // end of member function Write
+
+/// load the table from file, built on the same basis as list. The sizes are
+/// checked against the file size before anything is allotted, and the indices
+/// against their ranges, so that a truncated or corrupt file is reported
+/// instead of indexing out of bounds later on
+bool TAJumpTable::Read(const string &file, const TAManyBodySDList *list){
+  FILE *f = fopen(file.c_str(), "rb");
+  if(!f) return false;
+  long left = 0; // the bytes not read yet
+  if(!fseek(f, 0, SEEK_END)) left = ftell(f);
+  rewind(f);
+  char magic[sizeof(kMagic)];
+  unsigned long fp = 0;
+  bool ok = fread(magic, 1, sizeof(magic), f) == sizeof(magic) &&
+    !memcmp(magic, kMagic, sizeof(kMagic)) &&
+    fread(&fNSPState, sizeof(int), 1, f) == 1 &&
+    fread(&fNBasis, sizeof(int), 1, f) == 1 &&
+    fread(&fp, sizeof(long), 1, f) == 1;
+  left -= sizeof(kMagic) + 2*sizeof(int) + sizeof(long);
+  if(ok && (fNBasis != list->GetNBasis() || fp != Fingerprint(list) ||
+      fNSPState != TASingleParticleStateManager::Instance()->GetNSPState())){
+    fclose(f);
+    TAException::Error("TAJumpTable",
+      "Read: %s was built on another basis.", file.c_str());
+    return false;
+  } // end if
+  fFingerprint = fp;
+  for(int k = 0; ok && k < 2; k++){
+    long ng = 0, nj = 0;
+    ok = fread(&ng, sizeof(long), 1, f) == 1 &&
+      fread(&nj, sizeof(long), 1, f) == 1 && ng >= 0 && nj >= 0;
+    left -= 2*sizeof(long);
+    // the arrays of ng groups and nj jumps must fit in the bytes left //
+    ok = ok && ng <= left && nj <= left;
+    if(!ok) break;
+    const long need = ng*long(2*(k+1)*sizeof(int) + sizeof(long)) +
+      long(sizeof(long)) + nj*long(2*sizeof(int) + 1);
+    if(!(ok = need <= left)) break;
+    left -= need;
+    fOrbit[k].resize(ng * 2*(k+1)); fOffset[k].resize(ng + 1);
+    fTarget[k].resize(nj); fSource[k].resize(nj); fPhase[k].resize(nj);
+    fWeight[k].clear();
+    ok = fread(fOrbit[k].data(), sizeof(int), fOrbit[k].size(), f) ==
+        fOrbit[k].size() &&
+      fread(fOffset[k].data(), sizeof(long), ng + 1, f) == size_t(ng + 1) &&
+      fread(fTarget[k].data(), sizeof(int), nj, f) == size_t(nj) &&
+      fread(fSource[k].data(), sizeof(int), nj, f) == size_t(nj) &&
+      fread(fPhase[k].data(), 1, nj, f) == size_t(nj);
+    ok = ok && !fOffset[k][0] && fOffset[k][ng] == nj;
+    for(long g = 0; ok && g < ng; g++)
+      ok = fOffset[k][g] <= fOffset[k][g+1];
+    for(int o : fOrbit[k]) ok = ok && o >= 0 && o < fNSPState;
+    for(long l = 0; ok && l < nj; l++)
+      ok = fTarget[k][l] >= 0 && fTarget[k][l] < fNBasis &&
+        fSource[k][l] >= 0 && fSource[k][l] < fNBasis &&
+        (1 == fPhase[k][l] || -1 == fPhase[k][l]);
+  } // end for over k
+  fclose(f);
+  if(!ok) TAException::Error("TAJumpTable", "Read: %s is corrupt.",
+    file.c_str());
+  TAINFO("TAJumpTable", "Read: %ld 1-body and %ld 2-body jumps from %s",
+    GetNJump(0), GetNJump(1), file.c_str());
+  return ok;
+} // end of member function Read
@@ -0,0 +1,172 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAKernelPolynomial.cxx
+  \class TAKernelPolynomial
+  \brief The many-body level density rho(E) = sum_k delta(E-E_k) of an M block
+  by the kernel polynomial method, using only the products H*v of a TAOperator,
+  whichever backend it is. H is mapped onto [-1, 1] by its spectral bounds, and
+  the Chebyshev moments mu_n = Tr T_n(H) are estimated stochastically by
+  <r|T_n(H)|r> over random vectors r of entries +-1. rho(E) is resummed from
+  the moments with the Jackson kernel, and its error bar comes from the spread
+  over the random vectors. The vectors are either distributed over the MPI
+  ranks by rows, as in TALanczos, or, with SetVectorParallel(), dealt out
+  whole to the ranks, which then need the operator on all the rows, e.g. the
+  matrix-free TAHamiltonian. Either way the result doesn't depend on the number
+  of ranks.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cmath>
+#include <algorithm>
+#include "TAKernelPolynomial.h"
+#include "TAOperator.h"
+#include "TAHamiltonian.h"
+#include "TALanczos.h"
+#include "TABLAS.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+static const double PI = 3.14159265358979323846;
+
+TAKernelPolynomial::TAKernelPolynomial(TAOperator *op) : fOperator(op),
+    fNMoment(200), fNVector(20), fSeed(20261019), fBounds(false),
+    fVectorParallel(false), fEMin(0.), fEMax(0.){
+  if(!fOperator) fOperator = TAHamiltonian::Instance();
+} // end of the constructor
+
+void TAKernelPolynomial::SetBounds(double eMin, double eMax){
+  if(eMin >= eMax) TAException::Error("TAKernelPolynomial",
+    "SetBounds: eMin: %f >= eMax: %f", eMin, eMax);
+  fEMin = eMin; fEMax = eMax; fBounds = true;
+} // end of member function SetBounds
+
+/// the entries are +-1 from a hash of (seed, i, row), so that any segment of
+/// the vector can be made on its own
+void TAKernelPolynomial::RandomVector(int i, int r0, int r1,
+    vector<double> &r) const{
+  r.resize(r1 - r0);
+  for(int j = r0; j < r1; j++){
+    unsigned long long z = fSeed + (((unsigned long long)i) << 32) + j +
+      0x9E3779B97F4A7C15ULL; // splitmix64
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    r[j-r0] = z & 1 ? 1. : -1.;
+  } // end for over j
+} // end of member function RandomVector
+
+/// the moments by T_n+1 = 2*H*T_n - T_n-1, two of them per H*v with
+/// mu_2k = 2<t_k|t_k> - mu_0 and mu_2k+1 = 2<t_k+1|t_k> - mu_1
+void TAKernelPolynomial::Go(){
+  TAPROF_PHASE("TAKernelPolynomial::Go");
+  const int n = fOperator->GetNBasis();
+  if(!n) TAException::Error("TAKernelPolynomial", "Go: empty basis.");
+  if(fNMoment < 2 || fNVector < 1)
+    TAException::Error("TAKernelPolynomial", "Go: %d moments, %d vectors",
+      fNMoment, fNVector);
+  int r0, r1;
+  TAMPI::Partition(n, r0, r1);
+  if(!fBounds){ // the extreme Ritz values, widened for the safety
+    TALanczos *lanczos = TALanczos::Instance();
+    lanczos->SetOperator(fOperator);
+    vector<double> r, e, s;
+    RandomVector(0, r0, r1, r);
+    lanczos->Strength(r, 40);
+    lanczos->GetStrength(e, s);
+    const double margin = 0.05 * (e.back() - e.front()) + 1E-3;
+    SetBounds(e.front() - margin, e.back() + margin);
+  } // end if
+  const double c = (fEMax + fEMin) / 2., w = (fEMax - fEMin) / 2.;
+
+  // the rows of each vector on this rank, and the vectors it takes //
+  const int size = TAMPI::Size(), rank = TAMPI::Rank();
+  const int v0 = fVectorParallel ? 0 : r0, v1 = fVectorParallel ? n : r1;
+  const int nl = v1 - v0;
+  vector<double> full, t0, t1, t2;
+  // (H-c)/w*x - a*y -> z
+  auto step = [&](const vector<double> &x, double a, const vector<double> &y,
+      vector<double> &z){
+    if(fVectorParallel) fOperator->Multiply(x, z, 0, n);
+    else{
+      TAMPI::AllGather(x, full, n);
+      fOperator->Multiply(full, z, r0, r1);
+    } // end else
+    for(int j = 0; j < nl; j++) z[j] = (z[j] - c*x[j]) * (2.*a/w) - y[j];
+  };
+  auto dot = [&](const vector<double> &x, const vector<double> &y){
+    const double d = TABLAS::Dot(x.data(), y.data(), nl);
+    return fVectorParallel ? d : TAMPI::Sum(d);
+  };
+  const int nm = fNMoment;
+  fMoment.assign(fNVector, vector<double>(nm, 0.));
+  const vector<double> zero(nl, 0.);
+  for(int i = 0; i < fNVector; i++){
+    if(fVectorParallel && i % size != rank) continue;
+    vector<double> &mu = fMoment[i];
+    RandomVector(i, v0, v1, t0);
+    step(t0, 0.5, zero, t1); // t1 = H*t0
+    mu[0] = dot(t0, t0);
+    mu[1] = dot(t1, t0);
+    for(int k = 1; 2*k < nm; k++){
+      mu[2*k] = 2.*dot(t1, t1) - mu[0];
+      if(2*k + 1 >= nm) break;
+      step(t1, 1., t0, t2); // t2 = 2*H*t1 - t0
+      mu[2*k+1] = 2.*dot(t2, t1) - mu[1];
+      t0.swap(t1); t1.swap(t2);
+    } // end for over k
+    TAPROF_PROGRESS("TAKernelPolynomial::Go", i + 1, fNVector);
+  } // end for over random vectors
+  if(fVectorParallel){ // gather the moments from their ranks
+    vector<double> m(fNVector*nm);
+    for(int i = 0; i < fNVector; i++)
+      std::copy(fMoment[i].begin(), fMoment[i].end(), m.begin() + i*nm);
+    TAMPI::Sum(m);
+    for(int i = 0; i < fNVector; i++)
+      std::copy(m.begin() + i*nm, m.begin() + (i+1)*nm, fMoment[i].begin());
+  } // end if
+
+  fMu.assign(nm, 0.);
+  for(const vector<double> &mu : fMoment)
+    for(int k = 0; k < nm; k++) fMu[k] += mu[k] / fNVector;
+  // the Jackson kernel //
+  fKernel.resize(nm);
+  const double q = PI / (nm + 1);
+  for(int k = 0; k < nm; k++) fKernel[k] = ((nm - k + 1) * cos(q*k) +
+    sin(q*k) / tan(q)) / (nm + 1);
+  TAINFO("TAKernelPolynomial", "Go: dim: %d, E in [%f, %f], %d moments, %d \
+random vectors, ranks: %d", n, fEMin, fEMax, nm, fNVector, size);
+} // end of member function Go
+
+/// rho(E) = (g_0*mu_0 + 2*sum_n g_n*mu_n*T_n(x)) / (pi*w*sqrt(1-x^2)), for
+/// each random vector, then averaged
+double TAKernelPolynomial::Density(double e, double &err) const{
+  err = 0.;
+  if(fMoment.empty())
+    TAException::Error("TAKernelPolynomial", "Density: Go() not run yet.");
+  const double c = (fEMax + fEMin) / 2., w = (fEMax - fEMin) / 2.;
+  const double x = (e - c) / w;
+  if(fabs(x) >= 1.) return 0.;
+  const int nm = fMu.size();
+  vector<double> t(nm); // g_n*T_n(x)
+  double tp = 1., tc = x;
+  t[0] = fKernel[0];
+  t[1] = 2. * fKernel[1] * x;
+  for(int k = 2; k < nm; k++){
+    const double tn = 2.*x*tc - tp;
+    t[k] = 2. * fKernel[k] * tn;
+    tp = tc; tc = tn;
+  } // end for over k
+  const double f = 1. / (PI * w * sqrt(1. - x*x));
+  double s = 0., s2 = 0.;
+  for(const vector<double> &mu : fMoment){
+    const double rho = f * TABLAS::Dot(t.data(), mu.data(), nm);
+    s += rho; s2 += rho*rho;
+  } // end for over random vectors
+  const int nv = fMoment.size();
+  s /= nv;
+  if(nv > 1) err = sqrt(std::max(0., (s2/nv - s*s) / (nv - 1.)));
+  return s;
+} // end of member function Density
@@ -0,0 +1,307 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TALanczos.cxx
+  \class TALanczos
+  \brief The Lanczos method for the lowest eigenpairs of a symmetric operator,
+  with full reorthogonalization. Only the products O*v are needed, so O needn't
+  be stored. The Lanczos vectors are distributed over the MPI ranks as local
+  segments (see TAMPI): each rank multiplies its own block of rows, and the
+  segments are joined by an allgather before every O*v, while the scalar
+  products go through allreduce. Runs serially if built without SUNNY_MPI.
+  Strength() runs the plain three-term recurrence instead, from v = O|psi>,
+  for the distribution of |<k|O|psi>|^2 over the eigenstates k of H, out of
+  the tridiagonal coefficients only, with no eigenvector.
+  With SetCheckpoint(), Go() saves the Lanczos vectors and T to a file now and
+  then, in the background, and a rerun resumes from there.
+  This is a singleton class.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cmath>
+#include <complex>
+#include <algorithm>
+#include <memory>
+#include "TALanczos.h"
+#include "TACheckpoint.h"
+#include "TAOperator.h"
+#include "TAHamiltonian.h"
+#include "TAMathFCI.h"
+#include "TABLAS.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+TALanczos *TALanczos::kInstance = nullptr;
+
+TALanczos::TALanczos() : fOperator(nullptr), fRefine(nullptr), fNEigen(1),
+    fMaxIteration(300), fTolerance(1E-8), fWarmStart(false),
+    fCheckpointInterval(20), fNIteration(0), fR0(0), fR1(0), fStrength0(0.){}
+
+TALanczos::~TALanczos(){}
+
+TALanczos *TALanczos::Instance(){
+  if(!kInstance) kInstance = new TALanczos();
+  return kInstance;
+} // end of member function Instance
+
+double TALanczos::GetEnergy(int i) const{
+  if(i < 0 || i >= int(fEnergy.size()))
+    TAException::Error("TALanczos", "GetEnergy: %d out of range [0, %d)",
+      i, int(fEnergy.size()));
+  return fEnergy[i];
+} // end of member function GetEnergy
+
+const vector<double> &TALanczos::GetVector(int i) const{
+  if(i < 0 || i >= int(fVector.size()))
+    TAException::Error("TALanczos", "GetVector: %d out of range [0, %d)",
+      i, int(fVector.size()));
+  return fVector[i];
+} // end of member function GetVector
+
+// O*q for the local rows, q being the local segment
+void TALanczos::Multiply(const vector<double> &q, vector<double> &w){
+  TAPROF_PHASE("TALanczos::Multiply");
+  const int n = fOperator->GetNBasis();
+  TAMPI::AllGather(q, fFull, n);
+  fOperator->Multiply(fFull, w, fR0, fR1);
+} // end of member function Multiply
+
+// Rayleigh-Ritz with fRefine in the space of the eigenvectors: diagonalize
+// <x_i|O|x_j> and rotate the x-s accordingly. The energy error goes with the
+// square of that of the vectors, so a float fOperator yields double precision
+// energies this way
+void TALanczos::Refine(){
+  TAPROF_PHASE("TALanczos::Refine");
+  const int m = fVector.size(), nl = fR1 - fR0, n = fRefine->GetNBasis();
+  if(n != fOperator->GetNBasis())
+    TAException::Error("TALanczos", "Refine: dimension mismatch: %d vs %d",
+      n, fOperator->GetNBasis());
+  vector<vector<double> > hx(m);
+  for(int j = 0; j < m; j++){
+    TAMPI::AllGather(fVector[j], fFull, n);
+    fRefine->Multiply(fFull, hx[j], fR0, fR1);
+  } // end for over j
+  TAMatrix2D h(m, m), P(m, m), v(m);
+  for(int i = 0; i < m; i++) for(int j = 0; j <= i; j++)
+    h[i][j] = h[j][i] = TAMPI::Dot(fVector[i], hx[j]);
+  TAMathFCI::EigenHouseholder(h, P, v);
+
+  vector<vector<double> > x(m, vector<double>(nl, 0.)), r(x);
+  vector<const double *> px(m), phx(m);
+  for(int k = 0; k < m; k++){ px[k] = fVector[k].data(); phx[k] = hx[k].data(); }
+  vector<double> c(m);
+  for(int j = 0; j < m; j++){
+    for(int k = 0; k < m; k++) c[k] = P[k][j];
+    TABLAS::MultiAxpy(c.data(), px.data(), m, x[j].data(), nl);
+    TABLAS::MultiAxpy(c.data(), phx.data(), m, r[j].data(), nl);
+    const double r2 = TABLAS::AxpyDot(-v[j][0], x[j].data(), r[j].data(),
+      r[j].data(), nl);
+    TAINFO("TALanczos", "Refine: E[%d]: %f -> %.10f, residual: %g", j,
+      fEnergy[j], v[j][0], sqrt(TAMPI::Sum(r2)));
+    fEnergy[j] = v[j][0];
+  } // end for over j
+  fVector.swap(x);
+} // end of member function Refine
+
+void TALanczos::Go(){
+  TAPROF_PHASE("TALanczos::Go");
+  if(!fOperator) fOperator = TAHamiltonian::Instance();
+  const int n = fOperator->GetNBasis();
+  if(!n) TAException::Error("TALanczos", "Go: empty basis.");
+  TAMPI::Partition(n, fR0, fR1);
+  const int nl = fR1 - fR0;
+  const int nev = std::min(std::max(fNEigen, 1), n);
+  const int maxIt = std::min(std::max(fMaxIteration, nev), n);
+
+  // the starting vector, a function of the global index only, so that the
+  // result is independent of the number of ranks //
+  vector<double> q(nl, 0.), w;
+  double nrm = 0.;
+  if(fWarmStart && fVector.size() && int(fVector[0].size()) == nl){
+    for(const vector<double> &x : fVector)
+      TABLAS::Axpy(1., x.data(), q.data(), nl);
+    nrm = sqrt(TAMPI::Dot(q, q));
+  } // end if
+  if(nrm < 1E-12){
+    TAMPI::StartVector(fR0, fR1, 0, q.data());
+    nrm = sqrt(TAMPI::Dot(q, q));
+  } // end if
+  TABLAS::Scal(1. / nrm, q.data(), nl);
+
+  vector<vector<double> > Q; // the Lanczos vectors
+  vector<const double *> pQ; // and their data
+  vector<double> c;
+  vector<double> alpha, beta; // diagonal and subdiagonal of T
+  vector<double> d, e;
+  TAMatrix2D z;
+  bool converged = false;
+  int m = 0;
+
+  // resume from the checkpoint: record 0 is q_0, and record k, alpha_k-1,
+  // beta_k-1 and q_k, the last of which is the q to go on with //
+  std::unique_ptr<TACheckpoint> ckp;
+  long nSaved = 0; // the records in the checkpoint
+  if(fCheckpoint.size()){
+    ckp.reset(new TACheckpoint(fCheckpoint));
+    nSaved = std::min(ckp->Open(n, fR0, fR1, 2,
+      TACheckpoint::Fingerprint(fOperator)), long(maxIt));
+    double s[2];
+    for(long k = 0; k < nSaved; k++){
+      if(k) Q.push_back(q);
+      ckp->Read(k, s, q);
+      if(k){ alpha.push_back(s[0]); beta.push_back(s[1]); }
+    } // end for over k
+    m = Q.size();
+    if(nSaved) TAINFO("TALanczos", "Go: resumed from %s, Krylov dim: %d",
+      ckp->GetFile().c_str(), m);
+  } // end if
+  while(m < maxIt){
+    Q.push_back(q);
+    m = Q.size();
+    pQ.clear();
+    for(const vector<double> &qk : Q) pQ.push_back(qk.data());
+    Multiply(q, w);
+    // Gram-Schmidt against all the Lanczos vectors, twice for the stability,
+    // this also takes care of the three-term recurrence //
+    alpha.push_back(0.);
+    c.resize(m);
+    for(int pass = 0; pass < 2; pass++){
+      TABLAS::MultiDot(pQ.data(), m, w.data(), nl, c.data());
+      TAMPI::Sum(c);
+      alpha.back() += c[m-1];
+      for(double &ck : c) ck = -ck;
+      TABLAS::MultiAxpy(c.data(), pQ.data(), m, w.data(), nl);
+    } // end for over passes
+    const double b = sqrt(TAMPI::Dot(w, w));
+
+    // the Ritz values and residuals, which take only the last components of
+    // the eigenvectors of T: the last row of the unit matrix rotated, in
+    // O(m^2) instead of O(m^3) for the whole z, built once at the end //
+    d = alpha; e.assign(beta.begin(), beta.end()); e.resize(m, 0.);
+    z.Resize(1, m);
+    for(int i = 0; i < m; i++) z[0][i] = i == m - 1 ? 1. : 0.;
+    TAMathFCI::EigenTridiagonal(d, e, &z);
+    converged = m >= nev;
+    for(int i = 0; i < std::min(nev, m); i++){
+      const double res = b*fabs(z[0][i]);
+      if(res > fTolerance*std::max(1., fabs(d[i]))) converged = false;
+    } // end for over i
+    TADEBUG("TALanczos", "Go: iteration %d, E0: %f, beta: %g", m, d[0], b);
+    if(converged) break;
+    if(b < 1E-12){ // an invariant subspace is exhausted
+      if(m < nev) TAException::Warn("TALanczos",
+        "Go: invariant subspace of dimension %d < nEigen: %d", m, nev);
+      converged = true;
+      break;
+    } // end if
+    beta.push_back(b);
+    q.swap(w);
+    TABLAS::Scal(1. / b, q.data(), nl);
+    if(ckp && (m % std::max(fCheckpointInterval, 1) == 0 || !nSaved)){
+      // the records [nSaved, m], copied for the writer //
+      vector<double> rec;
+      rec.reserve((m + 1 - nSaved)*(nl + 2));
+      for(long k = nSaved; k <= m; k++){
+        rec.push_back(k ? alpha[k-1] : 0.);
+        rec.push_back(k ? beta[k-1] : 0.);
+        const vector<double> &qk = k < m ? Q[k] : q;
+        rec.insert(rec.end(), qk.begin(), qk.end());
+      } // end for over k
+      ckp->Write(std::move(rec), nSaved, 0, m + 1);
+      nSaved = m + 1;
+    } // end if
+  } // end while
+  if(ckp) ckp->Wait();
+  fNIteration = m;
+  if(!converged) TAException::Warn("TALanczos",
+    "Go: not converged within %d iterations", m);
+
+  // assemble the eigenvectors //
+  d = alpha; e.assign(beta.begin(), beta.end()); e.resize(m, 0.);
+  z.Resize(m, m); z = 1.;
+  TAMathFCI::EigenTridiagonal(d, e, &z);
+  const int nout = std::min(nev, m);
+  pQ.clear();
+  for(const vector<double> &qk : Q) pQ.push_back(qk.data());
+  c.resize(m);
+  fEnergy.assign(d.begin(), d.begin() + nout);
+  fVector.assign(nout, vector<double>(nl, 0.));
+  for(int j = 0; j < nout; j++){
+    for(int k = 0; k < m; k++) c[k] = z[k][j];
+    TABLAS::MultiAxpy(c.data(), pQ.data(), m, fVector[j].data(), nl);
+  } // end for over j
+  for(int j = 0; j < nout; j++)
+    TAINFO("TALanczos", "Go: E[%d] = %f, Krylov dim: %d, ranks: %d", j,
+      fEnergy[j], m, TAMPI::Size());
+  if(fRefine && fRefine != fOperator) Refine();
+} // end of member function Go
+
+/// the Lanczos recurrence from q_0 = v/|v|: beta_k+1*q_k+1 = O*q_k -
+/// alpha_k*q_k - beta_k*q_k-1, keeping alpha and beta only
+void TALanczos::Strength(const vector<double> &v, int nStep){
+  TAPROF_PHASE("TALanczos::Strength");
+  if(!fOperator) fOperator = TAHamiltonian::Instance();
+  const int n = fOperator->GetNBasis();
+  if(!n) TAException::Error("TALanczos", "Strength: empty basis.");
+  TAMPI::Partition(n, fR0, fR1);
+  const int nl = fR1 - fR0;
+  if(int(v.size()) != nl)
+    TAException::Error("TALanczos", "Strength: |v|: %d, while the local rows \
+are [%d, %d)", int(v.size()), fR0, fR1);
+  fAlpha.clear(); fBeta.clear();
+  fStrength0 = TAMPI::Dot(v, v);
+  if(fStrength0 < 1E-24){
+    TAException::Warn("TALanczos", "Strength: O|psi> vanishes.");
+    return;
+  } // end if
+
+  vector<double> q(v), p(nl, 0.), w; // q_k, q_k-1 and O*q_k
+  TABLAS::Scal(1. / sqrt(fStrength0), q.data(), nl);
+  const int m = std::min(std::max(nStep, 1), n);
+  for(int k = 0; k < m; k++){
+    Multiply(q, w);
+    if(k) TABLAS::Axpy(-fBeta.back(), p.data(), w.data(), nl);
+    const double a = TAMPI::Dot(q, w);
+    TABLAS::Axpy(-a, q.data(), w.data(), nl);
+    fAlpha.push_back(a);
+    const double b = sqrt(TAMPI::Dot(w, w));
+    TADEBUG("TALanczos", "Strength: iteration %d, alpha: %f, beta: %g",
+      k, a, b);
+    if(k == m - 1 || b < 1E-12) break; // an invariant subspace is exhausted
+    fBeta.push_back(b);
+    p.swap(q);
+    q.swap(w);
+    TABLAS::Scal(1. / b, q.data(), nl);
+  } // end for over k
+  fNIteration = fAlpha.size();
+  TAINFO("TALanczos", "Strength: total strength: %f, centroid: %f, Krylov \
+dim: %d", fStrength0, fAlpha[0], fNIteration);
+} // end of member function Strength
+
+void TALanczos::GetStrength(vector<double> &e, vector<double> &s) const{
+  const int m = fAlpha.size();
+  e = fAlpha;
+  s.clear();
+  if(!m) return;
+  vector<double> b(fBeta);
+  b.resize(m, 0.);
+  TAMatrix2D z(m, m);
+  z = 1.;
+  TAMathFCI::EigenTridiagonal(e, b, &z);
+  s.resize(m);
+  for(int k = 0; k < m; k++) s[k] = fStrength0 * z[0][k] * z[0][k];
+} // end of member function GetStrength
+
+/// <v|1/(z-H)|v> = |v|^2/(z - alpha_0 - beta_1^2/(z - alpha_1 - ...)),
+/// evaluated from the bottom up
+double TALanczos::StrengthFunction(double e, double eta) const{
+  const std::complex<double> z(e, eta);
+  std::complex<double> g(0.);
+  for(int k = int(fAlpha.size()) - 1; k >= 0; k--){
+    const double b2 = k < int(fBeta.size()) ? fBeta[k] * fBeta[k] : 0.;
+    g = 1. / (z - fAlpha[k] - b2 * g);
+  } // end for over k
+  return -fStrength0 * g.imag() / 3.14159265358979323846;
+} // end of member function StrengthFunction
@@ -0,0 +1,116 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAMPI.cxx
+  \class TAMPI
+  \brief A thin wrapper of the MPI calls used by the distributed eigensolvers.
+  The basis index range is cut into Size() contiguous blocks, one per rank, and
+  the vectors are stored as the local segments. Compiled without SUNNY_MPI
+  (cmake -DSUNNY_MPI=ON), it degenerates to a single rank holding everything,
+  so the callers need no #ifdef of their own.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#ifdef SUNNY_MPI
+#include <mpi.h>
+#endif
+#include "TAMPI.h"
+#include "TABLAS.h"
+#include "TAException.h"
+
+int TAMPI::kRank = 0;
+int TAMPI::kSize = 1;
+
+void TAMPI::Init(int *argc, char ***argv){
+#ifdef SUNNY_MPI
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if(!initialized) MPI_Init(argc, argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &kRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &kSize);
+  if(kRank) TAException::Silent(); // only the root reports
+  TAINFO("TAMPI", "Init: %d rank(s)", kSize);
+#else
+  (void)argc; (void)argv;
+#endif
+} // end of member function Init
+
+void TAMPI::Finalize(){
+#ifdef SUNNY_MPI
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if(!finalized) MPI_Finalize();
+#endif
+} // end of member function Finalize
+
+/// the block [r0, r1) of [0, n) owned by rank, the remainder of n/size
+/// going to the leading ranks
+void TAMPI::Partition(int n, int rank, int &r0, int &r1){
+  const int base = n / kSize, rem = n % kSize;
+  r0 = rank*base + (rank < rem ? rank : rem);
+  r1 = r0 + base + (rank < rem ? 1 : 0);
+} // end of member function Partition
+
+double TAMPI::Sum(double x){
+#ifdef SUNNY_MPI
+  if(kSize > 1) MPI_Allreduce(MPI_IN_PLACE, &x, 1, MPI_DOUBLE, MPI_SUM,
+    MPI_COMM_WORLD);
+#endif
+  return x;
+} // end of member function Sum
+
+void TAMPI::Sum(vector<double> &x){
+#ifdef SUNNY_MPI
+  if(kSize > 1 && x.size()) MPI_Allreduce(MPI_IN_PLACE, x.data(), x.size(),
+    MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#else
+  (void)x;
+#endif
+} // end of member function Sum
+
+double TAMPI::Dot(const vector<double> &a, const vector<double> &b){
+  if(a.size() != b.size())
+    TAException::Error("TAMPI", "Dot: size mismatch: %d vs %d",
+      int(a.size()), int(b.size()));
+  return Sum(TABLAS::Dot(a.data(), b.data(), a.size()));
+} // end of member function Dot
+
+void TAMPI::AllGather(const vector<double> &local, vector<double> &global,
+    int n, int k){
+  global.resize(long(n)*k);
+#ifdef SUNNY_MPI
+  if(kSize > 1){
+    vector<int> cnt(kSize), disp(kSize);
+    for(int i = 0; i < kSize; i++){
+      int r0, r1; Partition(n, i, r0, r1);
+      cnt[i] = (r1 - r0)*k; disp[i] = r0*k;
+    } // end for over ranks
+    if(int(local.size()) != cnt[kRank])
+      TAException::Error("TAMPI", "AllGather: local size %d, expected %d",
+        int(local.size()), cnt[kRank]);
+    MPI_Allgatherv(local.data(), cnt[kRank], MPI_DOUBLE, global.data(),
+      cnt.data(), disp.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+    return;
+  } // end if
+#endif
+  if(long(local.size()) != long(n)*k)
+    TAException::Error("TAMPI", "AllGather: local size %d, expected %ld",
+      int(local.size()), long(n)*k);
+  global = local;
+} // end of member function AllGather
+
+void TAMPI::Barrier(){
+#ifdef SUNNY_MPI
+  MPI_Barrier(MPI_COMM_WORLD);
+#endif
+} // end of member function Barrier
+
+/// x[i-r0] = 1 + ((i+j)*7919 mod 17)/17, in 64 bits so as not to overflow for
+/// any basis size
+void TAMPI::StartVector(int r0, int r1, int j, double *x){
+  for(int i = r0; i < r1; i++){
+    const unsigned long long g = static_cast<unsigned long long>(i) + j;
+    x[i-r0] = 1. + (g * 7919ULL % 17) / 17.;
+  } // end for over i
+} // end of member function StartVector
@@ -23,10 +23,11 @@ using std::setw;
 
 int TAManyBodySD::kNParticle = -1;
 
-TAManyBodySD::TAManyBodySD(int index, int nParticle, int *SPState)
-  : fIndex(index), f2M(0), fEnergy(0.), fBit(){
+TAManyBodySD::TAManyBodySD(int index, int nParticle, int *SPState, int *arr)
+  : fIndex(index), f2M(0), fEnergy(0.), fBit(), fSPStateArr(arr),
+    fOwnSPStateArr(!arr){
   kNParticle = nParticle;
-  fSPStateArr = new int[kNParticle];
+  if(fOwnSPStateArr) fSPStateArr = new int[kNParticle];
   for(int i = 0; i < kNParticle; i++){
     if(SPState + i) fSPStateArr[i] = SPState[i];
     else TAException::Error("TAManyBodySD",
@@ -42,14 +43,14 @@ TAManyBodySD::TAManyBodySD(int index, int nParticle, int *SPState)
 } // end of the constructor
 
 TAManyBodySD::~TAManyBodySD(){
-  if(fSPStateArr){
-    delete fSPStateArr;
+  if(fSPStateArr && fOwnSPStateArr){
+    delete [] fSPStateArr;
     fSPStateArr = nullptr;
   }
 } // end of the destructor
 
 TASingleParticleState *TAManyBodySD::operator[](int i){
-  vector<TASingleParticleState *> spv =
+  const vector<TASingleParticleState *> &spv =
     TASingleParticleStateManager::Instance()->GetSPStateVec();
   if(i >= int(spv.size())){
     TAException::Error("TAManyBodySD",
@@ -12,10 +12,16 @@
 */
 
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <map>
 #include "TAManyBodySDList.h"
 #include "TAManyBodySD.h"
+#include "TASingleParticleState.h"
+#include "TASingleParticleStateManager.h"
 #include "TAException.h"
 #include "TABit.h"
+#include "TAProfiler.h"
 
 using std::cout;
 using std::endl;
@@ -28,6 +34,7 @@ TAManyBodySDList::~TAManyBodySDList(){}
 void TAManyBodySDList::Add(TAManyBodySD *mbsd){
   if(!mbsd) TAException::Error("TAManyBodySD", "Add: Input is a nullptr");
   fManyBodySDVec.push_back(mbsd);
+  fIndexMap[mbsd->Bit()] = fManyBodySDVec.size() - 1;
   //mbsd->SetIndex(fManyBodySDVec.size() - 1);
 }
 
@@ -48,37 +55,294 @@ void TAManyBodySDList::PrintInBit() const{
   cout << " many-body Slater determinants in the list." << endl;
 }
 
-TAManyBodySD *TAManyBodySDList::operator[](int i) const{
-  if(i > int(fManyBodySDVec.size()) || i < 0){
-    TAException::Error("TAManyBodySD",
-      "operator[]: index i: %d out of range.", i);
-  }
-  return fManyBodySDVec[i];
-} // end of member function operator[]
-
 /// \retval <rr|a+_p * a_q|cc>
 int TAManyBodySDList::Integral(int rr, int p, int q, int cc) const{
+  TAPROF_COUNT(kIntegral1N);
   TABit rBit = (*this)[rr]->Bit();
   TABit cBit = (*this)[cc]->Bit();
   rBit.Annhilate(p);
   cBit.Annhilate(q);
-  return rBit*cBit;
+  const int phase = rBit*cBit;
+  if(!phase) TAPROF_COUNT(kZero1N);
+  return phase;
 } // end of member function Integral(rr,p,q,cc);
 /// \retval <rr|a+_p*a+_q * a_r*a_s|cc>
 int TAManyBodySDList::Integral(int rr, int p, int q, int r, int s,
   int cc) const{
+  TAPROF_COUNT(kIntegral2N);
   TABit rBit = (*this)[rr]->Bit();
   TABit cBit = (*this)[cc]->Bit();
   rBit.Annhilate(p).Annhilate(q);
   cBit.Annhilate(s).Annhilate(r);
-  return rBit*cBit;
+  const int phase = rBit*cBit;
+  if(!phase) TAPROF_COUNT(kZero2N);
+  return phase;
 } // end of member function Integral(rr,p,q,r,s,cc);
 /// \retval <rr|a+_p*a+_q*a+_r * a_s*a_t*a_u|cc>
 int TAManyBodySDList::Integral(int rr, int p, int q, int r, int s, int t,
   int u, int cc) const{
+  TAPROF_COUNT(kIntegral3N);
   TABit rBit = (*this)[rr]->Bit();
   TABit cBit = (*this)[cc]->Bit();
   rBit.Annhilate(p).Annhilate(q).Annhilate(r);
   cBit.Annhilate(u).Annhilate(t).Annhilate(s);
-  return rBit*cBit;
+  const int phase = rBit*cBit;
+  if(!phase) TAPROF_COUNT(kZero3N);
+  return phase;
 } // end of member function Integral(rr,p,q,r,s,t,u,cc);
+
+/// \retval index of the SD with the occupation of bit, -1 if not in the list
+int TAManyBodySDList::Find(const TABit &bit) const{
+  auto it = fIndexMap.find(bit);
+  return it == fIndexMap.end() ? -1 : it->second;
+} // end of member function Find
+
+/// string-by-string O_i|cc> = phase[i]*|target[i]>. The 2k operators of a
+/// string act in the reverse order of ops, a_qk first and a+_p1 last, and
+/// bit[j] holds the ket after the first j of them
+void TAManyBodySDList::Apply(int cc, int rank, const int *ops, int nOp,
+    int *phase, int *target, const TAManyBodySDList *to) const{
+  if(rank < 1 || rank > kMaxRank)
+    TAException::Error("TAManyBodySDList", "Apply: rank %d not in [1, %d]",
+      rank, kMaxRank);
+  if(cc < 0 || cc >= GetNBasis())
+    TAException::Error("TAManyBodySDList", "Apply: ket %d not in [0, %d)",
+      cc, GetNBasis());
+  if(!to) to = this;
+  const int len = 2*rank;
+  TABit bit[2*kMaxRank+1];
+  int last[2*kMaxRank]; // the operators bit[1..nValid] are made of
+  int nValid = 0;
+  bit[0] = fManyBodySDVec[cc]->Bit();
+  for(int i = 0; i < nOp; i++){
+    const int *op = ops + len*i;
+    int j = 0;
+    while(j < nValid && op[len-1-j] == last[j]) j++; // reuse the common part
+    for(; j < len && bit[j].GetPhase(); j++){
+      bit[j+1] = bit[j];
+      if(j < rank) bit[j+1].Annhilate(op[len-1-j]);
+      else bit[j+1].Create(op[len-1-j]);
+      last[j] = op[len-1-j];
+    } // end for over operators
+    nValid = j;
+    TAPROF_COUNT(kApply);
+    target[i] = j == len && bit[len].GetPhase() ? to->Find(bit[len]) : -1;
+    phase[i] = target[i] < 0 ? 0 : bit[len].GetPhase();
+    if(!phase[i]) TAPROF_COUNT(kApplyZero);
+  } // end for over operator strings
+} // end of member function Apply
+
+/// O|kets[i]> = phase[i]*|target[i]>
+void TAManyBodySDList::Apply(const int *op, int rank, const int *kets,
+    int nKet, int *phase, int *target) const{
+  if(rank < 1 || rank > kMaxRank)
+    TAException::Error("TAManyBodySDList", "Apply: rank %d not in [1, %d]",
+      rank, kMaxRank);
+  const int len = 2*rank;
+  for(int i = 0; i < nKet; i++){
+    TABit bit = (*this)[kets[i]]->Bit();
+    for(int j = 0; j < len && bit.GetPhase(); j++){
+      if(j < rank) bit.Annhilate(op[len-1-j]);
+      else bit.Create(op[len-1-j]);
+    } // end for over operators
+    TAPROF_COUNT(kApply);
+    target[i] = bit.GetPhase() ? Find(bit) : -1;
+    phase[i] = target[i] < 0 ? 0 : bit.GetPhase();
+    if(!phase[i]) TAPROF_COUNT(kApplyZero);
+  } // end for over kets
+} // end of member function Apply
+
+/// \retval whether c, k ascending indices in [0, n), is advanced to the next
+/// combination in lexicographic order
+static bool NextCombination(int *c, int k, int n){
+  int j = k - 1;
+  while(j >= 0 && c[j] == n - k + j) j--;
+  if(j < 0) return false;
+  c[j]++;
+  for(int l = j + 1; l < k; l++) c[l] = c[l-1] + 1;
+  return true;
+} // end of function NextCombination
+
+/// a+_p1..a+_pk a_ak..a_a1 applied to SD i for k = 1..nDiff, the created ones
+/// empty, the annihilated ones occupied, and m_p1+..+m_pk = m_a1+..+m_ak, so
+/// that Find() is only called for the SDs of the same M
+void TAManyBodySDList::Coupled(int i, int nDiff, vector<int> &cols) const{
+  if(nDiff < 0 || nDiff > kMaxRank)
+    TAException::Error("TAManyBodySDList", "Coupled: nDiff %d not in [0, %d]",
+      nDiff, kMaxRank);
+  const TAManyBodySD *sd = (*this)[i];
+  vector<TASingleParticleState *> &sp =
+    TASingleParticleStateManager::Instance()->GetSPStateVec();
+  const int nsp = sp.size(), np = TAManyBodySD::GetNParticle();
+  const int *occ = sd->IntArr();
+  vector<int> emp, m(nsp);
+  vector<char> in(nsp, 0);
+  for(int p = 0; p < nsp; p++) m[p] = sp[p]->Get2Mj();
+  for(int k = 0; k < np; k++) in[occ[k]] = 1;
+  for(int p = 0; p < nsp; p++) if(!in[p]) emp.push_back(p);
+  const int ne = emp.size();
+  cols.assign(1, i);
+  int h[kMaxRank], q[kMaxRank];
+  for(int k = 1; k <= nDiff && k <= np && k <= ne; k++){
+    for(int l = 0; l < k; l++) h[l] = l;
+    do{ // over the holes //
+      TABit hole = sd->Bit();
+      int dm = 0;
+      for(int l = 0; l < k; l++){
+        hole.Annhilate(occ[h[l]]);
+        dm += m[occ[h[l]]];
+      } // end for over l
+      for(int l = 0; l < k; l++) q[l] = l;
+      do{ // over the particles //
+        int dp = 0;
+        for(int l = 0; l < k; l++) dp += m[emp[q[l]]];
+        if(dp != dm) continue;
+        TABit bit = hole;
+        for(int l = 0; l < k; l++) bit.Create(emp[q[l]]);
+        const int j = Find(bit);
+        if(j >= 0) cols.push_back(j);
+      }while(NextCombination(q, k, ne));
+    }while(NextCombination(h, k, np));
+  } // end for over the excitation rank
+  std::sort(cols.begin(), cols.end());
+} // end of member function Coupled
+
+void TAManyBodySDList::CouplingGraph(vector<long> &off, vector<int> &adj) const{
+  TAPROF_PHASE("TAManyBodySDList::CouplingGraph");
+  off.assign(1, 0); adj.clear();
+  vector<int> cols;
+  for(int i = 0; i < GetNBasis(); i++){
+    Coupled(i, 2, cols);
+    for(int j : cols) if(j != i) adj.push_back(j);
+    off.push_back(adj.size());
+  } // end for over SDs
+} // end of member function CouplingGraph
+
+/// RCM: the SDs numbered in the order of a breadth-first search from a
+/// pseudo-peripheral SD of each connected component, the neighbours of each SD
+/// by ascending degree, then the whole order reversed (George and Liu)
+void TAManyBodySDList::Reorder(EOrder order){
+  TAPROF_PHASE("TAManyBodySDList::Reorder");
+  const int n = GetNBasis();
+  vector<int> perm(n); // perm[i]: the present index of the new i-th SD
+  for(int i = 0; i < n; i++) perm[i] = i;
+  if(kLexicographic == order){
+    if(fOriginal.empty()) return;
+    std::sort(perm.begin(), perm.end(),
+      [this](int a, int b){ return fOriginal[a] < fOriginal[b]; });
+  } // end if
+  else if(kRCM == order){
+    vector<long> off;
+    vector<int> adj;
+    CouplingGraph(off, adj);
+    auto deg = [&off](int i){ return off[i+1] - off[i]; };
+    // the level structure from s, its last level in last \retval its depth
+    vector<int> level(n, -1), queue, last;
+    auto bfs = [&](int s) -> int{
+      queue.assign(1, s); level[s] = 0;
+      for(size_t h = 0; h < queue.size(); h++)
+        for(long k = off[queue[h]]; k < off[queue[h]+1]; k++)
+          if(level[adj[k]] < 0){
+            level[adj[k]] = level[queue[h]] + 1;
+            queue.push_back(adj[k]);
+          } // end if
+      const int depth = level[queue.back()];
+      last.clear();
+      for(int j : queue){
+        if(level[j] == depth) last.push_back(j);
+        level[j] = -1;
+      } // end for over j
+      return depth;
+    };
+    vector<int> byDegree(perm);
+    std::stable_sort(byDegree.begin(), byDegree.end(),
+      [&deg](int a, int b){ return deg(a) < deg(b); });
+    vector<char> done(n, 0);
+    vector<int> cm, nb;
+    cm.reserve(n);
+    for(int s : byDegree){
+      if(done[s]) continue;
+      // pseudo-peripheral: the least connected of the farthest, till the
+      // depth stops growing //
+      for(int depth = bfs(s);;){
+        const int t = *std::min_element(last.begin(), last.end(),
+          [&deg](int a, int b){ return deg(a) < deg(b); });
+        const int d = bfs(t);
+        if(d <= depth) break;
+        s = t; depth = d;
+      } // end for
+      // Cuthill-McKee //
+      size_t h = cm.size();
+      cm.push_back(s); done[s] = 1;
+      for(; h < cm.size(); h++){
+        nb.clear();
+        for(long k = off[cm[h]]; k < off[cm[h]+1]; k++)
+          if(!done[adj[k]]){ done[adj[k]] = 1; nb.push_back(adj[k]); }
+        std::stable_sort(nb.begin(), nb.end(),
+          [&deg](int a, int b){ return deg(a) < deg(b); });
+        cm.insert(cm.end(), nb.begin(), nb.end());
+      } // end for over h
+    } // end for over components
+    perm.assign(cm.rbegin(), cm.rend());
+    // the spread of the non-zeros of H before and after //
+    long bw0 = 0, bw = 0;
+    double d0 = 0., d = 0.;
+    vector<int> at(n);
+    for(int i = 0; i < n; i++) at[perm[i]] = i;
+    for(int i = 0; i < n; i++) for(long k = off[i]; k < off[i+1]; k++){
+      bw0 = std::max(bw0, long(abs(i - adj[k])));
+      bw = std::max(bw, long(abs(at[i] - at[adj[k]])));
+      d0 += abs(i - adj[k]); d += abs(at[i] - at[adj[k]]);
+    } // end for over the coupled pairs
+    if(adj.size()){ d0 /= adj.size(); d /= adj.size(); }
+    TAINFO("TAManyBodySDList", "Reorder: RCM, bandwidth: %ld -> %ld, mean \
+|i-j|: %.1f -> %.1f, over %ld coupled pairs", bw0, bw, d0, d,
+      long(adj.size()));
+  } // end if
+  else if(kConfiguration == order){
+    // the orbitals, numbered as they first appear in the SP states //
+    vector<TASingleParticleState *> &sp =
+      TASingleParticleStateManager::Instance()->GetSPStateVec();
+    std::map<vector<short>, int> orbit;
+    vector<int> orb(sp.size());
+    for(size_t p = 0; p < sp.size(); p++){
+      const vector<short> key{sp[p]->GetN(), sp[p]->GetL(), sp[p]->Get2J()};
+      orb[p] = orbit.emplace(key, int(orbit.size())).first->second;
+    } // end for over p
+    const int np = TAManyBodySD::GetNParticle(), nOrb = orbit.size();
+    vector<vector<short> > conf(n, vector<short>(nOrb, 0));
+    for(int i = 0; i < n; i++){
+      const int *arr = fManyBodySDVec[i]->IntArr();
+      for(int k = 0; k < np; k++) conf[i][orb[arr[k]]]++;
+    } // end for over i
+    std::stable_sort(perm.begin(), perm.end(),
+      [&conf](int a, int b){ return conf[a] > conf[b]; });
+    int nConf = n > 0;
+    for(int i = 1; i < n; i++) if(conf[perm[i]] != conf[perm[i-1]]) nConf++;
+    TAINFO("TAManyBodySDList", "Reorder: %d configurations over %d orbitals",
+      nConf, nOrb);
+  } // end if
+  else TAException::Error("TAManyBodySDList", "Reorder: unknown order %d",
+    int(order));
+
+  // apply the permutation //
+  vector<TAManyBodySD *> sds(n);
+  vector<int> original(n);
+  for(int i = 0; i < n; i++){
+    sds[i] = fManyBodySDVec[perm[i]];
+    original[i] = GetOriginalIndex(perm[i]);
+    fIndexMap[sds[i]->Bit()] = i;
+  } // end for over i
+  fManyBodySDVec.swap(sds);
+  fOriginal.swap(original);
+  if(kLexicographic == order) fOriginal.clear();
+} // end of member function Reorder
+
+void TAManyBodySDList::ToOriginalOrder(const vector<double> &x,
+    vector<double> &y) const{
+  if(int(x.size()) != GetNBasis())
+    TAException::Error("TAManyBodySDList", "ToOriginalOrder: |x|: %d, while \
+the basis is of %d", int(x.size()), GetNBasis());
+  y.resize(x.size());
+  for(int i = 0; i < GetNBasis(); i++) y[GetOriginalIndex(i)] = x[i];
+} // end of member function ToOriginalOrder
@@ -11,12 +11,14 @@
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <new>
 #include "TAManyBodySDManager.h"
 #include "TAManyBodySDList.h"
 #include "TAManyBodySD.h"
 #include "TASingleParticleStateManager.h"
 #include "TAException.h"
 #include "TAMathFCI.h"
+#include "TAProfiler.h"
 
 using std::string;
 using std::cout;
@@ -26,7 +28,8 @@ using std::endl;
 TAManyBodySDManager *TAManyBodySDManager::kInstance = nullptr;
 
 TAManyBodySDManager::TAManyBodySDManager()
-  : fManyBodySDListM(nullptr){}
+  : fSPFile("sp.txt"), fNParticle(3), f2M(1),
+  fOrder(TAManyBodySDList::kLexicographic), fManyBodySDListM(nullptr){}
 
 TAManyBodySDManager *TAManyBodySDManager::Instance(){
   if(!kInstance) kInstance = new TAManyBodySDManager();
@@ -34,25 +37,30 @@ TAManyBodySDManager *TAManyBodySDManager::Instance(){
 }
 
 TAManyBodySDManager::~TAManyBodySDManager(){
+  // the MBSDs live in fArena, so are destructed in place and freed in one step
   for(TAManyBodySD *&p : fManyBodySDVec){
     if(p){
-      delete p; p = nullptr;
+      p->~TAManyBodySD(); p = nullptr;
     } // end if
   } // end for
   fManyBodySDVec.clear();
+  fArena.Release();
+  for(auto &p : fMBSDListMap) delete p.second;
+  fMBSDListMap.clear();
 } // end of the destructor
 
 void TAManyBodySDManager::GenerateManyBodySD(){
   if(fManyBodySDVec.size()) return; // called already
+  TAPROF_PHASE("TAManyBodySDManager::GenerateManyBodySD");
 
   // obtain user input //
   string SPStatefile;
   short nParticle;
 //  cout << "Please enter single particle state input file: ";
 //  cin >> SPStatefile;
-  SPStatefile = "sp.txt"; // DEBUG
+  SPStatefile = fSPFile;
 //  cout << "Please enter number of particles: ";
-  nParticle = 3; // DEBUG
+  nParticle = fNParticle;
 //  if(!(cin >> nParticle)){
 //    TAException::Error("TAManyBodySDManager",
 //      "GenerateManyBodySD: Please enter an integer.");
@@ -70,6 +78,15 @@ void TAManyBodySDManager::GenerateManyBodySD(){
   }
   const int nManyBodySD = TAMathFCI::Binomial(nSPState, nParticle);
   fManyBodySDVec.clear(); fManyBodySDVec.reserve(nManyBodySD);
+  // the MBSD objects and their SP state arrays are carved from fArena, with
+  // room for all of them in one chunk
+  fArena.Reserve(size_t(nManyBodySD) * (sizeof(TAManyBodySD) +
+    alignof(TAManyBodySD) + nParticle * sizeof(int)));
+  auto newSD = [&](int index, int *SPState){
+    int *arr = fArena.Allocate<int>(nParticle);
+    void *p = fArena.Allocate(sizeof(TAManyBodySD), alignof(TAManyBodySD));
+    return new(p) TAManyBodySD(index, nParticle, SPState, arr);
+  };
 
 
   /////////// odometer method to generate many-body basis /////////////
@@ -77,7 +94,7 @@ void TAManyBodySDManager::GenerateManyBodySD(){
   int index = 0; // many-body SD index
   // the first MBSD configuration
   for(int i = 0; i < nParticle; i++) SPStateVec[i] = i;
-  fManyBodySDVec.push_back(new TAManyBodySD(index++, nParticle, SPStateVec));
+  fManyBodySDVec.push_back(newSD(index++, SPStateVec));
 
   // generate the MBSDs //
   while(1){
@@ -90,7 +107,7 @@ void TAManyBodySDManager::GenerateManyBodySD(){
     while(i < nParticle - 1){
       SPStateVec[i + 1] = SPStateVec[i] + 1; i++;
     }
-    fManyBodySDVec.push_back(new TAManyBodySD(index++, nParticle, SPStateVec));
+    fManyBodySDVec.push_back(newSD(index++, SPStateVec));
     if(SPStateVec[0] == nSPState - nParticle) break;
   } // end while
   delete [] SPStateVec;
@@ -106,18 +123,17 @@ void TAManyBodySDManager::GenerateManyBodySD(){
 
   // display the geneated many-body SD for debugging purposes
   TAManyBodySD::kNParticle = nParticle;
-  TAException::Info("TAManyBodySDManager",
-    "GenerateManyBodySD: \n\
-Display the generated many-body Slater determinants ~");
-  for(TAManyBodySD *mp : fManyBodySDVec) mp->Print(); // DEBUG
-  for(TAManyBodySD *mp : fManyBodySDVec) mp->PrintInBit(); // DEBUG
-  cout << "Totally there're " << fManyBodySDVec.size();
-  cout << " many-body Slater determinants in the list." << endl;
+  TAINFO("TAManyBodySDManager", "GenerateManyBodySD: Totally there're %d \
+many-body Slater determinants in the list.", int(fManyBodySDVec.size()));
+  TADEBUG_DO(
+    for(TAManyBodySD *mp : fManyBodySDVec) mp->Print();
+    for(TAManyBodySD *mp : fManyBodySDVec) mp->PrintInBit());
 } // end member function GenerateManyBodySD
 
 // generate the M-scheme many-body state basis
 void TAManyBodySDManager::MSchemeGo(){
   if(fManyBodySDListM) return; // alrady called
+  TAPROF_PHASE("TAManyBodySDManager::MSchemeGo");
 
   GenerateManyBodySD(); // Generate all the many-body basis
 
@@ -130,7 +146,7 @@ void TAManyBodySDManager::MSchemeGo(){
   short twoM = -999;
 //  cout << "Please enter 2M (total M*2 for the many-body system): ";
 //  cin >> twoM;
-  twoM = 1; // DEBUG
+  twoM = f2M;
   if(twoM < min2M || twoM > max2M)
     TAException::Error("TAManyBodySDManager",
       "MSchemeGo: Input 2M: %d is not within [%d, %d]", twoM, min2M, max2M);
@@ -140,15 +156,34 @@ void TAManyBodySDManager::MSchemeGo(){
   for(TAManyBodySD *p : fManyBodySDVec){
     if(twoM == p->Get2M()) fManyBodySDListM->Add(p);
   }
+  if(fOrder != TAManyBodySDList::kLexicographic)
+    fManyBodySDListM->Reorder(fOrder);
   if(fManyBodySDListM->GetNBasis() == 0){
     TAException::Warn("TAManyBodySDManager",
       "MschemeGo: fManyBodySDListM is empty in the end.");
   }
-  fManyBodySDListM->Print(); // DEBUG
-  fManyBodySDListM->PrintInBit(); // DEBUG
+  TAINFO("TAManyBodySDManager", "MSchemeGo: %d M-scheme basis states with 2M=%d",
+    fManyBodySDListM->GetNBasis(), twoM);
+  TADEBUG_DO(fManyBodySDListM->Print(); fManyBodySDListM->PrintInBit());
 } // end of member function MSchemeGo
 
 TAManyBodySDList *TAManyBodySDManager::GetMBSDListM(){
   if(!fManyBodySDListM || !fManyBodySDVec.size()) MSchemeGo();
   return fManyBodySDListM;
 }
+
+/// \retval the M-scheme basis of 2M = twoM, made on first demand
+TAManyBodySDList *TAManyBodySDManager::GetMBSDList(short twoM){
+  GenerateManyBodySD();
+  if(fManyBodySDListM && twoM == fManyBodySDListM->Get2M())
+    return fManyBodySDListM;
+  TAManyBodySDList *&list = fMBSDListMap[twoM];
+  if(!list){
+    list = new TAManyBodySDList(twoM);
+    for(TAManyBodySD *p : fManyBodySDVec) if(twoM == p->Get2M()) list->Add(p);
+    if(fOrder != TAManyBodySDList::kLexicographic) list->Reorder(fOrder);
+    TAINFO("TAManyBodySDManager", "GetMBSDList: %d basis states with 2M=%d",
+      list->GetNBasis(), twoM);
+  } // end if
+  return list;
+} // end of member function GetMBSDList
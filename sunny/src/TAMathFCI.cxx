@@ -11,12 +11,16 @@
 */
 
 #include <cstring>
+#include <cstdlib>
 #include <algorithm>
 #include <cmath>
 #include <iostream>
 
 #include "TAMathFCI.h"
 #include "TAException.h"
+#include "TABLAS.h"
+#include "TAMPI.h"
+#include "TAProfiler.h"
 
 using std::max_element;
 using std::cout;
@@ -30,7 +34,10 @@ int TAMathFCI::Binomial(int n, int m){
   if(m > n)
     TAException::Error("TAMathFCI",
       "Binomial: n: %d is larger than m: %d!", n, m);
-  return Factorial(n) / (Factorial(m) * Factorial(n-m));
+  // multiplicative form, so that n! wouldn't overflow for n > 12 //
+  long long c = 1;
+  for(int i = 1; i <= m; i++) c = c * (n - m + i) / i;
+  return c;
 }
 
 /// \return n!
@@ -40,8 +47,73 @@ int TAMathFCI::Factorial(int n){
   return n <= 1 ? 1 : n * Factorial(n-1);
 }
 
+/// \return n! in double, for the angular momentum algebra
+static double FactorialD(int n){
+  static vector<double> f(1, 1.);
+  while(int(f.size()) <= n) f.push_back(f.back() * f.size());
+  return f[n];
+} // end of function FactorialD
+
+/// \retval whether a, b and c (doubled) satisfy the triangular condition
+/// and a+b+c is even, i.e. can couple to each other
+static bool Triangle(int a, int b, int c){
+  return a >= 0 && b >= 0 && c >= 0 && c >= abs(a - b) && c <= a + b &&
+    !((a + b + c) % 2);
+} // end of function Triangle
+
+/// \retval Delta(abc) = (a+b-c)!(a-b+c)!(-a+b+c)!/(a+b+c+1)!, doubled args
+static double TriangleCoe(int a, int b, int c){
+  return FactorialD((a+b-c)/2) * FactorialD((a-b+c)/2) *
+    FactorialD((-a+b+c)/2) / FactorialD((a+b+c)/2 + 1);
+} // end of function TriangleCoe
+
+/// \retval (j1 j2 j3; m1 m2 m3) by the Racah formula
+double TAMathFCI::ThreeJ(int tj1, int tj2, int tj3, int tm1, int tm2,
+    int tm3){
+  if(tm1 + tm2 + tm3 || !Triangle(tj1, tj2, tj3)) return 0.;
+  if(abs(tm1) > tj1 || abs(tm2) > tj2 || abs(tm3) > tj3) return 0.;
+  if((tj1 + tm1) % 2 || (tj2 + tm2) % 2 || (tj3 + tm3) % 2) return 0.;
+  const int kmin = std::max(std::max(0, (tj2 - tj3 - tm1)/2),
+    (tj1 - tj3 + tm2)/2);
+  const int kmax = std::min(std::min((tj1 + tj2 - tj3)/2, (tj1 - tm1)/2),
+    (tj2 + tm2)/2);
+  double s = 0.;
+  for(int k = kmin; k <= kmax; k++){
+    s += (k % 2 ? -1. : 1.) / (FactorialD(k) *
+      FactorialD((tj3 - tj2 + tm1)/2 + k) * FactorialD((tj3 - tj1 - tm2)/2 + k) *
+      FactorialD((tj1 + tj2 - tj3)/2 - k) * FactorialD((tj1 - tm1)/2 - k) *
+      FactorialD((tj2 + tm2)/2 - k));
+  } // end for over k
+  const int ph = (tj1 - tj2 - tm3) / 2;
+  return (ph % 2 ? -1. : 1.) * s * sqrt(TriangleCoe(tj1, tj2, tj3) *
+    FactorialD((tj1+tm1)/2) * FactorialD((tj1-tm1)/2) *
+    FactorialD((tj2+tm2)/2) * FactorialD((tj2-tm2)/2) *
+    FactorialD((tj3+tm3)/2) * FactorialD((tj3-tm3)/2));
+} // end of member function ThreeJ
+
+/// \retval {j1 j2 j3; j4 j5 j6} by the Racah formula
+double TAMathFCI::SixJ(int tj1, int tj2, int tj3, int tj4, int tj5, int tj6){
+  if(!Triangle(tj1, tj2, tj3) || !Triangle(tj1, tj5, tj6) ||
+     !Triangle(tj4, tj2, tj6) || !Triangle(tj4, tj5, tj3)) return 0.;
+  const int a1 = (tj1 + tj2 + tj3)/2, a2 = (tj1 + tj5 + tj6)/2;
+  const int a3 = (tj4 + tj2 + tj6)/2, a4 = (tj4 + tj5 + tj3)/2;
+  const int b1 = (tj1 + tj2 + tj4 + tj5)/2, b2 = (tj2 + tj3 + tj5 + tj6)/2;
+  const int b3 = (tj3 + tj1 + tj6 + tj4)/2;
+  const int tmin = std::max(std::max(a1, a2), std::max(a3, a4));
+  const int tmax = std::min(std::min(b1, b2), b3);
+  double s = 0.;
+  for(int t = tmin; t <= tmax; t++){
+    s += (t % 2 ? -1. : 1.) * FactorialD(t + 1) / (FactorialD(t - a1) *
+      FactorialD(t - a2) * FactorialD(t - a3) * FactorialD(t - a4) *
+      FactorialD(b1 - t) * FactorialD(b2 - t) * FactorialD(b3 - t));
+  } // end for over t
+  return s * sqrt(TriangleCoe(tj1, tj2, tj3) * TriangleCoe(tj1, tj5, tj6) *
+    TriangleCoe(tj4, tj2, tj6) * TriangleCoe(tj4, tj5, tj3));
+} // end of member function SixJ
+
 /// return the dominant eigenvalue using power method
 double TAMathFCI::EigenPower(const TAMatrix2D &ma, TAMatrix2D &v){
+  TAPROF_PHASE("TAMathFCI::EigenPower");
   if(!ma.IsSquare())
     TAException::Error("TAMathFCI",
       "EigenPower: Input matrix is not square.");
@@ -54,24 +126,24 @@ Input vector is not a vector.");
 
   double mv, mv_old = 1E200; // the maximum element in u
 
+  int round = 0;
   while(fabs(mv - mv_old) > 1E-4){
-    static int round = 0; // DEBUG
     v = ma*v;
     mv_old = mv;
     mv = **max_element(v.cv(0).begin(), v.cv(0).end(),
       [](double *a, double *b){ return fabs(*a) < fabs(*b); } );
     if(0. != mv) v /= mv;
 
-    cout << "Round: " << round++ << endl; // DEBUG
-    cout << "After renormalization, max_v: " << mv << endl; // DEBUG
-    v.Print(); // DEBUG
-    getchar(); // DEBUG
+    TADEBUG("TAMathFCI", "EigenPower: Round: %d, max_v after renormalization: %f",
+      round, mv);
+    TADEBUG_DO(v.Print(); TAException::Pause());
+    round++;
   } // end of while
 
-  cout << "The dominant eigenvalue is \033[33;1m" << mv << "\033[0m\n";
-  cout << "The corresponding eigenvector is " << endl;
-  if(mv != 0) v.Print();
-  else vzero.Print();
+  TAINFO("TAMathFCI", "EigenPower: The dominant eigenvalue is \033[33;1m%f\033[0m",
+    mv);
+  TADEBUG_DO(cout << "The corresponding eigenvector is " << endl;
+    if(mv != 0) v.Print(); else vzero.Print());
 
   return mv;
 } // end of member function EigenPower
@@ -84,24 +156,214 @@ void TAMathFCI::GramSchmidt(const TAMatrix2D &A, TAMatrix2D &Q){
   }
   if(Q.ncol() != nc || Q.nrow() != nr) Q.Resize(nr, nc);
 
+  // the columns are copied to contiguous memory for the BLAS kernels //
+  vector<double> q(long(nc)*nr), c(nc);
+  vector<const double *> pq(nc);
   for(int i = 0; i < nc; i++){
-    Q.cv(i) = A.cv(i);
-    for(int j = 0; j < i; j++){
-      Q.cv(i) -= Q.cv(j)*A.cv(i) * Q.cv(j); // subtract qj's component
-    } // end for over qj
-    Q.cv(i).normalize();
+    double *qi = q.data() + long(i)*nr;
+    pq[i] = qi;
+    for(int r = 0; r < nr; r++) qi[r] = A[r][i];
+    const double a = TABLAS::Nrm2(qi, nr);
+    TABLAS::MultiDot(pq.data(), i, qi, nr, c.data()); // qj's component
+    for(int j = 0; j < i; j++) c[j] = -c[j];
+    TABLAS::MultiAxpy(c.data(), pq.data(), i, qi, nr); // subtract them
+    // what is left of a column in the span of the former ones is round-off //
+    const double nrm = TABLAS::Nrm2(qi, nr);
+    if(nrm > 1E-12 * a) TABLAS::Scal(1. / nrm, qi, nr);
+    else{
+      TAINFO("TAMathFCI", "GramSchmidt: column %d is linearly dependent on the \
+former ones, |residual|/|column|: %g, and is left zero", i, a ? nrm / a : 0.);
+      std::fill(qi, qi + nr, 0.);
+    } // end else
+    for(int r = 0; r < nr; r++) Q[r][i] = qi[r];
   } // end loop over qi
 } // end of member function GramSchmidt
 
-// QR factorization: A=QR, R=Q^(-1)*A=Q^(T)*A
+// QR factorization: A=QR, by Householder reflections, which keep Q
+// orthogonal to machine precision, unlike Gram-Schmidt
 void TAMathFCI::QR(const TAMatrix2D &A, TAMatrix2D &Q, TAMatrix2D &R){
-  GramSchmidt(A, Q); // implement Gram-Schmidt orthogonalization
-  R = Q.Transpose()*A;
+  const int nr = A.nrow(), nc = A.ncol();
+  if(nc > nr){
+    TAException::Error("TAMathFCI",
+      "QR: Vectors to orthogonalize are larger than A's rank.");
+  }
+  vector<double> a(long(nr)*nc), tau(nc); // A in column-major
+  for(int i = 0; i < nr; i++) for(int j = 0; j < nc; j++)
+    a[i + long(j)*nr] = A[i][j];
+  HouseholderQR(a.data(), nr, nc, tau.data());
+  if(R.nrow() != nc || R.ncol() != nc) R.Resize(nc, nc);
+  for(int i = 0; i < nc; i++) for(int j = 0; j < nc; j++)
+    R[i][j] = j >= i ? a[i + long(j)*nr] : 0.;
+  HouseholderQ(a.data(), nr, nc, tau.data());
+  if(Q.nrow() != nr || Q.ncol() != nc) Q.Resize(nr, nc);
+  for(int j = 0; j < nc; j++){
+    const double sign = R[j][j] < 0. ? -1. : 1.; // for R[j][j] >= 0
+    if(sign < 0.) for(int k = j; k < nc; k++) R[j][k] = -R[j][k];
+    for(int i = 0; i < nr; i++) Q[i][j] = sign * a[i + long(j)*nr];
+  } // end for over columns
 } // end of member function QR
 
+/// the Householder vectors of columns [j0, j0+b) of a, as out of
+/// HouseholderQR, into v (rows [j0, m), column-major), with the unit diagonal
+/// and the zeros above made explicit
+static void HouseholderV(const double *a, long m, int j0, int b,
+    vector<double> &v){
+  const long mv = m - j0;
+  v.assign(mv*b, 0.);
+  for(int r = 0; r < b; r++){
+    const double *ar = a + long(j0 + r)*m + j0;
+    v[r + r*mv] = 1.;
+    for(long i = r + 1; i < mv; i++) v[i + r*mv] = ar[i];
+  } // end for over r
+} // end of function HouseholderV
+
+/// T of the block reflector H_0*H_1*...*H_b-1 = I - V*T*V^T, upper
+/// triangular, column-major, as LAPACK dlarft
+static void HouseholderT(const vector<double> &v, long mv, int b,
+    const double *tau, vector<double> &t){
+  t.assign(long(b)*b, 0.);
+  vector<const double *> pv(b);
+  for(int r = 0; r < b; r++) pv[r] = v.data() + r*mv;
+  vector<double> w(b);
+  for(int i = 0; i < b; i++){
+    t[i + i*b] = tau[i];
+    if(!i || !tau[i]) continue;
+    TABLAS::MultiDot(pv.data(), i, pv[i], mv, w.data()); // V_0..i-1^T*v_i
+    for(int r = 0; r < i; r++){
+      double s = 0.;
+      for(int c = r; c < i; c++) s += t[r + c*b] * w[c];
+      t[r + i*b] = -tau[i] * s;
+    } // end for over r
+  } // end for over i
+} // end of function HouseholderT
+
+/// c = (I - V*op(T)*V^T)*c, op(T) = T^T if trans, i.e. Q^T*c, else T, i.e.
+/// Q*c. c has mv rows and nc columns, with leading dimension ldc. Each column
+/// of c is swept twice, by MultiDot and MultiAxpy, whatever b is
+static void HouseholderApply(const vector<double> &v, long mv, int b,
+    const vector<double> &t, bool trans, double *c, long ldc, int nc){
+  vector<const double *> pv(b);
+  for(int r = 0; r < b; r++) pv[r] = v.data() + r*mv;
+  vector<double> w(b), u(b);
+  for(int j = 0; j < nc; j++){
+    double *cj = c + j*ldc;
+    TABLAS::MultiDot(pv.data(), b, cj, mv, w.data()); // w = V^T*c_j
+    for(int r = 0; r < b; r++){ // u = -op(T)*w
+      double s = 0.;
+      if(trans) for(int q = 0; q <= r; q++) s += t[q + r*b] * w[q];
+      else for(int q = r; q < b; q++) s += t[r + q*b] * w[q];
+      u[r] = -s;
+    } // end for over r
+    TABLAS::MultiAxpy(u.data(), pv.data(), b, cj, mv);
+  } // end for over columns
+} // end of function HouseholderApply
+
+/// LAPACK dgeqrf: panels of nb columns factorized column by column (dgeqr2),
+/// then applied to the trailing columns as one block reflector
+void TAMathFCI::HouseholderQR(double *a, long m, int n, double *tau,
+    int nb){
+  TAPROF_PHASE("TAMathFCI::HouseholderQR");
+  const int kmax = std::min(m, long(n));
+  if(nb < 1) nb = 1;
+  vector<double> v, t;
+  for(int j0 = 0; j0 < kmax; j0 += nb){
+    const int b = std::min(nb, kmax - j0);
+    // the panel //
+    for(int j = j0; j < j0 + b; j++){
+      double *x = a + long(j)*m + j;
+      const long len = m - j;
+      const double alpha = x[0];
+      const double xnorm = len > 1 ? TABLAS::Nrm2(x + 1, len - 1) : 0.;
+      if(!xnorm){ tau[j] = 0.; continue; } // H = I
+      const double beta = -copysign(hypot(alpha, xnorm), alpha);
+      tau[j] = (beta - alpha) / beta;
+      TABLAS::Scal(1. / (alpha - beta), x + 1, len - 1);
+      x[0] = beta;
+      for(int c = j + 1; c < j0 + b; c++){ // H_j on the rest of the panel
+        double *y = a + long(c)*m + j;
+        const double s = tau[j] * (y[0] + TABLAS::Dot(x + 1, y + 1, len - 1));
+        y[0] -= s;
+        TABLAS::Axpy(-s, x + 1, y + 1, len - 1);
+      } // end for over c
+    } // end for over j
+    // the trailing columns //
+    if(j0 + b >= n) continue;
+    HouseholderV(a, m, j0, b, v);
+    HouseholderT(v, m - j0, b, tau + j0, t);
+    HouseholderApply(v, m - j0, b, t, true, a + long(j0 + b)*m + j0, m,
+      n - j0 - b);
+  } // end for over panels
+} // end of member function HouseholderQR
+
+/// Q = H_0*H_1*...*I[:, 0:n], the block reflectors applied from the last on,
+/// each to the rows and columns from its own on
+void TAMathFCI::HouseholderQ(double *a, long m, int n, const double *tau,
+    int nb){
+  TAPROF_PHASE("TAMathFCI::HouseholderQ");
+  if(n > m) TAException::Error("TAMathFCI",
+    "HouseholderQ: %d columns, more than the %ld rows", n, m);
+  if(nb < 1) nb = 1;
+  const vector<double> h(a, a + m*n); // the Householder vectors
+  for(long l = 0; l < m*n; l++) a[l] = 0.;
+  for(int j = 0; j < n; j++) a[j + j*m] = 1.;
+  vector<double> v, t;
+  for(int j0 = (n - 1) / nb * nb; j0 >= 0; j0 -= nb){
+    const int b = std::min(nb, n - j0);
+    HouseholderV(h.data(), m, j0, b, v);
+    HouseholderT(v, m - j0, b, tau + j0, t);
+    HouseholderApply(v, m - j0, b, t, false, a + long(j0)*m + j0, m, n - j0);
+  } // end for over blocks
+} // end of member function HouseholderQ
+
+/// X_r = Q_r*R_r on each rank, then the stacked R_r = Q'*R, so that
+/// X_r = (Q_r*Q'_r)*R, Q'_r being the rows of Q' of rank r. R_r has only
+/// p_r = min(nl_r, k) rows, each a column of Q_r, so that the Q_r*Q'_r make
+/// up an orthonormal Q even if X is rank-deficient
+void TAMathFCI::TSQR(double *x, long nl, int k, TAMatrix2D &R){
+  TAPROF_PHASE("TAMathFCI::TSQR");
+  const int size = TAMPI::Size(), rank = TAMPI::Rank();
+  const int p = std::min(nl, long(k));
+  vector<double> tau(k);
+  HouseholderQR(x, nl, k, tau.data());
+  vector<double> rows(size, 0.); // p_r of all the ranks
+  rows[rank] = p;
+  TAMPI::Sum(rows);
+  long ms = 0, r0 = 0; // the rows of the stacked R_r, and the first of rank
+  for(int i = 0; i < size; i++){
+    if(i == rank) r0 = ms;
+    ms += long(rows[i]);
+  } // end for over ranks
+  if(ms < k) TAException::Error("TAMathFCI",
+    "TSQR: %d vectors, more than the %ld rows", k, ms);
+  vector<double> s(ms*k, 0.);
+  for(int j = 0; j < k; j++) for(int i = 0; i <= std::min(j, p - 1); i++)
+    s[r0 + i + j*ms] = x[i + j*nl];
+  TAMPI::Sum(s);
+  vector<double> tau2(k);
+  HouseholderQR(s.data(), ms, k, tau2.data());
+  R.Resize(k, k);
+  for(int i = 0; i < k; i++) for(int j = 0; j < k; j++)
+    R[i][j] = j >= i ? s[i + j*ms] : 0.;
+  HouseholderQ(s.data(), ms, k, tau2.data());
+  if(p) HouseholderQ(x, nl, p, tau.data());
+
+  // x = Q_r*Q'_r, with the signs for R[j][j] >= 0 //
+  vector<double> q(nl*k, 0.), c(p);
+  vector<const double *> pq(p);
+  for(int i = 0; i < p; i++) pq[i] = x + i*nl;
+  for(int j = 0; j < k; j++){
+    const double sign = R[j][j] < 0. ? -1. : 1.;
+    if(sign < 0.) for(int l = j; l < k; l++) R[j][l] = -R[j][l];
+    for(int i = 0; i < p; i++) c[i] = sign * s[r0 + i + j*ms];
+    TABLAS::MultiAxpy(c.data(), pq.data(), p, q.data() + j*nl, nl);
+  } // end for over j
+  std::copy(q.begin(), q.end(), x);
+} // end of member function TSQR
+
 /// solve all the eigenvalues of a matrix using QR method
 /// \param v: to store all the eigenvalues
 void TAMathFCI::EigenQR(const TAMatrix2D &A, TAMatrix2D &v){
+  TAPROF_PHASE("TAMathFCI::EigenQR");
   const int n = A.nrow(), nc = A.ncol();
   if(nc != n){
     TAException::Error("TAMathFCI",
@@ -110,40 +372,35 @@ void TAMathFCI::EigenQR(const TAMatrix2D &A, TAMatrix2D &v){
 
   if(!v.IsVector() || v.ncol() < n) v.Resize(n, 1);
   TAMatrix2D Q(n, n), R(n, n), Ak(A);
-  TAMatrix2D Qv(n, n); Qv = 1.; // DEBUG
+  TAMatrix2D Qv; // accumulated Q, only tracked in debug mode
+  TADEBUG_DO(Qv.Resize(n, n); Qv = 1.);
   double epsilon = 1E200; // the sum of elements below the diagonal of Ak
+  int round = 0;
   while(epsilon > 1E-2){
-    static int round = 0; // DEBUG
-    cout << "Round: " << round++ << " ____________" << endl; // DEBUG
     // the core algorithm //
     QR(Ak, Q, R); // QR factorization: An=Q_n * R_n
     Ak = R*Q; // A_(n+1) = R_n * Q_n
-    Qv *= Q;
+    TADEBUG_DO(Qv *= Q);
 
     // calculate epsilon //
     epsilon = 0.;
     for(int i = 0; i < n; i++)
       for(int j = 0; j < i; j++) epsilon += fabs(Ak[i][j]);
 
-    Q.Print(); // DEBUG
-    R.Print(); // DEBUG
-    (Q*R).Print(); // DEBUG
-    (Q*Q.Transpose()).Print(); // DEBUG
-    Ak.Print(); // DEBUG
-    Qv.Print(); // DEBUG
-    cout << "epsilon: " << epsilon << endl << endl; // DEBUG
-    getchar(); // DEBUG
+    TADEBUG("TAMathFCI", "EigenQR: Round: %d, epsilon: %f", round, epsilon);
+    TADEBUG_DO(Q.Print(); R.Print(); (Q*R).Print(); (Q*Q.Transpose()).Print();
+      Ak.Print(); Qv.Print(); TAException::Pause());
+    round++;
   }
   // output the diagonal elements to v as the obtained eigenvalue set
   for(int i = 0; i < n; i++) v[i][0] = Ak[i][i];
 
-  Ak.Print(); // DEBUG
-  v.Print(); // DEBUG
-  Qv.Print(); // DEBUG
+  TADEBUG_DO(Ak.Print(); v.Print(); Qv.Print());
 }
 
 // solve all the eigenvalues (in v) and eigenvectors (in Q) using Jacobi method
 void TAMathFCI::EigenJacobi(const TAMatrix2D &A, TAMatrix2D &P, TAMatrix2D &v){
+  TAPROF_PHASE("TAMathFCI::EigenJacobi");
   if(!A.IsSymmetric())
     TAException::Error("TAMathFCI",
       "EigenJacobi: Input matrix is not symmetric");
@@ -154,19 +411,17 @@ void TAMathFCI::EigenJacobi(const TAMatrix2D &A, TAMatrix2D &P, TAMatrix2D &v){
   // A_(k+1) = Rk^T*A_k*Rk; P = R1*R2* ... *R(k-2)*R(k-1)*Rk; P^(-1)AP = D
   TAMatrix2D R(n, n), Ak(A); // R: the rotation matrix
   P = 1.; // initialize to unit matrix
-  P.Print(); // DEBUG
-  Ak.Print(); // DEBUG
+  TADEBUG_DO(P.Print(); Ak.Print());
   double mx = 1E20; int p, q; // mx = Ak[p][q] = max(|a_ij|): pivotal element
+  int round = 0;
   while(mx > 1E-3){
     // single out the pivotal element //
-    static int round = 0; // DEBUG
     mx = 0;
     double tmp = 0;
     for(int i = 1; i < n; i++) for(int j = 0; j < i; j++)
       if((tmp = fabs(Ak[i][j])) > mx){ p = i; q = j; mx = tmp; }
-    cout << "round: " << round++ << endl; // DEBUG
-    cout << " mx: " << mx << " A[" << p+1 << "][" << q+1 << "]: "; // DEBUG
-    cout << Ak[p][q] << endl; // DEBUG
+    TADEBUG("TAMathFCI", "EigenJacobi: round: %d, mx: %f, A[%d][%d]: %f",
+      round, mx, p+1, q+1, Ak[p][q]);
 
     // implement the rotation //
     // prepare the rotation matrix -----
@@ -179,16 +434,164 @@ void TAMathFCI::EigenJacobi(const TAMatrix2D &A, TAMatrix2D &P, TAMatrix2D &v){
     // apply the rotation to Ak
     Ak = R.Transpose()*Ak*R;
     P *= R; // accumulate the rotation action
-    cout << "c: " << c << " t: " << t << endl; // DEBUG
-    cout << "sinT: " << sinT << " cosT: " << cosT << endl; // DEBUG
-    R.Print(); // DEBUG
-    P.Print(); // DEBUG
-    Ak.Print(); // DEBUG
-    getchar(); // DEBUG
+    TADEBUG_DO(cout << "c: " << c << " t: " << t << endl;
+      cout << "sinT: " << sinT << " cosT: " << cosT << endl;
+      R.Print(); P.Print(); Ak.Print(); TAException::Pause());
+    round++;
   } // end while
   // output the result
   for(int i = 0; i < n; i++) v[i][0] = Ak[i][i];
-  Ak.Print(); // DEBUG
-  P.Print(); // DEBUG
-  v.Print(); // DEBUG
+  TADEBUG_DO(Ak.Print(); P.Print(); v.Print());
 } // end
+
+/// solve all the eigenvalues and eigenvectors of a symmetric A using
+/// Householder tridiagonalization followed by the implicit QL method
+/// \param P: column vectors represent eigenvector
+/// \param v: eigenvalues in ascending order, corresponding to columns in P
+void TAMathFCI::EigenHouseholder(const TAMatrix2D &A, TAMatrix2D &P,
+    TAMatrix2D &v){
+  TAPROF_PHASE("TAMathFCI::EigenHouseholder");
+  if(!A.IsSymmetric())
+    TAException::Error("TAMathFCI",
+      "EigenHouseholder: Input matrix is not symmetric");
+  const int n = A.ncol();
+  if(P.nrow() != n || P.ncol() != n) P.Resize(n, n);
+  if(!v.IsVector() || v.nrow() != n) v.Resize(n, 1);
+
+  // a[i*n+j] = A[i][j], to be replaced by the Householder transformation //
+  vector<double> a(n*n), d(n), e(n);
+  for(int i = 0; i < n; i++) for(int j = 0; j < n; j++) a[i*n+j] = A[i][j];
+
+  // Householder reduction to the tridiagonal form: A = Q*T*Q^T //
+  for(int i = n - 1; i > 0; i--){
+    const int l = i - 1;
+    double h = 0., scale = 0.;
+    if(l > 0){
+      for(int k = 0; k <= l; k++) scale += fabs(a[i*n+k]);
+      if(0. == scale) e[i] = a[i*n+l]; // skip the transformation
+      else{
+        for(int k = 0; k <= l; k++){
+          a[i*n+k] /= scale;
+          h += a[i*n+k]*a[i*n+k];
+        } // end for over k
+        double f = a[i*n+l];
+        double g = f >= 0. ? -sqrt(h) : sqrt(h);
+        e[i] = scale*g; h -= f*g; a[i*n+l] = f - g; f = 0.;
+        for(int j = 0; j <= l; j++){
+          a[j*n+i] = a[i*n+j] / h; // store u/H in the i-th column
+          g = 0.; // form an element of A*u in g
+          for(int k = 0; k <= j; k++) g += a[j*n+k]*a[i*n+k];
+          for(int k = j + 1; k <= l; k++) g += a[k*n+j]*a[i*n+k];
+          e[j] = g / h; // form p in the temporarily unused e
+          f += e[j]*a[i*n+j];
+        } // end for over j
+        const double hh = f / (h + h);
+        for(int j = 0; j <= l; j++){ // form q and store in e, then reduce A
+          f = a[i*n+j];
+          e[j] = g = e[j] - hh*f;
+          for(int k = 0; k <= j; k++) a[j*n+k] -= f*e[k] + g*a[i*n+k];
+        } // end for over j
+      } // end else
+    } // end if
+    else e[i] = a[i*n+l];
+    d[i] = h;
+  } // end for over i
+  d[0] = 0.; e[0] = 0.;
+  // accumulate the transformation matrix Q //
+  for(int i = 0; i < n; i++){
+    const int l = i - 1;
+    if(d[i]){
+      for(int j = 0; j <= l; j++){
+        double g = 0.;
+        for(int k = 0; k <= l; k++) g += a[i*n+k]*a[k*n+j];
+        for(int k = 0; k <= l; k++) a[k*n+j] -= g*a[k*n+i];
+      } // end for over j
+    } // end if
+    d[i] = a[i*n+i];
+    a[i*n+i] = 1.;
+    for(int j = 0; j <= l; j++) a[j*n+i] = a[i*n+j] = 0.;
+  } // end for over i
+  // e[i] couples i-1 and i so far, shift it to meet EigenTridiagonal //
+  for(int i = 1; i < n; i++) e[i-1] = e[i];
+  e[n-1] = 0.;
+
+  for(int i = 0; i < n; i++) for(int j = 0; j < n; j++) P[i][j] = a[i*n+j];
+  EigenTridiagonal(d, e, &P);
+  for(int i = 0; i < n; i++) v[i][0] = d[i];
+} // end of member function EigenHouseholder
+
+/// solve a symmetric tridiagonal matrix using the implicit QL method
+/// \param d: the diagonal, overwritten by eigenvalues in ascending order
+/// \param e: the subdiagonal, e[i] couples i and i+1; destroyed on output
+/// \param z: if not null, rotated into the eigenvectors (in columns). Its
+/// rows are rotated apart, so that some rows of the unit matrix give just those
+/// components of the eigenvectors, at a cost of O(n^2) per row
+void TAMathFCI::EigenTridiagonal(vector<double> &d, vector<double> &e,
+    TAMatrix2D *z){
+  const int n = d.size();
+  if(!n) return;
+  if(int(e.size()) < n) e.resize(n, 0.);
+  e[n-1] = 0.;
+  if(z && z->ncol() != n){
+    TAException::Error("TAMathFCI", "EigenTridiagonal: z is not of %d \
+columns", n);
+  }
+  // zz[k*n+i] = z[k][i], so that the rotations run over raw memory //
+  const int nr = z ? z->nrow() : 0;
+  vector<double> zz;
+  if(z){
+    zz.resize(nr*n);
+    for(int k = 0; k < nr; k++) for(int i = 0; i < n; i++) zz[k*n+i] = (*z)[k][i];
+  } // end if
+
+  for(int l = 0; l < n; l++){
+    int iter = 0, m;
+    do{
+      for(m = l; m < n - 1; m++){ // look for a small subdiagonal element
+        const double dd = fabs(d[m]) + fabs(d[m+1]);
+        if(fabs(e[m]) <= 1E-15*dd) break;
+      } // end for over m
+      if(m == l) break;
+      if(iter++ == 60){
+        TAException::Warn("TAMathFCI",
+          "EigenTridiagonal: too many iterations for eigenvalue %d", l);
+        break;
+      } // end if
+      double g = (d[l+1] - d[l]) / (2.*e[l]); // form the shift
+      double r = hypot(g, 1.);
+      g = d[m] - d[l] + e[l] / (g + (g >= 0. ? fabs(r) : -fabs(r)));
+      double s = 1., c = 1., p = 0.;
+      int i;
+      for(i = m - 1; i >= l; i--){ // plane rotation and Givens rotation
+        const double f = s*e[i], b = c*e[i];
+        e[i+1] = (r = hypot(f, g));
+        if(0. == r){ // recover from underflow
+          d[i+1] -= p; e[m] = 0.;
+          break;
+        } // end if
+        s = f / r; c = g / r;
+        g = d[i+1] - p;
+        r = (d[i] - g)*s + 2.*c*b;
+        d[i+1] = g + (p = s*r);
+        g = c*r - b;
+        if(z) for(int k = 0; k < nr; k++){ // form the eigenvectors
+          const double t = zz[k*n+i+1];
+          zz[k*n+i+1] = s*zz[k*n+i] + c*t;
+          zz[k*n+i] = c*zz[k*n+i] - s*t;
+        } // end for over k
+      } // end for over i
+      if(0. == r && i >= l) continue;
+      d[l] -= p; e[l] = g; e[m] = 0.;
+    } while(m != l);
+  } // end for over l
+
+  // sort the eigenvalues into ascending order, together with the vectors //
+  for(int i = 0; i < n - 1; i++){
+    int k = i;
+    for(int j = i + 1; j < n; j++) if(d[j] < d[k]) k = j;
+    if(k == i) continue;
+    std::swap(d[i], d[k]);
+    if(z) for(int j = 0; j < nr; j++) std::swap(zz[j*n+i], zz[j*n+k]);
+  } // end for over i
+  if(z) for(int k = 0; k < nr; k++) for(int i = 0; i < n; i++) (*z)[k][i] = zz[k*n+i];
+} // end of member function EigenTridiagonal
@@ -0,0 +1,272 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAOneBodyOperator.cxx
+  \class TAOneBodyOperator
+  \brief The mu-th component of a one-body spherical tensor operator of rank
+  lambda, O = sum_pq <p|O|q> a+_p * a_q, e.g. the electromagnetic transition
+  operators. It is defined by the reduced matrix elements <a||O||b> between the
+  SP states, functions of their n, l and j, from which <p|O|q> follow by the
+  Wigner-Eckart theorem
+    <j m|O_mu|j' m'> = (-1)^(j-m) * (j lambda j'; -m mu m') * <j||O||j'>,
+  in Edmonds' convention, the SP states being |(l 1/2) j m>. O is applied to
+  the many-body states matrix-free with TAManyBodySDList::Apply, from one M
+  block to another if mu != 0. From <Jf Mf|O_mu|Ji Mi> the reduced matrix
+  element and B(lambda; Ji -> Jf) follow as well, J being identified by <J^2>.
+  The states are the local segments of TAMPI::Partition over their M blocks,
+  as out of TALanczos, so the strengths come in the process of the
+  diagonalization, with no vector dumps.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cmath>
+#include "TAOneBodyOperator.h"
+#include "TAManyBodySDManager.h"
+#include "TAManyBodySDList.h"
+#include "TASingleParticleState.h"
+#include "TASingleParticleStateManager.h"
+#include "TAMathFCI.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+static const double PI = 3.14159265358979323846;
+
+/// \retval (-1)^n
+static inline double Sign(int n){ return n % 2 ? -1. : 1.; }
+
+/// \retval <l||Y_k||l'> = (-1)^l*sqrt((2l+1)(2k+1)(2l'+1)/4pi)*(l k l';0 0 0)
+static double YReduced(int l, int k, int lp){
+  return Sign(l) * sqrt((2*l+1)*(2*k+1)*(2*lp+1) / (4.*PI)) *
+    TAMathFCI::ThreeJ(2*l, 2*k, 2*lp, 0, 0, 0);
+} // end of function YReduced
+
+/// \retval <l 1/2 j||T_k||l' 1/2 j'> of T_k acting on the orbital part only,
+/// given tl = <l||T_k||l'>, Edmonds (7.1.7). All in doubled arguments
+static double OrbitalPart(int tl, int tj, int tlp, int tjp, int tk, double t){
+  return Sign((tl + 1 + tjp + tk) / 2) * sqrt((tj + 1.) * (tjp + 1.)) *
+    TAMathFCI::SixJ(tl, tj, 1, tjp, tlp, tk) * t;
+} // end of function OrbitalPart
+
+/// \retval <l 1/2 j||U_k||l 1/2 j'> of U_k acting on the spin only, given
+/// t = <1/2||U_k||1/2>, Edmonds (7.1.8). All in doubled arguments
+static double SpinPart(int tl, int tj, int tjp, int tk, double t){
+  return Sign((tl + 1 + tj + tk) / 2) * sqrt((tj + 1.) * (tjp + 1.)) *
+    TAMathFCI::SixJ(1, tj, tl, tjp, 1, tk) * t;
+} // end of function SpinPart
+
+/// \retval the harmonic oscillator radial function R_nl(r) on the grid r of
+/// length b: r^l*exp(-r^2/2b^2)*L_n^(l+1/2)(r^2/b^2), normalized with the
+/// weights w, i.e. sum_i w_i*(r_i*R_i)^2 = 1, and positive at the origin
+static vector<double> HORadial(int n, int l, double b, const vector<double> &r,
+    const vector<double> &w){
+  const double alpha = l + 0.5;
+  vector<double> f(r.size());
+  double norm = 0.;
+  for(size_t i = 0; i < r.size(); i++){
+    const double x = r[i]*r[i] / (b*b);
+    double l0 = 1., l1 = 1. + alpha - x; // the Laguerre recurrence
+    if(!n) l1 = l0;
+    for(int k = 1; k < n; k++){
+      const double l2 = ((2*k + 1 + alpha - x)*l1 - (k + alpha)*l0) / (k + 1);
+      l0 = l1; l1 = l2;
+    } // end for over k
+    f[i] = pow(r[i] / b, l) * exp(-x / 2.) * l1;
+    norm += w[i] * r[i]*r[i] * f[i]*f[i];
+  } // end for over i
+  for(double &x : f) x /= sqrt(norm);
+  return f;
+} // end of function HORadial
+
+TAOneBodyOperator::TAOneBodyOperator(int lambda, int mu,
+    const TAReduced &reduced) : fLambda(lambda), fMu(mu){
+  if(lambda < 0 || abs(mu) > lambda)
+    TAException::Error("TAOneBodyOperator", "TAOneBodyOperator: illegal rank %d \
+and component %d", lambda, mu);
+  const vector<TASingleParticleState *> &sp =
+    TASingleParticleStateManager::Instance()->GetSPStateVec();
+  fNSPState = sp.size();
+  fME.assign(fNSPState*fNSPState, 0.);
+  // q varying slowest, for the reuse in Apply //
+  for(int q = 0; q < fNSPState; q++) for(int p = 0; p < fNSPState; p++){
+    const TASingleParticleState *a = sp[p], *b = sp[q];
+    if(a->Get2Mj() != b->Get2Mj() + 2*mu) continue;
+    const double cg = TAMathFCI::ThreeJ(a->Get2J(), 2*lambda, b->Get2J(),
+      -a->Get2Mj(), 2*mu, b->Get2Mj());
+    if(!cg) continue;
+    const double me = Sign((a->Get2J() - a->Get2Mj()) / 2) * cg *
+      reduced(sp[p], sp[q]);
+    if(fabs(me) < 1e-14) continue;
+    fME[p*fNSPState + q] = me;
+    fOp.insert(fOp.end(), {p, q});
+    fOpCoe.push_back(me);
+  } // end for over p and q
+  TAINFO("TAOneBodyOperator", "TAOneBodyOperator: lambda=%d, mu=%d, %d non-\
+zero <p|O|q>", lambda, mu, int(fOpCoe.size()));
+} // end of the constructor
+
+/// <a||e*r^lambda*Y_lambda||b>, the radial integral by the Simpson rule
+TAOneBodyOperator::TAReduced TAOneBodyOperator::E(int lambda, double b,
+    double e){
+  // the grid for the radial integrals, to well beyond the outmost node //
+  const int n = 2000;
+  const double rmax = 15. * b, h = rmax / n;
+  vector<double> r(n+1), w(n+1);
+  for(int i = 0; i <= n; i++){
+    r[i] = i * h;
+    w[i] = h / 3. * (i == 0 || i == n ? 1. : (i % 2 ? 4. : 2.));
+  } // end for over i
+  return [=](TASingleParticleState *a, TASingleParticleState *c){
+    const int la = a->GetL(), lc = c->GetL();
+    if((la + lc + lambda) % 2) return 0.; // parity
+    const double y = YReduced(la, lambda, lc);
+    if(!y) return 0.;
+    const vector<double> ra = HORadial(a->GetN(), la, b, r, w);
+    const vector<double> rc = HORadial(c->GetN(), lc, b, r, w);
+    double rad = 0.;
+    for(int i = 0; i <= n; i++)
+      rad += w[i] * r[i]*r[i] * ra[i] * pow(r[i], lambda) * rc[i];
+    return e * rad * OrbitalPart(2*la, a->Get2J(), 2*lc, c->Get2J(),
+      2*lambda, y);
+  };
+} // end of member function E
+
+/// <a||sqrt(3/4pi)*(gl*l + gs*s)||b>, diagonal in n and l
+TAOneBodyOperator::TAReduced TAOneBodyOperator::M1(double gl, double gs){
+  return [=](TASingleParticleState *a, TASingleParticleState *b){
+    const int l = a->GetL();
+    if(a->GetN() != b->GetN() || l != b->GetL()) return 0.;
+    const double ll = OrbitalPart(2*l, a->Get2J(), 2*l, b->Get2J(), 2,
+      sqrt(l * (l + 1.) * (2*l + 1.)));
+    const double ss = SpinPart(2*l, a->Get2J(), b->Get2J(), 2, sqrt(1.5));
+    return sqrt(3. / (4.*PI)) * (gl * ll + gs * ss);
+  };
+} // end of member function M1
+
+/// <a||j||b> = delta_ab*sqrt(j(j+1)(2j+1))
+TAOneBodyOperator::TAReduced TAOneBodyOperator::J(){
+  return [](TASingleParticleState *a, TASingleParticleState *b){
+    if(a->GetN() != b->GetN() || a->GetL() != b->GetL() ||
+      a->Get2J() != b->Get2J()) return 0.;
+    const double j = a->Get2J() / 2.;
+    return sqrt(j * (j + 1.) * (2.*j + 1.));
+  };
+} // end of member function J
+
+double TAOneBodyOperator::operator()(int p, int q) const{
+  if(p < 0 || p >= fNSPState || q < 0 || q >= fNSPState)
+    TAException::Error("TAOneBodyOperator", "operator(): (%d, %d) out of \
+range, nSPState: %d", p, q, fNSPState);
+  return fME[p*fNSPState + q];
+} // end of member function operator()
+
+/// y = O*x: the kets of x on this rank are applied to, into the whole y over
+/// to, then summed over the ranks, and the local segment kept
+void TAOneBodyOperator::Multiply(const TAManyBodySDList *from,
+    const vector<double> &x, const TAManyBodySDList *to,
+    vector<double> &y) const{
+  TAPROF_PHASE("TAOneBodyOperator::Multiply");
+  if(to->Get2M() != from->Get2M() + 2*fMu)
+    TAException::Error("TAOneBodyOperator", "Multiply: 2M: %d -> %d, while \
+mu = %d", from->Get2M(), to->Get2M(), fMu);
+  int r0, r1, s0, s1;
+  TAMPI::Partition(from->GetNBasis(), r0, r1);
+  TAMPI::Partition(to->GetNBasis(), s0, s1);
+  if(int(x.size()) != r1 - r0)
+    TAException::Error("TAOneBodyOperator", "Multiply: |x|: %d, while the \
+local rows are [%d, %d)", int(x.size()), r0, r1);
+  const int nOp = fOpCoe.size();
+  vector<double> full(to->GetNBasis(), 0.);
+  double *f = full.data();
+#pragma omp parallel
+  {
+    vector<int> phase(nOp), target(nOp);
+#pragma omp for schedule(dynamic, 64)
+    for(int j = r0; j < r1; j++){
+      const double xj = x[j-r0];
+      if(!xj || !nOp) continue;
+      from->Apply(j, 1, fOp.data(), nOp, phase.data(), target.data(), to);
+      for(int i = 0; i < nOp; i++) if(phase[i]){
+        const double c = fOpCoe[i] * phase[i] * xj;
+#pragma omp atomic
+        f[target[i]] += c;
+      } // end for over operators
+    } // end for over kets
+  } // end of the parallel region
+  TAMPI::Sum(full);
+  y.assign(full.begin() + s0, full.begin() + s1);
+} // end of member function Multiply
+
+/// <y|O|x> = sum_j x_j * sum_pq <p|O|q> * <y|a+_p * a_q|j>
+double TAOneBodyOperator::Element(const TAManyBodySDList *to,
+    const vector<double> &y, const TAManyBodySDList *from,
+    const vector<double> &x) const{
+  TAPROF_PHASE("TAOneBodyOperator::Element");
+  if(to->Get2M() != from->Get2M() + 2*fMu)
+    TAException::Error("TAOneBodyOperator", "Element: 2M: %d -> %d, while \
+mu = %d", from->Get2M(), to->Get2M(), fMu);
+  int r0, r1;
+  TAMPI::Partition(from->GetNBasis(), r0, r1);
+  if(int(x.size()) != r1 - r0)
+    TAException::Error("TAOneBodyOperator", "Element: |x|: %d, while the \
+local rows are [%d, %d)", int(x.size()), r0, r1);
+  vector<double> full; // the whole bra
+  TAMPI::AllGather(y, full, to->GetNBasis());
+  const int nOp = fOpCoe.size();
+  double s = 0.;
+#pragma omp parallel reduction(+:s)
+  {
+    vector<int> phase(nOp), target(nOp);
+#pragma omp for schedule(dynamic, 64)
+    for(int j = r0; j < r1; j++){
+      const double xj = x[j-r0];
+      if(!xj || !nOp) continue;
+      from->Apply(j, 1, fOp.data(), nOp, phase.data(), target.data(), to);
+      for(int i = 0; i < nOp; i++) if(phase[i])
+        s += full[target[i]] * fOpCoe[i] * phase[i] * xj;
+    } // end for over kets
+  } // end of the parallel region
+  return TAMPI::Sum(s);
+} // end of member function Element
+
+/// <Jf||O||Ji> = <Jf Mf|O_mu|Ji Mi> / ((-1)^(Jf-Mf) * (Jf lambda Ji; -Mf mu Mi))
+double TAOneBodyOperator::Reduced(int tJf, const TAManyBodySDList *to,
+    const vector<double> &y, int tJi, const TAManyBodySDList *from,
+    const vector<double> &x) const{
+  const int tMf = to->Get2M(), tMi = from->Get2M();
+  const double cg = TAMathFCI::ThreeJ(tJf, 2*fLambda, tJi, -tMf, 2*fMu, tMi);
+  if(!cg){
+    TADEBUG("TAOneBodyOperator", "Reduced: (%d/2 %d %d/2; %d/2 %d %d/2) \
+vanishes, so does the transition by the selection rules", tJf, fLambda, tJi,
+      -tMf, fMu, tMi);
+    return 0.;
+  } // end if
+  return Element(to, y, from, x) / (Sign((tJf - tMf) / 2) * cg);
+} // end of member function Reduced
+
+double TAOneBodyOperator::B(const TAManyBodySDList *to,
+    const vector<double> &y, const TAManyBodySDList *from,
+    const vector<double> &x) const{
+  const int tJi = lround(2. * AngularMomentum(from, x));
+  const int tJf = lround(2. * AngularMomentum(to, y));
+  const double r = Reduced(tJf, to, y, tJi, from, x);
+  return r * r / (tJi + 1.);
+} // end of member function B
+
+/// <J^2> = <J_- J_+> + M^2 + M = 2|J_+1 x|^2 + M^2 + M, J_+1 = -J_+/sqrt(2)
+double TAOneBodyOperator::AngularMomentum(const TAManyBodySDList *list,
+    const vector<double> &x){
+  const TAManyBodySDList *up =
+    TAManyBodySDManager::Instance()->GetMBSDList(list->Get2M() + 2);
+  const TAOneBodyOperator jp(1, 1, J());
+  vector<double> y;
+  jp.Multiply(list, x, up, y);
+  const double m = list->Get2M() / 2.;
+  const double j2 = (2. * TAMPI::Dot(y, y) + m*m + m) / TAMPI::Dot(x, x);
+  const double j = (sqrt(1. + 4. * j2) - 1.) / 2.;
+  if(fabs(2.*j - lround(2.*j)) > 1e-6)
+    TAINFO("TAOneBodyOperator", "AngularMomentum: J = %f, not a good \
+quantum number", j);
+  return j;
+} // end of member function AngularMomentum
@@ -0,0 +1,197 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAOutOfCoreMatrix.cxx
+  \class TAOutOfCoreMatrix
+  \brief A sparse symmetric matrix kept on local disk instead of in memory, for
+  Hamiltonians too large for RAM. The rows are computed once, packed into
+  blocks of compressed sparse rows (CSR) and appended to a scratch file. The
+  product O*v then streams the blocks back, reading block k+1 in the background
+  while block k is being multiplied (double buffering), so that the disk time
+  hides behind the arithmetic. Under MPI each rank stores its own rows only,
+  in a file of its own.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <future>
+#include <algorithm>
+#include "TAOutOfCoreMatrix.h"
+#include "TAHamiltonian.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+TAOutOfCoreMatrix::TAOutOfCoreMatrix(const string &file) : fFile(file),
+    fStream(nullptr), fKeepFile(false), fSingle(false), fBlockSize(1L<<22),
+    fNBasis(0), fR0(0), fR1(0), fNNZ(0){
+  if(TAMPI::Size() > 1) fFile += "." + std::to_string(TAMPI::Rank());
+} // end of the constructor
+
+TAOutOfCoreMatrix::~TAOutOfCoreMatrix(){
+  if(fStream){
+    fclose(fStream); fStream = nullptr;
+    if(!fKeepFile) remove(fFile.c_str());
+  } // end if
+} // end of the destructor
+
+// compute the rows of this rank and write them to disk block by block
+void TAOutOfCoreMatrix::Build(TAHamiltonian *h){
+  TAPROF_PHASE("TAOutOfCoreMatrix::Build");
+  if(fStream) fclose(fStream);
+  if(!(fStream = fopen(fFile.c_str(), "w+b"))){
+    TAException::Error("TAOutOfCoreMatrix", "Build: cannot open %s",
+      fFile.c_str());
+    return;
+  } // end if
+  fNBasis = h->GetNBasis();
+  TAMPI::Partition(fNBasis, fR0, fR1);
+  fNNZ = 0;
+  fBlockR0.clear(); fBlockOffset.clear();
+
+  TABlock b;
+  b.r0 = fR0; b.ptr.assign(1, 0);
+  vector<int> cols; vector<double> vals;
+  for(int rr = fR0; rr < fR1; rr++){
+    h->SparseRow(rr, cols, vals);
+    b.col.insert(b.col.end(), cols.begin(), cols.end());
+    if(fSingle) b.valf.insert(b.valf.end(), vals.begin(), vals.end());
+    else b.val.insert(b.val.end(), vals.begin(), vals.end());
+    b.ptr.push_back(b.col.size());
+    if(long(b.col.size()) >= fBlockSize || rr == fR1 - 1){
+      b.r1 = rr + 1;
+      WriteBlock(b);
+      fNNZ += b.col.size();
+      b.r0 = rr + 1; b.ptr.assign(1, 0);
+      b.col.clear(); b.val.clear(); b.valf.clear();
+    } // end if
+    TAPROF_PROGRESS("TAOutOfCoreMatrix::Build", rr - fR0 + 1, fR1 - fR0);
+  } // end for over rows
+  fflush(fStream);
+
+  TAINFO("TAOutOfCoreMatrix", "Build: rows [%d, %d), nnz: %ld, %d blocks, \
+%.1f MB in %s, %s precision", fR0, fR1, fNNZ, GetNBlock(),
+    ftell(fStream) / 1048576., fFile.c_str(), fSingle ? "single" : "double");
+} // end of member function Build
+
+// append b to the file: r0, r1, nnz, ptr, col and val in a row
+void TAOutOfCoreMatrix::WriteBlock(const TABlock &b){
+  fseek(fStream, 0, SEEK_END);
+  fBlockR0.push_back(b.r0);
+  fBlockOffset.push_back(ftell(fStream));
+  const long nnz = b.col.size();
+  bool ok = fwrite(&b.r0, sizeof(int), 1, fStream) == 1 &&
+    fwrite(&b.r1, sizeof(int), 1, fStream) == 1 &&
+    fwrite(&nnz, sizeof(long), 1, fStream) == 1 &&
+    fwrite(b.ptr.data(), sizeof(long), b.ptr.size(), fStream) == b.ptr.size();
+  if(ok && nnz) ok = fwrite(b.col.data(), sizeof(int), nnz, fStream) == size_t(nnz) &&
+    (fSingle ? fwrite(b.valf.data(), sizeof(float), nnz, fStream) :
+      fwrite(b.val.data(), sizeof(double), nnz, fStream)) == size_t(nnz);
+  if(!ok) TAException::Error("TAOutOfCoreMatrix",
+    "WriteBlock: writing rows [%d, %d) to %s failed. Disk full?", b.r0, b.r1,
+    fFile.c_str());
+} // end of member function WriteBlock
+
+// read the k-th block into b. Only one block is read at a time
+void TAOutOfCoreMatrix::ReadBlock(int k, TABlock *b){
+  long nnz = 0;
+  fseek(fStream, fBlockOffset[k], SEEK_SET);
+  bool ok = fread(&b->r0, sizeof(int), 1, fStream) == 1 &&
+    fread(&b->r1, sizeof(int), 1, fStream) == 1 &&
+    fread(&nnz, sizeof(long), 1, fStream) == 1;
+  if(ok){
+    b->ptr.resize(b->r1 - b->r0 + 1); b->col.resize(nnz);
+    if(fSingle) b->valf.resize(nnz); else b->val.resize(nnz);
+    ok = fread(b->ptr.data(), sizeof(long), b->ptr.size(), fStream) ==
+      b->ptr.size();
+    if(ok && nnz) ok = fread(b->col.data(), sizeof(int), nnz, fStream) ==
+      size_t(nnz) && (fSingle ?
+      fread(b->valf.data(), sizeof(float), nnz, fStream) :
+      fread(b->val.data(), sizeof(double), nnz, fStream)) == size_t(nnz);
+  } // end if
+  if(!ok) TAException::Error("TAOutOfCoreMatrix",
+    "ReadBlock: reading block %d from %s failed.", k, fFile.c_str());
+} // end of member function ReadBlock
+
+// rows [i0, i1) of block b times v, accumulated in double whatever the
+// storage, row i in w[i-r0]
+template <typename T>
+static void RowsTimes(const TAOutOfCoreMatrix::TABlock &b, const T *val,
+    int i0, int i1, const double *v, double *w, int r0){
+  for(int i = i0; i < i1; i++){
+    double s = 0.;
+    for(long p = b.ptr[i-b.r0]; p < b.ptr[i-b.r0+1]; p++)
+      s += double(val[p]) * v[b.col[p]];
+    w[i-r0] += s;
+  } // end for over rows
+} // end of function RowsTimes
+
+// the same for k vectors interleaved, each element used for them all
+template <typename T>
+static void RowsTimesBlock(const TAOutOfCoreMatrix::TABlock &b, const T *val,
+    int i0, int i1, const double *v, int k, double *w, int r0){
+  for(int i = i0; i < i1; i++){
+    double *s = w + long(i - r0)*k;
+    for(long p = b.ptr[i-b.r0]; p < b.ptr[i-b.r0+1]; p++){
+      const double a = val[p];
+      const double *x = v + long(b.col[p])*k;
+      for(int j = 0; j < k; j++) s[j] += a * x[j];
+    } // end for over p
+  } // end for over rows
+} // end of function RowsTimesBlock
+
+/// w[i-r0] = sum_j <i|O|j>*v[j], for rows i in [r0, r1)
+void TAOutOfCoreMatrix::Multiply(const vector<double> &v, vector<double> &w,
+    int r0, int r1){
+  TAPROF_PHASE("TAOutOfCoreMatrix::Multiply");
+  Stream(v, 1, w, r0, r1);
+} // end of member function Multiply
+
+/// the blocks streamed from disk once, each element used for the k vectors
+void TAOutOfCoreMatrix::MultiplyBlock(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1){
+  TAPROF_PHASE("TAOutOfCoreMatrix::MultiplyBlock");
+  Stream(v, k, w, r0, r1);
+} // end of member function MultiplyBlock
+
+// stream the blocks overlapping [r0, r1), reading the next one while the
+// current one is multiplied, by the scalar kernel for k = 1
+void TAOutOfCoreMatrix::Stream(const vector<double> &v, int k,
+    vector<double> &w, int r0, int r1){
+  if(!fStream) TAException::Error("TAOutOfCoreMatrix",
+    "Stream: Build() not called yet.");
+  if(k < 1 || long(v.size()) != long(fNBasis)*k || r0 < fR0 || r1 > fR1 ||
+      r0 > r1)
+    TAException::Error("TAOutOfCoreMatrix", "Stream: |v|: %ld for %d \
+vectors, rows [%d, %d) while [%d, %d) stored", long(v.size()), k, r0, r1,
+      fR0, fR1);
+  w.assign(long(r1 - r0)*k, 0.);
+  if(r0 == r1) return;
+
+  // the blocks overlapping [r0, r1) //
+  const int k0 = std::upper_bound(fBlockR0.begin(), fBlockR0.end(), r0) -
+    fBlockR0.begin() - 1;
+  const int k1 = std::upper_bound(fBlockR0.begin(), fBlockR0.end(), r1 - 1) -
+    fBlockR0.begin() - 1;
+  std::future<void> next = std::async(std::launch::async,
+    &TAOutOfCoreMatrix::ReadBlock, this, k0, &fBuffer[0]);
+  for(int kb = k0; kb <= k1; kb++){
+    {
+      TAPROF_PHASE("TAOutOfCoreMatrix::Wait"); // the disk time not hidden
+      next.get();
+    }
+    const TABlock &b = fBuffer[(kb - k0) % 2];
+    if(kb < k1) next = std::async(std::launch::async,
+      &TAOutOfCoreMatrix::ReadBlock, this, kb + 1, &fBuffer[(kb + 1 - k0) % 2]);
+    const int i0 = std::max(b.r0, r0), i1 = std::min(b.r1, r1);
+    if(k == 1){
+      if(fSingle) RowsTimes(b, b.valf.data(), i0, i1, v.data(), w.data(), r0);
+      else RowsTimes(b, b.val.data(), i0, i1, v.data(), w.data(), r0);
+    } // end if
+    else{
+      if(fSingle)
+        RowsTimesBlock(b, b.valf.data(), i0, i1, v.data(), k, w.data(), r0);
+      else RowsTimesBlock(b, b.val.data(), i0, i1, v.data(), k, w.data(), r0);
+    } // end else
+  } // end for over blocks
+} // end of member function Stream
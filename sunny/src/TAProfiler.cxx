@@ -0,0 +1,132 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAProfiler.cxx
+  \class TAProfiler
+  \brief Low-overhead instrumentation of the hot paths: per-phase wall time,
+  counters of the operator-string integrals, number of non-zero matrix elements
+  per row, and a periodic progress/ETA line for long loops. The results can be
+  exported in JSON. The TAPROF_* macros are the only intended entry points, and
+  they compile to nothing unless SUNNY_PROFILE is defined (cmake -DSUNNY_PROFILE=ON).
+  This is a singleton class.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <ctime>
+#include "TAProfiler.h"
+#include "TAException.h"
+
+using std::cout;
+using std::endl;
+using std::setw;
+using std::ofstream;
+
+TAProfiler *TAProfiler::kInstance = nullptr;
+unsigned long long TAProfiler::kCounter[TAProfiler::kNCounter] = {0};
+
+static const char *kCounterName[TAProfiler::kNCounter] = {
+  "Integral1N", "Integral2N", "Integral3N", "Zero1N", "Zero2N", "Zero3N",
+  "Element", "ElementPruned", "Element1N", "Element2N", "Element3N",
+  "RowCacheHit", "RowCacheMiss", "Apply",
+  "ApplyZero"
+};
+
+TAProfiler::TAProfiler() : fProgressInterval(5.), fProgressLast(-1.),
+  fProgressStart(-1.){}
+
+TAProfiler::~TAProfiler(){}
+
+TAProfiler *TAProfiler::Instance(){
+  if(!kInstance) kInstance = new TAProfiler();
+  return kInstance;
+} // end of member function Instance
+
+double TAProfiler::Now(){
+  timespec t; clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1E-9*t.tv_nsec;
+} // end of member function Now
+
+void TAProfiler::AddPhase(const char *name, double sec){
+  std::pair<long, double> &p = fPhase[name];
+  p.first++; p.second += sec;
+} // end of member function AddPhase
+
+/// print a progress line with ETA, at most once every fProgressInterval seconds
+void TAProfiler::Progress(const char *name, long done, long total){
+  const double t = Now();
+  if(done <= 1 || fProgressStart < 0.){ fProgressStart = fProgressLast = t; }
+  if(done < total && t - fProgressLast < fProgressInterval) return;
+  fProgressLast = t;
+  const double elapsed = t - fProgressStart;
+  const double eta = done ? elapsed * (total - done) / done : 0.;
+  TAINFO("TAProfiler", "%s: %ld/%ld (%.1f%%), elapsed: %.1fs, ETA: %.1fs",
+    name, done, total, total ? 100.*done/total : 100., elapsed, eta);
+  if(done >= total) fProgressStart = -1.; // ready for the next loop
+} // end of member function Progress
+
+void TAProfiler::Reset(){
+  fPhase.clear();
+  fNNZRow.clear();
+  for(unsigned long long &c : kCounter) c = 0;
+  fProgressStart = fProgressLast = -1.;
+} // end of member function Reset
+
+void TAProfiler::Print() const{
+  cout << "TAProfiler: phases ~" << endl;
+  for(const auto &p : fPhase){
+    cout << std::left << setw(40) << p.first << std::right;
+    cout << " calls: " << setw(10) << p.second.first;
+    cout << "  seconds: " << setw(12) << p.second.second << endl;
+  } // end for over phases
+  cout << "TAProfiler: counters ~" << endl;
+  for(int i = 0; i < kNCounter; i++){
+    cout << std::left << setw(40) << kCounterName[i] << std::right;
+    cout << setw(20) << kCounter[i] << endl;
+  } // end for over counters
+} // end of member function Print
+
+/// write the records to file
+void TAProfiler::ExportJSON(const string &file) const{
+  ofstream ff(file.c_str());
+  if(!ff.is_open()){
+    TAException::Warn("TAProfiler", "ExportJSON: cannot open %s", file.c_str());
+    return;
+  } // end if
+  ff.precision(9);
+
+  ff << "{\n  \"phases\": {";
+  bool first = true;
+  for(const auto &p : fPhase){
+    ff << (first ? "\n" : ",\n") << "    \"" << p.first << "\": {\"calls\": ";
+    ff << p.second.first << ", \"seconds\": " << p.second.second << "}";
+    first = false;
+  } // end for over phases
+  ff << "\n  },\n  \"counters\": {";
+  for(int i = 0; i < kNCounter; i++){
+    ff << (i ? ",\n" : "\n") << "    \"" << kCounterName[i] << "\": " << kCounter[i];
+  } // end for over counters
+
+  // non-zero matrix elements per row //
+  long nrow = 0, nnz = 0;
+  for(const auto &p : fNNZRow){ nrow += p.second; nnz += p.first * p.second; }
+  ff << "\n  },\n  \"rows\": {\"n\": " << nrow << ", \"nnz\": " << nnz;
+  if(nrow){
+    ff << ", \"min\": " << fNNZRow.begin()->first;
+    ff << ", \"max\": " << fNNZRow.rbegin()->first;
+    ff << ", \"mean\": " << double(nnz) / nrow;
+  } // end if
+  ff << ", \"histogram\": {";
+  first = true;
+  for(const auto &p : fNNZRow){
+    ff << (first ? "" : ", ") << "\"" << p.first << "\": " << p.second;
+    first = false;
+  } // end for over the histogram
+  ff << "}}\n}\n";
+  ff.close();
+  TAINFO("TAProfiler", "ExportJSON: profile written to %s",
+    file.c_str());
+} // end of member function ExportJSON
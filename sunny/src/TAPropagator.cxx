@@ -0,0 +1,144 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAPropagator.cxx
+  \class TAPropagator
+  \brief The time evolution |psi(t)> = exp(-iHt)|psi(0)> (hbar = 1) of a
+  many-body state under a symmetric operator H, using only the products H*v.
+  Each step builds a short Krylov space of H from |psi>, in which exp(-iH*tau)
+  is that of the small tridiagonal T, known from its eigenpairs. tau is chosen
+  adaptively: the error of a step is estimated by beta_m*|[exp(-iT*tau)e_1]_m|,
+  the leak out of the Krylov space, and tau is cut, at no extra H*v, until the
+  error is below tol*tau, then grown for the next step. The states are complex
+  local segments of TAMPI::Partition, as in TALanczos, H acting on their real
+  and imaginary parts.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cmath>
+#include <algorithm>
+#include "TAPropagator.h"
+#include "TAOperator.h"
+#include "TAHamiltonian.h"
+#include "TAMathFCI.h"
+#include "TAMatrix.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+typedef TAPropagator::cplx cplx;
+
+TAPropagator::TAPropagator(TAOperator *op) : fOperator(op), fKrylovDim(30),
+    fTolerance(1E-10), fTau(0.), fNMultiply(0), fError(0.){
+  if(!fOperator) fOperator = TAHamiltonian::Instance();
+} // end of the constructor
+
+cplx TAPropagator::Dot(const vector<cplx> &a, const vector<cplx> &b){
+  if(a.size() != b.size())
+    TAException::Error("TAPropagator", "Dot: size mismatch: %d vs %d",
+      int(a.size()), int(b.size()));
+  cplx s = 0.;
+  for(size_t i = 0; i < a.size(); i++) s += std::conj(a[i]) * b[i];
+  vector<double> x{s.real(), s.imag()};
+  TAMPI::Sum(x);
+  return cplx(x[0], x[1]);
+} // end of member function Dot
+
+/// H*(a+ib) = H*a + i*H*b, H being real: a and b go interleaved through one
+/// MultiplyBlock, so that each element of H is made or loaded only once
+void TAPropagator::Multiply(const vector<cplx> &q, vector<cplx> &w){
+  const int n = fOperator->GetNBasis(), nl = q.size();
+  int r0, r1;
+  TAMPI::Partition(n, r0, r1);
+  fLocal.resize(2*nl);
+  for(int i = 0; i < nl; i++){
+    fLocal[2*i] = q[i].real(); fLocal[2*i+1] = q[i].imag();
+  } // end for over i
+  TAMPI::AllGather(fLocal, fFull, n, 2);
+  fOperator->MultiplyBlock(fFull, 2, fW, r0, r1);
+  w.resize(nl);
+  for(int i = 0; i < nl; i++) w[i] = cplx(fW[2*i], fW[2*i+1]);
+  fNMultiply += 2;
+} // end of member function Multiply
+
+double TAPropagator::Energy(const vector<cplx> &psi){
+  vector<cplx> w;
+  Multiply(psi, w);
+  return Dot(psi, w).real() / Dot(psi, psi).real();
+} // end of member function Energy
+
+int TAPropagator::Propagate(vector<cplx> &psi, double t){
+  TAPROF_PHASE("TAPropagator::Propagate");
+  const int n = fOperator->GetNBasis();
+  int r0, r1;
+  TAMPI::Partition(n, r0, r1);
+  const int nl = r1 - r0;
+  if(int(psi.size()) != nl)
+    TAException::Error("TAPropagator", "Propagate: |psi|: %d, while the local \
+rows are [%d, %d)", int(psi.size()), r0, r1);
+  const int mMax = std::min(std::max(fKrylovDim, 2), n);
+  const double sign = t < 0. ? -1. : 1.;
+  double left = fabs(t);
+  int nStep = 0;
+  vector<vector<cplx> > q;
+  vector<cplx> w;
+  vector<double> alpha, beta, d, e;
+  TAMatrix2D z;
+  while(left > 0.){
+    const double nrm = sqrt(Dot(psi, psi).real());
+    if(!nrm) return nStep;
+    // the Krylov space, with full reorthogonalization //
+    q.assign(1, psi);
+    for(cplx &x : q[0]) x /= nrm;
+    alpha.clear(); beta.clear();
+    double leak = 0.; // beta_m, 0 if the Krylov space is invariant
+    for(int j = 0; j < mMax; j++){
+      Multiply(q[j], w);
+      alpha.push_back(Dot(q[j], w).real());
+      for(int pass = 0; pass < 2; pass++) for(const vector<cplx> &u : q){
+        const cplx c = Dot(u, w);
+        for(int i = 0; i < nl; i++) w[i] -= c * u[i];
+      } // end for over passes and vectors
+      leak = sqrt(Dot(w, w).real());
+      if(leak < 1E-12 * std::max(1., fabs(alpha[0]))){ leak = 0.; break; }
+      if(j == mMax - 1) break;
+      beta.push_back(leak);
+      q.push_back(w);
+      for(cplx &x : q.back()) x /= leak;
+    } // end for over j
+    const int m = alpha.size();
+    d = alpha; e = beta; e.resize(m, 0.);
+    z.Resize(m, m); z = 1.;
+    TAMathFCI::EigenTridiagonal(d, e, &z);
+
+    // c = exp(-iT*tau)*e_1, tau cut until the leak is tolerable //
+    double tau = fTau > 0. ? std::min(fTau, left) : left, err = 0.;
+    TAMatrixC c(m);
+    while(true){
+      for(int k = 0; k < m; k++){
+        c[k][0] = 0.;
+        for(int l = 0; l < m; l++)
+          c[k][0] += z[k][l] * z[0][l] * std::exp(cplx(0., -sign*d[l]*tau));
+      } // end for over k
+      err = leak * std::abs(c[m-1][0]) * nrm;
+      if(err <= fTolerance * tau || tau < 1E-12 * fabs(t)) break;
+      tau *= std::max(0.1, std::min(0.9, 0.9 * pow(fTolerance*tau/err, 1./m)));
+    } // end while
+    for(int i = 0; i < nl; i++){
+      cplx s = 0.;
+      for(int k = 0; k < m; k++) s += c[k][0] * q[k][i];
+      psi[i] = nrm * s;
+    } // end for over i
+    left -= tau;
+    if(left < 1E-14 * fabs(t)) left = 0.;
+    fError += err;
+    nStep++;
+    // the next step, grown by the margin of this one //
+    fTau = tau * (err > 0. ?
+      std::min(2., 0.9 * pow(fTolerance*tau/err, 1./m)) : 2.);
+    TADEBUG("TAPropagator", "Propagate: step %d, tau: %g, Krylov dim: %d, \
+error: %g", nStep, tau, m, err);
+  } // end while
+  return nStep;
+} // end of member function Propagate
@@ -0,0 +1,137 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TASelectedCI.cxx
+  \class TASelectedCI
+  \brief Iterative selected configuration interaction on top of the M-scheme
+  many-body basis. Starting from a reference space of the lowest-lying SDs, the
+  SDs whose first-order perturbative amplitude |<a|H|psi>/(E0-<a|H|a>)| exceeds
+  a threshold are added to the variational space, which is then diagonalized
+  again. The SDs left out are accounted for by the Epstein-Nesbet second-order
+  perturbative (PT2) correction. This is a singleton class.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cmath>
+#include <algorithm>
+#include "TASelectedCI.h"
+#include "TAHamiltonian.h"
+#include "TAMathFCI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+TASelectedCI *TASelectedCI::kInstance = nullptr;
+
+TASelectedCI::TASelectedCI() : fHamiltonian(nullptr), fNReference(1),
+    fThreshold(1E-3), fMaxIteration(20), fEnergy(0.), fPT2(0.){}
+
+TASelectedCI::~TASelectedCI(){}
+
+TASelectedCI *TASelectedCI::Instance(){
+  if(!kInstance) kInstance = new TASelectedCI();
+  return kInstance;
+} // end of member function Instance
+
+// initiate the selected-CI iterations
+void TASelectedCI::Go(){
+  Initialize();
+
+  for(int iter = 0; iter < fMaxIteration; iter++){
+    Diagonalize();
+    const int dim = fSelected.size();
+    // the last round only sums up PT2 over the final selected space //
+    const bool add = iter < fMaxIteration - 1;
+    const int nNew = Select(add);
+    TAINFO("TASelectedCI",
+      "Go: round %d, dim: %d, E_var: %f, E_PT2: %f, new SDs: %d", iter,
+      dim, fEnergy, fPT2, nNew);
+    if(!nNew) break;
+  } // end for over iterations
+
+  const int n = fHDiag.size();
+  TAINFO("TASelectedCI",
+    "Go: Converged. dim: %d/%d, E_var: %f, E_PT2: %f, E_var+E_PT2: %f",
+    int(fSelected.size()), n, fEnergy, fPT2, fEnergy + fPT2);
+} // end of member function Go
+
+// select the reference space from the diagonal of H
+void TASelectedCI::Initialize(){
+  if(!fHamiltonian) fHamiltonian = TAHamiltonian::Instance();
+  const int n = fHamiltonian->GetNBasis();
+  if(!n) TAException::Error("TASelectedCI", "Initialize: empty basis.");
+  if(fNReference < 1 || fNReference > n){
+    TAException::Warn("TASelectedCI",
+      "Initialize: fNReference: %d not in [1, %d], reset to 1", fNReference, n);
+    fNReference = 1;
+  } // end if
+
+  fHDiag.resize(n);
+  for(int a = 0; a < n; a++) fHDiag[a] = fHamiltonian->Element(a, a);
+  // the reference space: the fNReference SDs of the lowest <a|H|a> //
+  vector<int> order(n);
+  for(int a = 0; a < n; a++) order[a] = a;
+  std::stable_sort(order.begin(), order.end(),
+    [this](int a, int b){ return fHDiag[a] < fHDiag[b]; });
+  fSelected.assign(order.begin(), order.begin() + fNReference);
+  fIsSelected.assign(n, false);
+  for(int a : fSelected) fIsSelected[a] = true;
+  fEnergy = fPT2 = 0.;
+} // end of member function Initialize
+
+// diagonalize H in the selected space, assign fEnergy and fVector
+void TASelectedCI::Diagonalize(){
+  TAPROF_PHASE("TASelectedCI::Diagonalize");
+  const int n = fSelected.size();
+  TAMatrix2D h(n, n), P(n, n), v(n);
+  for(int i = 0; i < n; i++){
+    h[i][i] = fHDiag[fSelected[i]];
+    shared_ptr<const TAHamiltonian::TARow> row = fHamiltonian->Row(fSelected[i]);
+    for(int j = 0; j < i; j++) h[i][j] = h[j][i] = (*row)(fSelected[j]);
+  } // end for over i
+
+  TAMathFCI::EigenHouseholder(h, P, v); // eigenvalues in ascending order
+  fEnergy = v[0][0];
+  fVector.resize(n);
+  for(int i = 0; i < n; i++) fVector[i] = P[i][0];
+} // end of member function Diagonalize
+
+// calculate <a|H|psi> for all the unselected SDs, add the important ones
+// to the selected space, and sum up the PT2 correction for the rest
+int TASelectedCI::Select(bool add){
+  TAPROF_PHASE("TASelectedCI::Select");
+  const int n = fHDiag.size(), ns = fSelected.size();
+  // <a|H|psi> for all a, scattered from the rows of the selected SDs, which
+  // stay in the row cache of H from one round to the next //
+  vector<double> hpsi(n, 0.);
+  for(int i = 0; i < ns; i++){
+    TAPROF_PROGRESS("TASelectedCI::Select", i + 1, ns);
+    if(!fVector[i]) continue;
+    shared_ptr<const TAHamiltonian::TARow> row = fHamiltonian->Row(fSelected[i]);
+    for(int k = row->col.size(); k--;) hpsi[row->col[k]] += row->val[k]*fVector[i];
+  } // end for over i
+
+  vector<int> important;
+  fPT2 = 0.;
+  double pt2Kept = 0.; // PT2 of the SDs to be selected
+  for(int a = 0; a < n; a++){
+    if(fIsSelected[a]) continue;
+    const double va = hpsi[a]; // <a|H|psi>
+    if(!va) continue; // not connected to the selected space
+    double de = fEnergy - fHDiag[a];
+    if(fabs(de) < 1E-10) de = de < 0. ? -1E-10 : 1E-10; // near degeneracy
+    const double pt2 = va*va / de;
+    fPT2 += pt2;
+    if(add && fabs(va / de) > fThreshold){
+      important.push_back(a);
+      pt2Kept += pt2;
+    } // end if
+  } // end for over a
+
+  // the selected SDs are no longer part of the perturbative remainder //
+  if(important.size()){
+    fPT2 -= pt2Kept;
+    for(int a : important){ fSelected.push_back(a); fIsSelected[a] = true; }
+  } // end if
+  return important.size();
+} // end of member function Select
@@ -0,0 +1,159 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TASellMatrix.cxx
+  \class TASellMatrix<T>
+  \brief The SIMD kernels of TASellMatrix for float and double values: the C
+  rows of a chunk are C/W vectors of W lanes, W the doubles per register, each
+  its own chain of FMAs, with x gathered by the 32-bit column indices. The
+  float values are widened to double as they are loaded. AVX-512 or AVX2+FMA
+  when the compiler targets them (cmake -DSUNNY_NATIVE=ON), plain loops of
+  fixed length otherwise, left to the auto-vectorizer, and for k vectors a
+  row by row loop skipping the padding, as the CSR one.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <algorithm>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "TASellMatrix.h"
+
+#if defined(__AVX512F__)
+#define TASELL_AVX512
+static const int kWidth = 8;
+#elif defined(__AVX2__) && defined(__FMA__)
+#define TASELL_AVX2
+static const int kWidth = 4;
+#else
+static const int kWidth = 4;
+#endif
+
+// the masked gathers and conversions, whose pass-through operand is defined,
+// are the same instructions, but do not upset -Wuninitialized of gcc 12
+#if defined(TASELL_AVX512)
+static inline __m512d Load(const double *a){ return _mm512_loadu_pd(a); }
+static inline __m512d Load(const float *a){
+  return _mm512_mask_cvtps_pd(_mm512_setzero_pd(), 0xff, _mm256_loadu_ps(a));
+}
+static inline __m512d Gather(const int *col, const double *x){
+  const __m256i j = _mm256_loadu_si256((const __m256i *)col);
+  return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, j, x, 8);
+}
+#elif defined(TASELL_AVX2)
+static inline __m256d Load(const double *a){ return _mm256_loadu_pd(a); }
+static inline __m256d Load(const float *a){
+  return _mm256_cvtps_pd(_mm_loadu_ps(a));
+}
+static inline __m256d Gather(const int *col, const double *x){
+  const __m128i j = _mm_loadu_si128((const __m128i *)col);
+  return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, j,
+    _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+}
+#endif
+
+/// y[r] = sum_l a[l*C+r]*x[col[l*C+r]], C = U*kWidth, r in [0, C)
+template<int U, class T>
+static void SellChunk(const T *a, const int *col, long width, const double *x,
+    double *y){
+  const int C = U*kWidth;
+#if defined(TASELL_AVX512)
+  __m512d s[U];
+  for(int u = 0; u < U; u++) s[u] = _mm512_setzero_pd();
+  for(long l = 0; l < width; l++, a += C, col += C)
+    for(int u = 0; u < U; u++)
+      s[u] = _mm512_fmadd_pd(Load(a + 8*u), Gather(col + 8*u, x), s[u]);
+  for(int u = 0; u < U; u++) _mm512_storeu_pd(y + 8*u, s[u]);
+#elif defined(TASELL_AVX2)
+  __m256d s[U];
+  for(int u = 0; u < U; u++) s[u] = _mm256_setzero_pd();
+  for(long l = 0; l < width; l++, a += C, col += C)
+    for(int u = 0; u < U; u++)
+      s[u] = _mm256_fmadd_pd(Load(a + 4*u), Gather(col + 4*u, x), s[u]);
+  for(int u = 0; u < U; u++) _mm256_storeu_pd(y + 4*u, s[u]);
+#else
+  double s[C] = {};
+  for(long l = 0; l < width; l++, a += C, col += C)
+    for(int r = 0; r < C; r++) s[r] += double(a[r]) * x[col[r]];
+  for(int r = 0; r < C; r++) y[r] = s[r];
+#endif
+} // end of function SellChunk
+
+/// y[r*k+j] = sum_l a[l*C+r]*x[col[l*C+r]*k+j], len[r] the length of row r:
+/// the k vectors of a column are contiguous, so the SIMD lanes go over j.
+/// Without a SIMD target the rows are gone through one by one up to their
+/// lengths, as the CSR kernel of TASparseMatrix, with no pass over the padding
+template<class T>
+static void SellChunkBlock(const T *a, const int *col, const int *len,
+    long width, int C, const double *x, int k, double *y){
+  std::fill(y, y + long(C)*k, 0.);
+#if defined(TASELL_AVX512) || defined(TASELL_AVX2)
+  for(long l = 0; l < width; l++, a += C, col += C) for(int r = 0; r < C; r++){
+    if(l >= len[r]) continue; // the padding
+    const double ar = a[r];
+    const double *xr = x + long(col[r])*k;
+    double *yr = y + long(r)*k;
+    int j = 0;
+#if defined(TASELL_AVX512)
+    const __m512d va = _mm512_set1_pd(ar);
+    for(; j + 8 <= k; j += 8) _mm512_storeu_pd(yr + j,
+      _mm512_fmadd_pd(va, _mm512_loadu_pd(xr + j), _mm512_loadu_pd(yr + j)));
+#else
+    const __m256d va = _mm256_set1_pd(ar);
+    for(; j + 4 <= k; j += 4) _mm256_storeu_pd(yr + j,
+      _mm256_fmadd_pd(va, _mm256_loadu_pd(xr + j), _mm256_loadu_pd(yr + j)));
+#endif
+    for(; j < k; j++) yr[j] += ar * xr[j];
+  } // end for over l and r
+#else
+  (void)width;
+  for(int r = 0; r < C; r++){
+    double *yr = y + long(r)*k;
+    for(long l = 0, p = r; l < len[r]; l++, p += C){
+      const double ar = a[p], *xr = x + long(col[p])*k;
+      for(int j = 0; j < k; j++) yr[j] += ar * xr[j];
+    } // end for over l
+  } // end for over r
+#endif
+} // end of function SellChunkBlock
+
+/// the fixed C of the kernels out of fChunk, one of 1, 2 and 4 times kWidth
+template<class T>
+static void SellDispatch(const T *a, const int *col, long width, int C,
+    const double *x, double *y){
+  if(C == kWidth) SellChunk<1>(a, col, width, x, y);
+  else if(C == 2*kWidth) SellChunk<2>(a, col, width, x, y);
+  else SellChunk<4>(a, col, width, x, y);
+} // end of function SellDispatch
+
+template<> int TASellMatrix<double>::SIMDWidth(){ return kWidth; }
+template<> int TASellMatrix<float>::SIMDWidth(){ return kWidth; }
+
+template<> void TASellMatrix<double>::Chunk(const double *x, long c,
+    double *y) const{
+  const long p0 = fChunkPtr[c];
+  SellDispatch(fVal.data() + p0, fCol.data() + p0,
+    (fChunkPtr[c+1] - p0) / fChunk, fChunk, x, y);
+} // end of member function Chunk
+
+template<> void TASellMatrix<float>::Chunk(const double *x, long c,
+    double *y) const{
+  const long p0 = fChunkPtr[c];
+  SellDispatch(fVal.data() + p0, fCol.data() + p0,
+    (fChunkPtr[c+1] - p0) / fChunk, fChunk, x, y);
+} // end of member function Chunk
+
+template<> void TASellMatrix<double>::ChunkBlock(const double *x, int k,
+    long c, double *y) const{
+  const long p0 = fChunkPtr[c];
+  SellChunkBlock(fVal.data() + p0, fCol.data() + p0, fLen.data() + c*fChunk,
+    (fChunkPtr[c+1] - p0) / fChunk, fChunk, x, k, y);
+} // end of member function ChunkBlock
+
+template<> void TASellMatrix<float>::ChunkBlock(const double *x, int k,
+    long c, double *y) const{
+  const long p0 = fChunkPtr[c];
+  SellChunkBlock(fVal.data() + p0, fCol.data() + p0, fLen.data() + c*fChunk,
+    (fChunkPtr[c+1] - p0) / fChunk, fChunk, x, k, y);
+} // end of member function ChunkBlock
@@ -0,0 +1,154 @@
+/**
+  SUNNY project, Anyang Normal University, IMP-CAS
+  \file TAShiftInvert.cxx
+  \class TAShiftInvert
+  \brief The eigenstates of a symmetric operator H nearest to a target energy
+  sigma, deep in the spectrum, without those below. The iterations are
+  x <- (H-s)^(-1)*x, the linear systems solved by MINRES, which takes the
+  symmetric indefinite H-s with only the products H*v. The shift s stays at
+  sigma until x has settled on the state nearest to it, then follows the
+  Rayleigh quotient <x|H|x>, for the cubic convergence of the Rayleigh quotient
+  iteration. More states are found one after another, each kept orthogonal to
+  those found before. The vectors are distributed over the MPI ranks as in
+  TALanczos.
+  \date Created: 2026/10/19
+  \date Last modified: 2026/10/19
+  \copyright SUNNY project, Anyang Normal University, IMP-CAS
+*/
+
+#include <cmath>
+#include <algorithm>
+#include "TAShiftInvert.h"
+#include "TAOperator.h"
+#include "TAHamiltonian.h"
+#include "TABLAS.h"
+#include "TAMPI.h"
+#include "TAException.h"
+#include "TAProfiler.h"
+
+TAShiftInvert::TAShiftInvert(TAOperator *op) : fOperator(op), fTarget(0.),
+    fNEigen(1), fTolerance(1E-8), fRQITolerance(1E-2), fMaxIteration(50),
+    fMaxMINRES(500), fMINRESTolerance(1E-10), fNMultiply(0), fR0(0), fR1(0){
+  if(!fOperator) fOperator = TAHamiltonian::Instance();
+} // end of the constructor
+
+double TAShiftInvert::GetEnergy(int i) const{
+  if(i < 0 || i >= int(fEnergy.size()))
+    TAException::Error("TAShiftInvert", "GetEnergy: %d out of range [0, %d)",
+      i, int(fEnergy.size()));
+  return fEnergy[i];
+} // end of member function GetEnergy
+
+const vector<double> &TAShiftInvert::GetVector(int i) const{
+  if(i < 0 || i >= int(fVector.size()))
+    TAException::Error("TAShiftInvert", "GetVector: %d out of range [0, %d)",
+      i, int(fVector.size()));
+  return fVector[i];
+} // end of member function GetVector
+
+// H*q for the local rows, q being the local segment
+void TAShiftInvert::Multiply(const vector<double> &q, vector<double> &w){
+  const int n = fOperator->GetNBasis();
+  TAMPI::AllGather(q, fFull, n);
+  fOperator->Multiply(fFull, w, fR0, fR1);
+  fNMultiply++;
+} // end of member function Multiply
+
+void TAShiftInvert::Orthonormalize(vector<double> &x) const{
+  const int nl = x.size();
+  for(int pass = 0; pass < 2; pass++) for(const vector<double> &u : fVector)
+    TABLAS::Axpy(-TAMPI::Dot(u, x), u.data(), x.data(), nl);
+  const double nrm = sqrt(TAMPI::Dot(x, x));
+  if(nrm < 1E-150)
+    TAException::Error("TAShiftInvert", "Orthonormalize: null vector");
+  TABLAS::Scal(1. / nrm, x.data(), nl);
+} // end of member function Orthonormalize
+
+/// MINRES of Paige and Saunders: the Lanczos process on H-s from b, with the
+/// tridiagonal matrix QR-factorized by Givens rotations on the fly, so that x
+/// minimizes |b-(H-s)*x| over the Krylov space with three vectors updated
+int TAShiftInvert::MINRES(double s, const vector<double> &b,
+    vector<double> &x){
+  TAPROF_PHASE("TAShiftInvert::MINRES");
+  const int nl = b.size();
+  x.assign(nl, 0.);
+  const double beta1 = sqrt(TAMPI::Dot(b, b));
+  if(!beta1) return 0;
+  vector<double> v0(nl, 0.), v1(b), p;
+  vector<double> w0(nl, 0.), w1(nl, 0.), w2(nl); // w_k-2, w_k-1 and w_k
+  TABLAS::Scal(1. / beta1, v1.data(), nl);
+  double beta = 0., eta = beta1;
+  double c0 = 1., c1 = 1., s0 = 0., s1 = 0.; // the last two Givens rotations
+  int k = 0;
+  while(k < fMaxMINRES){
+    k++;
+    Multiply(v1, p);
+    TABLAS::Axpy(-s, v1.data(), p.data(), nl);
+    const double alpha = TAMPI::Dot(v1, p);
+    TABLAS::Axpy(-alpha, v1.data(), p.data(), nl);
+    if(beta) TABLAS::Axpy(-beta, v0.data(), p.data(), nl);
+    const double betaNew = sqrt(TAMPI::Dot(p, p));
+    // apply the former rotations to the new column of T, then make its own //
+    const double delta = c1*alpha - c0*s1*beta;
+    const double rho1 = sqrt(delta*delta + betaNew*betaNew);
+    const double rho2 = s1*alpha + c0*c1*beta;
+    const double rho3 = s0*beta;
+    if(!rho1) break; // H-s is singular on the Krylov space
+    const double c2 = delta / rho1, s2 = betaNew / rho1;
+    for(int i = 0; i < nl; i++)
+      w2[i] = (v1[i] - rho3*w0[i] - rho2*w1[i]) / rho1;
+    TABLAS::Axpy(c2*eta, w2.data(), x.data(), nl);
+    eta = -s2*eta; // |eta| = |b-(H-s)*x|
+    TADEBUG("TAShiftInvert", "MINRES: iteration %d, residual: %g", k,
+      fabs(eta)/beta1);
+    if(fabs(eta) < fMINRESTolerance*beta1 || betaNew < 1E-14*beta1) break;
+    v0.swap(v1); v1.swap(p);
+    TABLAS::Scal(1. / betaNew, v1.data(), nl);
+    beta = betaNew;
+    c0 = c1; c1 = c2; s0 = s1; s1 = s2;
+    w0.swap(w1); w1.swap(w2);
+  } // end while
+  return k;
+} // end of member function MINRES
+
+void TAShiftInvert::Go(){
+  TAPROF_PHASE("TAShiftInvert::Go");
+  const int n = fOperator->GetNBasis();
+  if(!n) TAException::Error("TAShiftInvert", "Go: empty basis.");
+  TAMPI::Partition(n, fR0, fR1);
+  const int nl = fR1 - fR0;
+  const int nev = std::min(std::max(fNEigen, 1), n);
+  fEnergy.clear(); fVector.clear();
+  fNMultiply = 0;
+
+  vector<double> x(nl), y, hx;
+  for(int j = 0; j < nev; j++){
+    // the starting vector, a function of the global index only //
+    TAMPI::StartVector(fR0, fR1, j, x.data());
+    Orthonormalize(x);
+    double s = fTarget, e = fTarget, res = 0.;
+    bool rqi = false, converged = false;
+    int it = 0, nSolve = 0;
+    while(it < fMaxIteration){
+      it++;
+      nSolve += MINRES(s, x, y);
+      x.swap(y);
+      Orthonormalize(x);
+      Multiply(x, hx);
+      e = TAMPI::Dot(x, hx);
+      TABLAS::Axpy(-e, x.data(), hx.data(), nl);
+      res = sqrt(TAMPI::Dot(hx, hx));
+      TADEBUG("TAShiftInvert", "Go: state %d, iteration %d, shift: %f, E: %f, \
+residual: %g", j, it, s, e, res);
+      if(res < fTolerance*std::max(1., fabs(e))){ converged = true; break; }
+      if(res < fRQITolerance*std::max(1., fabs(e))) rqi = true;
+      if(rqi) s = e;
+    } // end while
+    if(!converged) TAException::Warn("TAShiftInvert", "Go: state %d not \
+converged within %d iterations, residual: %g", j, it, res);
+    fEnergy.push_back(e);
+    fVector.push_back(x);
+    TAINFO("TAShiftInvert", "Go: E[%d] = %f, target: %f, iterations: %d, \
+MINRES steps: %d, ranks: %d", j, e, fTarget, it, nSolve, TAMPI::Size());
+  } // end for over states
+} // end of member function Go
@@ -81,7 +81,7 @@ void TASingleParticleStateManager::LoadSPListFile(const string &file){
 	} // end while
 	ff.close();
 
-	TAException::Info("TASingleParticleStateManager",
-		"LoadSPListFile: \nDisplay the SP States read in ~");
-	for(TASingleParticleState *sp : fSPStateVec) sp->Print(); // DEBUG
+	TAINFO("TASingleParticleStateManager",
+		"LoadSPListFile: %d SP States read in", int(fSPStateVec.size()));
+	TADEBUG_DO(for(TASingleParticleState *sp : fSPStateVec) sp->Print());
 } // end of member function LoadSPListFile()